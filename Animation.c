@@ -1,4 +1,8 @@
 #include "Animation.h"
+#include "AnimationInternal.h"
+#include "AnimationProfiler.h"
+#include "SpriteSheetLoader.h"
+#include "TextureCache.h"
 
 #include <SFML/Graphics.h>
 #include <math.h>
@@ -6,208 +10,94 @@
 #include <stdlib.h>
 #include <string.h>
 
-struct Animation
-{
-	float clock;
-	unsigned char state;
-	sfBool isPlaying;
-	float duration;
-	sfTexture* spriteSheet;
-	sfSprite* sprite;
-	sfVector2u frameSize;
-	unsigned char framesNb;
-	unsigned char currentFrame;
-	char* spriteSheetStructure;
-	sfVector2u animationOffset;
-	sfVector2u blockLength;
-	sfVector2f scale;
-};
+/// Global clock of the lazy animations, in seconds
+static double globalClock = 0;
+
+void AnimationAdvanceGlobalClock(float _dt)
+{
+	globalClock += _dt;
+}
+
+void AnimationSetGlobalClock(double _time)
+{
+	globalClock = _time;
+}
+
+double AnimationGetGlobalClock(void)
+{
+	return globalClock;
+}
 
 void AnimationSetFlipState(Animation* _anim)
 {
-	// Flip sprite according to the state of the animation
-	if (_anim->state & FLIP_X && _anim->state & FLIP_Y)
-	{
-		sfSprite_setScale(_anim->sprite,
-			(sfVector2f) {
-			-_anim->scale.x, -_anim->scale.y
-		});
-	}
-	else if (_anim->state & FLIP_X)
-	{
-		sfSprite_setScale(_anim->sprite,
-			(sfVector2f) {
-			-_anim->scale.x, _anim->scale.y
-		});
-	}
-	else if (_anim->state & FLIP_Y)
-	{
-		sfSprite_setScale(_anim->sprite,
-			(sfVector2f) {
-			_anim->scale.x, -_anim->scale.y
-		});
-	}
-	else
-	{
-		sfSprite_setScale(_anim->sprite,
-			(sfVector2f) {
-			_anim->scale.x, _anim->scale.y
-		});
-	}
+	AnimationSystemSetFlipState(_anim->system, _anim->index);
 }
 
 Animation* AnimationCreate(sfVector2u _frameSize, unsigned char _framesNb)
 {
-	Animation* anim = (Animation*)malloc(sizeof(Animation));
-	if (anim == NULL)
+	AnimationSystem* system = AnimationSystemGetDefault();
+	if (system == NULL)
 	{
-		printf("Error during memory allocation !");
 		return NULL;
 	}
-	anim->isPlaying = sfFalse;
-	anim->state = DEFAULT;
-	anim->frameSize = _frameSize;
-	anim->framesNb = _framesNb;
-	anim->clock = 0;
-	anim->duration = 1;
-	anim->scale = (sfVector2f){ 1, 1 };
-	// creating the sprite
-	anim->sprite = sfSprite_create();
-	if (anim->sprite == NULL)
-	{
-		printf("Error during cration of the sprite !");
-		return NULL;
-	}
-	sfSprite_setOrigin(anim->sprite,
-		(sfVector2f) {
-		(float)anim->frameSize.x / 2,
-			(float)anim->frameSize.y / 2
-	});
-	anim->currentFrame = 0;
-	anim->spriteSheetStructure = (char*)malloc(15);
-
-	return anim;
+	return AnimationSystemCreateAnimation(system, _frameSize, _framesNb);
 }
 
 void AnimationUpdate(Animation* _anim, float _dt)
 {
-	AnimationSetFlipState(_anim);
-
-	if (_anim->isPlaying)
+	// Lazy animations are computed from the global clock when read
+	if (_anim->system->state[_anim->index] & LAZY)
 	{
-		if (_anim->state & REVERSED)
-		{
-			// Play animation in reverse 
-			_anim->clock -= _dt;
-
-			double animationProgression =
-				(double)_anim->clock / (double)_anim->duration;
-
-			int nextFrame =
-				(int)(floor(animationProgression * (double)_anim->framesNb));
-
-			// If animation has played his last frame
-			if (_anim->clock < 0 && nextFrame < 0)
-			{
-				if (_anim->state & LOOPED)
-				{
-					_anim->clock = _anim->duration;
-					_anim->currentFrame = _anim->framesNb - 1;
-				}
-				else
-				{
-					_anim->isPlaying = sfFalse;
-					_anim->currentFrame = 0;
-				}
-			}
-			else
-			{
-				// Update the animation frame
-				_anim->currentFrame = (unsigned char)nextFrame;
-			}
-		}
-		else
-		{
-			// Play animation
-			_anim->clock += _dt;
-			double animationProgression =
-				(double)_anim->clock / (double)_anim->duration;
-
-			int nextFrame =
-				(int)(floor(animationProgression * (double)_anim->framesNb));
-
-			// If animation has played his last frame
-			if (_anim->clock > _anim->duration
-				&& nextFrame > _anim->framesNb - 1)
-			{
-				if (_anim->state & LOOPED)
-				{
-					_anim->clock = 0;
-					_anim->currentFrame = 0;
-				}
-				else
-				{
-					_anim->isPlaying = sfFalse;
-					_anim->currentFrame = _anim->framesNb - 1;
-				}
-			}
-			else
-			{
-				// Update the animation frame
-				_anim->currentFrame = nextFrame;
-			}
-		}
-		AnimationFrameUpdate(_anim);
+		return;
 	}
-}
-
-static void AnimationFrameUpdate(Animation* _anim)
-{
-	// The position of the top left corner of the next frame in the texture
-	sfVector2i framePos = {
-			_anim->frameSize.x * (int)_anim->currentFrame,
-			(_anim->frameSize.y * (int)_anim->currentFrame) };
-
-	// Select the next frame according to the sprite sheet structure
-	if (strcmp(_anim->spriteSheetStructure, "horizontal") == 0)
+	// Below the full rate, the time of the skipped updates is kept
+	AnimationSystem* system = _anim->system;
+	if (system->wheel == NULL && system->tickRate == 0 && system->isPlaying[_anim->index]
+		&& !AnimationSystemStepLod(system, _anim->index, &_dt))
 	{
-		sfSprite_setTextureRect(
-			_anim->sprite,
-			(sfIntRect) {
-			framePos.x,
-				0,
-				_anim->frameSize.x,
-				_anim->frameSize.y
-		});
+		return;
 	}
-	else if (strcmp(_anim->spriteSheetStructure, "vertical") == 0)
+	if (system->tickRate > 0)
 	{
-		sfSprite_setTextureRect(
-			_anim->sprite,
-			(sfIntRect) {
-			0,
-				framePos.y,
-				_anim->frameSize.x,
-				_anim->frameSize.y
-		});
+		// Whole ticks only, the fraction is carried to the next update of
+		// the animation so that the clock does not drift
+		unsigned int i = _anim->index;
+		double ticks = system->tickFraction[i] + (double)_dt * system->tickRate;
+		double whole = ticks > 0 ? floor(ticks) : 0;
+		system->tickFraction[i] = ticks - whole;
+		AnimationUpdateTicks(_anim, (unsigned int)whole);
+		return;
 	}
-	else if (strcmp(_anim->spriteSheetStructure, "block") == 0)
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_UPDATE);
+	AnimationSystemSync(system, _anim->index);
+	AnimationSystemAdvance(system, _anim->index, _anim->index + 1, _dt);
+	AnimationSystemComputeRects(system, _anim->index, _anim->index + 1);
+	AnimationSystemApply(system, _anim->index, _anim->index + 1);
+	AnimationSystemSchedule(system, _anim->index);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_UPDATES, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_UPDATE);
+}
+
+void AnimationUpdateTicks(Animation* _anim, unsigned int _ticks)
+{
+	if (_anim->system->tickRate == 0)
 	{
-		// Block length in pixel
-		sfVector2i blockPixelSize = {
-			_anim->blockLength.x * (int)_anim->frameSize.x,
-			_anim->blockLength.y * (int)_anim->frameSize.y
-		};
-
-		sfIntRect frameRect = {
-			framePos.x % blockPixelSize.x,
-			(int)ceil(_anim->currentFrame / _anim->blockLength.x) * _anim->frameSize.y,
-			_anim->frameSize.x,
-			_anim->frameSize.y
-		};
-
-		sfSprite_setTextureRect(_anim->sprite, frameRect);
+		printf("Error : the animation system is not in tick mode !");
+		return;
 	}
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_UPDATE);
+	AnimationSystemAdvanceTicks(_anim->system, _anim->index, _anim->index + 1, _ticks);
+	AnimationSystemComputeRects(_anim->system, _anim->index, _anim->index + 1);
+	AnimationSystemApply(_anim->system, _anim->index, _anim->index + 1);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_UPDATES, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_UPDATE);
+}
+
+void AnimationFrameUpdate(Animation* _anim)
+{
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_FRAME_UPDATE);
+	AnimationSystemFrameUpdate(_anim->system, _anim->index);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_FRAME_UPDATE);
 }
 
 void AnimationDraw(
@@ -215,8 +105,19 @@ void AnimationDraw(
 	const Animation* _anim,
 	const sfRenderStates* _states)
 {
+	// Nothing to show until the sprite sheet is loaded
+	if (_anim->system->spriteSheet[_anim->index] == NULL)
+	{
+		return;
+	}
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_DRAW);
+	AnimationSystemShowFrame(_anim->system, _anim->index);
 	sfRenderWindow_drawSprite(
-		(sfRenderWindow*)_window, _anim->sprite, _states);
+		(sfRenderWindow*)_window,
+		_anim->system->sprite[_anim->index],
+		_states);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_DRAW_CALLS, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_DRAW);
 }
 
 void AnimationDrawRenderTex(
@@ -224,345 +125,541 @@ void AnimationDrawRenderTex(
 	const Animation* _anim,
 	const sfRenderStates* _states)
 {
+	if (_anim->system->spriteSheet[_anim->index] == NULL)
+	{
+		return;
+	}
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_DRAW);
+	AnimationSystemShowFrame(_anim->system, _anim->index);
 	sfRenderTexture_drawSprite(
-		(sfRenderTexture*)_renderTex, _anim->sprite, _states);
+		(sfRenderTexture*)_renderTex,
+		_anim->system->sprite[_anim->index],
+		_states);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_DRAW_CALLS, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_DRAW);
+}
+
+// Remove an animation from its system and free the handle
+static void AnimationRelease(Animation* _anim)
+{
+	AnimationSystem* system = _anim->system;
+	AnimationSystemRemove(system, _anim->index);
+	AnimationHandleFree(_anim);
+	if (system->count == 0)
+	{
+		AnimationSystemReleaseDefault(system);
+	}
 }
 
 void AnimationDestroy(Animation* _anim)
 {
-	sfTexture_destroy((sfTexture*)_anim->spriteSheet);
-	_anim->spriteSheet = NULL;
-	sfSprite_destroy(_anim->sprite);
-	_anim->sprite = NULL;
-	free(_anim->spriteSheetStructure);
-	_anim->spriteSheetStructure = NULL;
-	free(_anim);
-	_anim = NULL;
+	AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	AnimationSystemSetSpriteSheet(system, i, NULL);
+	AnimationSystemGiveSprite(system, system->sprite[i]);
+	system->sprite[i] = NULL;
+	FrameTableRelease(system->frameTable[i]);
+	system->frameTable[i] = NULL;
+	AnimationRelease(_anim);
 }
 
 void AnimationSoftDestroy(Animation* _anim)
 {
-	sfSprite_destroy(_anim->sprite);
-	_anim->sprite = NULL;
-	free(_anim);
-	_anim = NULL;
+	AnimationDestroy(_anim);
 }
 
 void AnimationPlay(Animation* _anim, unsigned char _state)
 {
-	_anim->isPlaying = sfTrue;
-	_anim->state = _state;
-	if (_anim->state & REVERSED)
+	AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	AnimationSystemSync(system, i);
+	AnimationSystemSetState(system, i, _state);
+	system->isPlaying[i] = !(_state & LAZY);
+	if (system->state[i] & REVERSED)
 	{
-		_anim->clock = _anim->duration;
+		AnimationSystemSetClock(system, i, system->duration[i]);
 	}
+	AnimationSystemSetFlipState(system, i);
+	AnimationSystemSchedule(system, i);
 }
 
 void AnimationPause(Animation* _anim)
 {
-	_anim->isPlaying = sfFalse;
+	AnimationSystemSync(_anim->system, _anim->index);
+	// A lazy animation is frozen where the global clock is
+	AnimationSystemSetState(_anim->system, _anim->index,
+		_anim->system->state[_anim->index] & ~LAZY);
+	_anim->system->isPlaying[_anim->index] = sfFalse;
+	AnimationSystemSchedule(_anim->system, _anim->index);
 }
 
 void AnimationRewind(Animation* _anim)
 {
-	_anim->clock = 0;
-	_anim->currentFrame = 0;
-	if (_anim->state & REVERSED)
+	AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	AnimationSystemSync(system, i);
+	AnimationSystemSetClock(system, i, 0);
+	system->currentFrame[i] = 0;
+	if (system->state[i] & REVERSED)
 	{
-		_anim->clock = _anim->duration;
-		_anim->currentFrame = _anim->framesNb - 1;
+		AnimationSystemSetClock(system, i, system->duration[i]);
+		system->currentFrame[i] = system->framesNb[i] - 1;
 	}
 	AnimationFrameUpdate(_anim);
+	AnimationSystemSchedule(system, i);
 }
 
 void AnimationStop(Animation* _anim)
 {
-	_anim->isPlaying = sfFalse;
-	_anim->clock = 0;
-	_anim->currentFrame = 0;
-	if (_anim->state & REVERSED)
-	{
-		_anim->clock = _anim->duration;
-		_anim->currentFrame = _anim->framesNb - 1;
-	}
-	AnimationFrameUpdate(_anim);
+	AnimationPause(_anim);
+	AnimationRewind(_anim);
 }
 
-Animation* AnimationSmartCopy(const Animation* _animation)
+// Create a new handle on a copy of an animation, sprite included
+static Animation* AnimationDuplicate(const Animation* _animation)
 {
-	Animation* dest = (Animation*)malloc(sizeof(*_animation));
-	if (dest != NULL)
+	Animation* dest = AnimationHandleAlloc();
+	if (dest == NULL
+		|| !AnimationSystemDuplicate(
+			_animation->system, dest, _animation->index))
 	{
-		memcpy(dest, _animation, sizeof(*_animation));
-		dest->sprite = sfSprite_copy(_animation->sprite);
+		if (dest != NULL)
+		{
+			AnimationHandleFree(dest);
+		}
+		printf("Error during copying animation !");
+		return NULL;
 	}
-	else
+	AnimationSystem* system = dest->system;
+	const sfSprite* source = system->sprite[_animation->index];
+	sfSprite* sprite = AnimationSystemTakeSprite(system);
+	system->sprite[dest->index] = sprite;
+	if (sprite == NULL)
 	{
 		printf("Error during copying animation !");
+		return dest;
 	}
+	if (system->spriteSheet[_animation->index] != NULL)
+	{
+		sfSprite_setTexture(sprite, system->spriteSheet[_animation->index], sfFalse);
+	}
+	sfSprite_setTextureRect(sprite, sfSprite_getTextureRect(source));
+	sfSprite_setPosition(sprite, sfSprite_getPosition(source));
+	sfSprite_setRotation(sprite, sfSprite_getRotation(source));
+	sfSprite_setScale(sprite, sfSprite_getScale(source));
+	sfSprite_setOrigin(sprite, sfSprite_getOrigin(source));
+	sfSprite_setColor(sprite, sfSprite_getColor(source));
 	return dest;
 }
 
-Animation* AnimationCopy(const Animation* _animation)
+Animation* AnimationSmartCopy(const Animation* _animation)
 {
-	Animation* dest = (Animation*)malloc(sizeof(*_animation));
+	Animation* dest = AnimationDuplicate(_animation);
 	if (dest != NULL)
 	{
-		memcpy(dest, _animation, sizeof(*_animation));
-		dest->sprite = sfSprite_copy(_animation->sprite);
-		dest->spriteSheet = sfTexture_copy(_animation->spriteSheet);
-		dest->spriteSheetStructure = (char*)malloc(15);
-		if (dest->spriteSheetStructure != NULL)
+		// The copy holds a reference on the frame table, copied by
+		// AnimationSetFrameDurations before it changes, and on the sprite
+		// sheet, never modified
+		AnimationSystem* system = dest->system;
+		sfTexture* spriteSheet = system->spriteSheet[_animation->index];
+		if (spriteSheet != NULL)
 		{
-			strcpy_s(
-				dest->spriteSheetStructure,
-				15,
-				_animation->spriteSheetStructure);
+			system->spriteSheet[dest->index] = TextureCacheRetain(spriteSheet);
 		}
-
-	}
-	else
-	{
-		printf("Error during copying animation !");
 	}
 	return dest;
 }
 
+Animation* AnimationCopy(const Animation* _animation)
+{
+	return AnimationSmartCopy(_animation);
+}
+
 // Getters
 float AnimationGetDuration(const Animation* _anim)
 {
-	return _anim->duration;
+	return _anim->system->duration[_anim->index];
 }
 
 unsigned char AnimationGetCurrentFrame(const Animation* _anim)
 {
-	return _anim->currentFrame;
+	return (unsigned char)AnimationSystemGetFrame(_anim->system, _anim->index);
 }
 
 sfBool AnimationIsPlaying(const Animation* _anim)
 {
-	return _anim->isPlaying;
+	if (_anim->system->state[_anim->index] & LAZY)
+	{
+		sfBool playing = sfTrue;
+		AnimationSystemGetLazyClock(_anim->system, _anim->index, &playing);
+		return playing;
+	}
+	return _anim->system->isPlaying[_anim->index];
+}
+
+void AnimationSetTicks(Animation* _anim, unsigned int _ticks)
+{
+	if (_anim->system->tickRate == 0)
+	{
+		printf("Error : the animation system is not in tick mode !");
+		return;
+	}
+	AnimationSystemSetTicks(_anim->system, _anim->index, _ticks);
+}
+
+unsigned int AnimationGetTicks(const Animation* _anim)
+{
+	return _anim->system->ticks[_anim->index];
 }
 
 float AnimationGetClock(Animation* _anim)
 {
-	return _anim->clock;
+	if (_anim->system->state[_anim->index] & LAZY)
+	{
+		return AnimationSystemGetLazyClock(_anim->system, _anim->index, NULL);
+	}
+	AnimationSystemSync(_anim->system, _anim->index);
+	return _anim->system->clock[_anim->index];
 }
 
 unsigned char AnimationGetState(const Animation* _anim)
 {
-	return _anim->state;
+	return _anim->system->state[_anim->index];
 }
 
 sfVector2u AnimationGetFrameSize(Animation* _anim)
 {
-	return _anim->frameSize;
+	return _anim->system->frameSize[_anim->index];
 }
 
 unsigned char AnimationGetFramesNb(Animation* _anim)
 {
-	return _anim->framesNb;
+	return _anim->system->framesNb[_anim->index];
 }
 
 float AnimationGetFramerate(Animation* _anim)
 {
-	return _anim->duration / _anim->framesNb;
+	return _anim->system->duration[_anim->index]
+		/ _anim->system->framesNb[_anim->index];
 }
 
 const sfTexture* AnimationGetSpriteSheetTexture(const Animation* _animation)
 {
-	return sfSprite_getTexture(_animation->sprite);
+	return _animation->system->spriteSheet[_animation->index];
 }
 
 sfVector2f AnimationGetPosition(const Animation* _animation)
 {
-	return sfSprite_getPosition(_animation->sprite);
+	return _animation->system->position[_animation->index];
 }
 
 float AnimationGetRotation(const Animation* _animation)
 {
-	return sfSprite_getRotation(_animation->sprite);
+	return _animation->system->rotation[_animation->index];
 }
 
 sfVector2f AnimationGetScale(const Animation* _animation)
 {
-	return sfSprite_getScale(_animation->sprite);
+	return sfSprite_getScale(_animation->system->sprite[_animation->index]);
 }
 
 sfVector2f AnimationGetOrigin(const Animation* _animation)
 {
-	return sfSprite_getOrigin(_animation->sprite);
+	return sfSprite_getOrigin(_animation->system->sprite[_animation->index]);
 }
 
 sfTransform AnimationGetTransform(const Animation* _animation)
 {
-	return sfSprite_getTransform(_animation->sprite);
+	return sfSprite_getTransform(_animation->system->sprite[_animation->index]);
 }
 
 sfTransform AnimationGetInverseTransform(const Animation* _animation)
 {
-	return sfSprite_getInverseTransform(_animation->sprite);
+	return sfSprite_getInverseTransform(
+		_animation->system->sprite[_animation->index]);
 }
 
 sfColor AnimationGetColor(const Animation* _animation)
 {
-	return sfSprite_getColor(_animation->sprite);
+	return _animation->system->color[_animation->index];
 }
 
 sfFloatRect AnimationGetLocalBounds(const Animation* _animation)
 {
-	return sfSprite_getLocalBounds(_animation->sprite);
+	return sfSprite_getLocalBounds(
+		_animation->system->sprite[_animation->index]);
 }
 
 sfFloatRect AnimationGetGlobalBounds(const Animation* _animation)
 {
-	return sfSprite_getGlobalBounds(_animation->sprite);
+	return sfSprite_getGlobalBounds(
+		_animation->system->sprite[_animation->index]);
 }
 
 sfIntRect AnimationGetTextureRect(const Animation* _animation)
 {
-	return (sfSprite_getTextureRect(_animation->sprite));
+	AnimationSystemShowFrame(_animation->system, _animation->index);
+	return (sfSprite_getTextureRect(
+		_animation->system->sprite[_animation->index]));
 }
 
 // Setters
-void AnimationSetSpriteSheet(
+// Set the layout of a sprite sheet and compile its frames
+static sfIntRect AnimationSetSpriteSheetLayout(
 	Animation* _anim,
-	const char* _filename,
 	const char* _structure,
 	sfVector2u* _animationOffset,
 	sfVector2u* _blockLength)
 {
+	AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+
 	if (_animationOffset != NULL)
-		_anim->animationOffset = *_animationOffset;
+		system->animationOffset[i] = *_animationOffset;
 	else
-		_anim->animationOffset = (sfVector2u){ 0, 0 };
+		system->animationOffset[i] = (sfVector2u){ 0, 0 };
 
 	if (_blockLength != NULL)
-		_anim->blockLength = *_blockLength;
+		system->blockLength[i] = *_blockLength;
 	else
-		_anim->blockLength = (sfVector2u){ 0, 0 };
+		system->blockLength[i] = (sfVector2u){ 0, 0 };
+
+	system->layout[i] = (unsigned char)AnimationLayoutFromString(_structure);
 
-	strcpy_s(_anim->spriteSheetStructure, 15, _structure);
+	sfVector2u frameSize = system->frameSize[i];
 
 	// Surface area for the sprite sheet
-	const sfIntRect area;
+	sfIntRect area = AnimationLayoutGetArea(
+		(AnimationLayout)system->layout[i],
+		system->animationOffset[i],
+		frameSize,
+		system->framesNb[i],
+		system->blockLength[i]);
 
-	/// Calculate surface area according to the sprite sheet structure
-	if (strcmp(_anim->spriteSheetStructure, "horizontal") == 0)
-	{
-		*(sfIntRect*)&area = (sfIntRect){
-			_anim->animationOffset.x,
-			_anim->animationOffset.y,
-			_anim->frameSize.x * (int)_anim->framesNb,
-			_anim->frameSize.y
-		};
-	}
-	else if (strcmp(_anim->spriteSheetStructure, "vertical") == 0)
-	{
-		*(sfIntRect*)&area = (sfIntRect){
-			_anim->animationOffset.x,
-			_anim->animationOffset.y,
-			_anim->frameSize.x,
-			_anim->frameSize.y * (int)_anim->framesNb
-		};
-	}
-	else if (strcmp(_anim->spriteSheetStructure, "block") == 0)
-	{
-		*(sfIntRect*)&area = (sfIntRect){
-			_anim->animationOffset.x,
-			_anim->animationOffset.y,
-			_anim->blockLength.x * (int)_anim->frameSize.x,
-			_anim->blockLength.y * (int)_anim->frameSize.y };
-	}
+	// Compile the frames once, the update only looks them up
+	system->sheetOrigin[i] = (sfVector2i){ 0, 0 };
+	AnimationSystemBuildFrameTable(system, i);
+	return area;
+}
 
-	_anim->spriteSheet = sfTexture_createFromFile(
-		_filename,
-		(const sfIntRect*)&area);
+void AnimationSetSpriteSheet(
+	Animation* _anim,
+	const char* _filename,
+	const char* _structure,
+	sfVector2u* _animationOffset,
+	sfVector2u* _blockLength)
+{
+	AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	sfVector2u frameSize = system->frameSize[i];
+	sfIntRect area = AnimationSetSpriteSheetLayout(
+		_anim, _structure, _animationOffset, _blockLength);
+
+	// Instances of the same sprite sheet share a single texture
+	AnimationSystemSetSpriteSheet(system, i, TextureCacheAcquire(_filename, &area));
 
 	// creating texture for the spriteSheet
-	if (_anim->spriteSheet == NULL)
+	if (system->spriteSheet[i] == NULL)
 	{
 		printf("Error during cration of the sprite sheet texture !");
 	}
 	else
 	{
-		sfSprite_setTexture(_anim->sprite, _anim->spriteSheet, sfTrue);
 		sfSprite_setTextureRect(
-			_anim->sprite,
+			system->sprite[i],
 			(sfIntRect) {
-			0, 0, _anim->frameSize.x, _anim->frameSize.y
+			0, 0, frameSize.x, frameSize.y
 		});
 	}
+	AnimationSystemSchedule(system, i);
+}
+
+void AnimationSetSpriteSheetAsync(
+	Animation* _anim,
+	const char* _filename,
+	const char* _structure,
+	sfVector2u* _animationOffset,
+	sfVector2u* _blockLength)
+{
+	AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	sfIntRect area = AnimationSetSpriteSheetLayout(
+		_anim, _structure, _animationOffset, _blockLength);
+
+	// Already loaded, no need to wait
+	sfTexture* texture = TextureCacheLookup(_filename, &area);
+	if (texture != NULL)
+	{
+		AnimationSystemSetSpriteSheet(system, i, texture);
+		AnimationSystemFrameUpdate(system, i);
+		return;
+	}
+
+	// The sprite keeps the old texture, it is not drawn until the new one is set
+	AnimationSystemSetSpriteSheet(system, i, NULL);
+	system->pendingSheet[i] = SpriteSheetLoaderRequest(_filename, &area);
+	if (system->pendingSheet[i] == NULL)
+	{
+		printf("Error during cration of the sprite sheet texture !");
+	}
+	AnimationSystemSchedule(system, i);
+}
+
+sfBool AnimationIsSpriteSheetPending(const Animation* _anim)
+{
+	return _anim->system->pendingSheet[_anim->index] != NULL;
 }
 
 void AnimationSetFrame(Animation* _anim, unsigned char _frame)
 {
-	_anim->currentFrame = _frame;
+	AnimationSystemSync(_anim->system, _anim->index);
+	AnimationSystemSetFrame(_anim->system, _anim->index, _frame);
+	AnimationSystemSchedule(_anim->system, _anim->index);
 }
 
 void AnimationSetDuration(Animation* _anim, float _duration)
 {
-	_anim->duration = _duration;
+	AnimationSystemSync(_anim->system, _anim->index);
+	_anim->system->duration[_anim->index] = _duration;
+	AnimationSystemSchedule(_anim->system, _anim->index);
 }
 
 void AnimationSetFramerate(Animation* _anim, float _framerate)
 {
-	_anim->duration = (float)(_anim->framesNb) / _framerate;
+	AnimationSystemSync(_anim->system, _anim->index);
+	_anim->system->duration[_anim->index] =
+		(float)(_anim->system->framesNb[_anim->index]) / _framerate;
+	AnimationSystemSchedule(_anim->system, _anim->index);
 }
 
 void AnimationSetClock(Animation* _anim, float _clock)
 {
-	_anim->clock = _clock;
+	AnimationSystemSync(_anim->system, _anim->index);
+	AnimationSystemSetClock(_anim->system, _anim->index, _clock);
+	AnimationSystemSchedule(_anim->system, _anim->index);
 }
 
 void AnimationSetState(Animation* _anim, unsigned char _state)
 {
-	_anim->state = _state;
+	AnimationSystemSync(_anim->system, _anim->index);
+	AnimationSystemSetState(_anim->system, _anim->index, _state);
+	AnimationSystemSetFlipState(_anim->system, _anim->index);
+	AnimationSystemSchedule(_anim->system, _anim->index);
+}
+
+void AnimationSetFrameDurations(Animation* _anim, const float* _durations)
+{
+	AnimationSystem* system = _anim->system;
+	FrameTable* table = system->frameTable[_anim->index];
+	if (table == NULL)
+	{
+		printf("Error : set a sprite sheet before the frame durations !");
+		return;
+	}
+	AnimationSystemSync(system, _anim->index);
+
+	// Copies share their frame table, give this one its own
+	if (table->refCount > 1)
+	{
+		FrameTable* copy = FrameTableCopy(table);
+		if (copy == NULL)
+		{
+			return;
+		}
+		FrameTableRelease(table);
+		system->frameTable[_anim->index] = copy;
+		table = copy;
+	}
+
+	float duration = FrameTableSetDurations(table, _durations);
+	system->variableTimes[_anim->index] = table->times != NULL;
+	if (duration > 0)
+	{
+		system->duration[_anim->index] = duration;
+	}
+	AnimationSystemSchedule(system, _anim->index);
 }
 
 void AnimationSetFrameSize(Animation* _anim, sfVector2u _frameSize)
 {
-	_anim->frameSize = _frameSize;
+	AnimationSystem* system = _anim->system;
+	system->frameSize[_anim->index] = _frameSize;
+
+	// Keep the origin in the middle of the frame
+	sfSprite_setOrigin(system->sprite[_anim->index],
+		(sfVector2f) {
+		(float)_frameSize.x / 2,
+			(float)_frameSize.y / 2
+	});
+	AnimationSystemBuildFrameTable(system, _anim->index);
+	AnimationSystemUpdateBounds(system, _anim->index);
 }
 
 void AnimationSetFramesNb(Animation* _anim, unsigned char _frameNb)
 {
-	_anim->framesNb = _frameNb;
+	AnimationSystemSync(_anim->system, _anim->index);
+	_anim->system->framesNb[_anim->index] = _frameNb;
+	AnimationSystemBuildFrameTable(_anim->system, _anim->index);
+	AnimationSystemSchedule(_anim->system, _anim->index);
 }
 
 void AnimationSetPosition(Animation* _animation, sfVector2f _position)
 {
-	sfSprite_setPosition(_animation->sprite, _position);
+	AnimationSystem* system = _animation->system;
+	system->position[_animation->index] = _position;
+	sfSprite_setPosition(system->sprite[_animation->index], _position);
+	AnimationSystemUpdateBounds(system, _animation->index);
 }
 
 void AnimationSetRotation(Animation* _animation, float _angle)
 {
-	sfSprite_setRotation(_animation->sprite, _angle);
+	AnimationSystem* system = _animation->system;
+	sfSprite_setRotation(system->sprite[_animation->index], _angle);
+	system->rotation[_animation->index] =
+		sfSprite_getRotation(system->sprite[_animation->index]);
+	AnimationSystemUpdateBounds(system, _animation->index);
 }
 
 void AnimationSetScale(Animation* _animation, sfVector2f _scale)
 {
-	sfSprite_setScale(_animation->sprite, _scale);
-	_animation->scale = _scale;
+	AnimationSystem* system = _animation->system;
+	system->scale[_animation->index] = _scale;
+	AnimationSystemSetFlipState(system, _animation->index);
+	AnimationSystemUpdateBounds(system, _animation->index);
 }
 
 void AnimationMove(Animation* _animation, sfVector2f _offset)
 {
-	sfSprite_move(_animation->sprite, _offset);
+	AnimationSystem* system = _animation->system;
+	sfVector2f* position = &system->position[_animation->index];
+	position->x += _offset.x;
+	position->y += _offset.y;
+	sfSprite_setPosition(system->sprite[_animation->index], *position);
+	AnimationSystemUpdateBounds(system, _animation->index);
 }
 
 void AnimationRotate(Animation* _animation, float _angle)
 {
-	sfSprite_rotate(_animation->sprite, _angle);
+	AnimationSystem* system = _animation->system;
+	sfSprite_rotate(system->sprite[_animation->index], _angle);
+	system->rotation[_animation->index] =
+		sfSprite_getRotation(system->sprite[_animation->index]);
+	AnimationSystemUpdateBounds(system, _animation->index);
 }
 
 void AnimationScale(Animation* _animation, sfVector2f _factors)
 {
-	sfSprite_scale(_animation->sprite, _factors);
-	_animation->scale = _factors;
+	AnimationSystem* system = _animation->system;
+	sfVector2f* scale = &system->scale[_animation->index];
+	scale->x *= _factors.x;
+	scale->y *= _factors.y;
+	AnimationSystemSetFlipState(system, _animation->index);
+	AnimationSystemUpdateBounds(system, _animation->index);
 }
 
 void AnimationSetColor(Animation* _animation, sfColor _color)
 {
-	sfSprite_setColor(_animation->sprite, _color);
+	AnimationSystem* system = _animation->system;
+	system->color[_animation->index] = _color;
+	sfSprite_setColor(system->sprite[_animation->index], _color);
 }
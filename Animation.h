@@ -6,7 +6,7 @@
 #include <SFML/Graphics.h>
 
 /// @brief Differents possible states of playing a animation
-/// (Default, LOOPED, REVERSED, FLIP_X, FLIP_Y)
+/// (Default, LOOPED, REVERSED, FLIP_X, FLIP_Y, LAZY)
 enum State
 {
 	/// @brief Default state
@@ -18,7 +18,10 @@ enum State
 	/// @brief Apply a horizontal flip
 	FLIP_X = 0x08,
 	/// @brief Apply a vertical flip
-	FLIP_Y = 0x10
+	FLIP_Y = 0x10,
+	/// @brief Compute the frame from the global clock when it is read,
+	/// the animation is never updated
+	LAZY = 0x20
 };
 
 typedef struct Animation Animation;
@@ -26,6 +29,9 @@ typedef struct Animation Animation;
 //////////////////////////////////////////////////////////////
 /// @brief Create a new animation
 /// 
+/// The animation is stored in the default animation system,
+/// see AnimationSystem.h to batch animations in your own system.
+/// 
 /// @param _frameSize Size of a animation
 /// 
 /// @param _frameNb Number of frames
@@ -34,6 +40,31 @@ typedef struct Animation Animation;
 //////////////////////////////////////////////////////////////
 Animation* AnimationCreate(sfVector2u _frameSize, unsigned char _framesNb);
 
+//////////////////////////////////////////////////////////////
+/// @brief Advance the global clock driving the lazy animations
+///
+/// Animations played with the LAZY state only store the time of the
+/// global clock they started at, their frame is computed from it when
+/// it is read or drawn. Call it once per frame instead of updating them.
+///
+/// @param _dt Delta time
+//////////////////////////////////////////////////////////////
+void AnimationAdvanceGlobalClock(float _dt);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the time of the global clock driving the lazy animations
+///
+/// @param _time Time of the global clock
+//////////////////////////////////////////////////////////////
+void AnimationSetGlobalClock(double _time);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the time of the global clock driving the lazy animations
+///
+/// @return Time of the global clock
+//////////////////////////////////////////////////////////////
+double AnimationGetGlobalClock(void);
+
 //////////////////////////////////////////////////////////////
 /// @brief Set the flipping state of an Animation
 /// 
@@ -45,6 +76,9 @@ void AnimationSetFlipState(Animation* _anim);
 //////////////////////////////////////////////////////////////
 /// @brief Update an animation
 /// 
+/// In tick mode, the animation is advanced by whole ticks and the
+/// fraction left is carried to its next update.
+/// 
 /// @param _anim Animation object
 /// 
 /// @param _dt Delta time
@@ -82,6 +116,9 @@ void AnimationDrawRenderTex(
 ///
 /// @brief Destroy an existing animation
 ///
+/// Same as AnimationDestroy, kept for the copies made with
+/// AnimationSmartCopy: sprite sheets are reference counted.
+///
 ///  @param _anim Animation object
 ///
 //////////////////////////////////////////////////////////////
@@ -90,6 +127,9 @@ void AnimationSoftDestroy(Animation* _anim);
 ////////////////////////////////////////////////////////////
 /// @brief Destroy an existing animation
 ///
+/// The reference to the sprite sheet texture is released, the texture
+/// is destroyed with the last animation using it.
+///
 /// @param _anim Animation object
 ///
 ////////////////////////////////////////////////////////////
@@ -98,6 +138,10 @@ void AnimationDestroy(Animation* _anim);
 //////////////////////////////////////////////////////////////
 /// @brief Play an animation with the given state
 /// 
+/// With the LAZY state the animation plays from the global clock and
+/// updating it does nothing. Pausing it freezes it at its current frame
+/// and removes the LAZY state.
+/// 
 /// @param _anim Animation object
 /// 
 /// @param _state State of the animation
@@ -191,6 +235,8 @@ unsigned char AnimationGetFramesNb(Animation* _anim);
 //////////////////////////////////////////////////////////////
 /// @brief Create a sprite sheet texture and set 
 /// 
+/// Animations using the same file and area share a single texture.
+/// 
 /// @param _anim Animation object
 /// 
 /// @param _filename File name of the file containing sprite sheet
@@ -210,6 +256,41 @@ void AnimationSetSpriteSheet(
 	sfVector2u* _animationOffset,
 	sfVector2u* _blockLength);
 
+//////////////////////////////////////////////////////////////
+/// @brief Set the sprite sheet of an animation without waiting for it
+/// to be loaded
+///
+/// The image is decoded on a loader thread and the texture is created
+/// by a later update of the animation. Meanwhile the animation keeps
+/// playing but is not drawn.
+///
+/// @param _anim Animation object
+///
+/// @param _filename Path of the sprite sheet file
+///
+/// @param _structure Sprite sheet structure ("horizontal", "vertical" or "block")
+///
+/// @param _animationOffset Offset of the animation, NULL for none
+///
+/// @param _blockLength Width and height of the block sprite sheet,
+///					   NULL if sprite sheet is not a block
+//////////////////////////////////////////////////////////////
+void AnimationSetSpriteSheetAsync(
+	Animation* _anim,
+	const char* _filename,
+	const char* _structure,
+	sfVector2u* _animationOffset,
+	sfVector2u* _blockLength);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if the sprite sheet of an animation is still loading
+///
+/// @param _anim Animation object
+///
+/// @return sfTrue while the sprite sheet is loading, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationIsSpriteSheetPending(const Animation* _anim);
+
 //////////////////////////////////////////////////////////////
 /// @brief Set the duration of an animation 
 /// 
@@ -239,6 +320,19 @@ void AnimationSetFramerate(Animation* _anim, float _framerate);
 //////////////////////////////////////////////////////////////
 void AnimationSetState(Animation* _anim, unsigned char _state);
 
+//////////////////////////////////////////////////////////////
+/// @brief Set the duration of each frame of an animation
+/// 
+/// The duration of the animation becomes the sum of the durations.
+/// Must be called after AnimationSetSpriteSheet.
+/// 
+/// @param _anim Animation object
+/// 
+/// @param _durations Duration of each of the frames,
+///					 NULL to give the same duration to every frame
+//////////////////////////////////////////////////////////////
+void AnimationSetFrameDurations(Animation* _anim, const float* _durations);
+
 //////////////////////////////////////////////////////////////
 /// @brief Set the frame size of an animation
 /// 
@@ -261,6 +355,36 @@ void AnimationSetClock(Animation* _anim, float _clock);
 
 float AnimationGetClock(Animation* _anim);
 
+//////////////////////////////////////////////////////////////
+/// @brief Update an animation of a system in tick mode
+///
+/// See AnimationSystemSetTickRate.
+///
+/// @param _anim Animation object
+///
+/// @param _ticks Ticks elapsed
+//////////////////////////////////////////////////////////////
+void AnimationUpdateTicks(Animation* _anim, unsigned int _ticks);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the clock of an animation in ticks, its frame changes
+/// right away
+///
+/// @param _anim Animation object of a system in tick mode
+///
+/// @param _ticks Clock in ticks, clamped to the duration
+//////////////////////////////////////////////////////////////
+void AnimationSetTicks(Animation* _anim, unsigned int _ticks);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the clock of an animation in ticks
+///
+/// @param _anim Animation object of a system in tick mode
+///
+/// @return Clock in ticks
+//////////////////////////////////////////////////////////////
+unsigned int AnimationGetTicks(const Animation* _anim);
+
 //////////////////////////////////////////////////////////////
 /// @brief Get the frame rate of an animation
 /// 
@@ -273,17 +397,23 @@ float AnimationGetClock(Animation* _anim);
 float AnimationGetFramerate(Animation* _anim);
 
 //////////////////////////////////////////////////////////////
-/// @brief Get the sprite sheet texture of an animation
+/// @brief Copy an existing animation, sharing its sprite sheet
 ///
-///  @param _anim Animation object
+/// Same as AnimationCopy. To spawn many animations of the same sprite
+/// sheet, create an AnimationClip once and spawn its instances instead
+/// (see AnimationClip.h).
+///
+///  @param _animation Animation to copy
 /// 
-///  @return Sprite sheet texture of the animation
+///  @return Copied object, NULL if the copy fail
 //////////////////////////////////////////////////////////////
 Animation* AnimationSmartCopy(const Animation* _animation);
 
 ////////////////////////////////////////////////////////////
 /// @brief Copy an existing animation
 ///
+/// Same as AnimationSmartCopy.
+///
 /// @param _animation Animation to copy
 ///
 /// @return Copied object, NULL if the copy fail
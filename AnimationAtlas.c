@@ -0,0 +1,862 @@
+#include "AnimationAtlas.h"
+#include "AnimationInternal.h"
+#include "FrameTable.h"
+#include "TextureCache.h"
+
+#include <SFML/Graphics.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Length of a line of an atlas description file
+#define ANIMATION_ATLAS_LINE_LENGTH 1024
+
+/// @brief Area of an image and its place in the atlas
+typedef struct AtlasRegion
+{
+	unsigned int hash;
+	char* filename;
+	sfIntRect area;
+	unsigned int page;
+	sfVector2i position;
+} AtlasRegion;
+
+/// @brief Top edge of the space used in a page, from x to x + width
+typedef struct AtlasSkylineNode
+{
+	int x;
+	int y;
+	int width;
+} AtlasSkylineNode;
+
+typedef struct AtlasPage
+{
+	AtlasSkylineNode* skyline;
+	unsigned int nodesNb;
+	unsigned int nodesCapacity;
+	/// Space used by the regions, the size of the page texture
+	sfVector2u size;
+	sfTexture* texture;
+} AtlasPage;
+
+struct AnimationAtlas
+{
+	unsigned int pageSize;
+	unsigned int padding;
+
+	AtlasRegion* regions;
+	unsigned int regionsNb;
+	unsigned int regionsCapacity;
+
+	AtlasPage* pages;
+	unsigned int pagesNb;
+	unsigned int pagesCapacity;
+
+	sfBool packed;
+	sfBool built;
+};
+
+/// @brief Region waiting to be packed
+typedef struct AtlasPackItem
+{
+	int width;
+	int height;
+	unsigned int region;
+} AtlasPackItem;
+
+// Make room for one more element in a dynamic array
+static sfBool AnimationAtlasGrow(
+	void** _array,
+	size_t _elementSize,
+	unsigned int _count,
+	unsigned int* _capacity)
+{
+	if (_count < *_capacity)
+	{
+		return sfTrue;
+	}
+	unsigned int capacity = *_capacity > 0 ? *_capacity * 2 : 16;
+	void* array = realloc(*_array, _elementSize * capacity);
+	if (array == NULL)
+	{
+		printf("Error during memory allocation !");
+		return sfFalse;
+	}
+	*_array = array;
+	*_capacity = capacity;
+	return sfTrue;
+}
+
+// FNV-1a hash of the file name and area
+static unsigned int AnimationAtlasHash(const char* _filename, sfIntRect _area)
+{
+	unsigned int hash = 2166136261u;
+	for (const char* c = _filename; *c != '\0'; c++)
+	{
+		hash = (hash ^ (unsigned char)*c) * 16777619u;
+	}
+	const unsigned char* bytes = (const unsigned char*)&_area;
+	for (size_t i = 0; i < sizeof(_area); i++)
+	{
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+	return hash;
+}
+
+static int AnimationAtlasFindRegion(
+	const AnimationAtlas* _atlas,
+	const char* _filename,
+	sfIntRect _area)
+{
+	unsigned int hash = AnimationAtlasHash(_filename, _area);
+	for (unsigned int i = 0; i < _atlas->regionsNb; i++)
+	{
+		const AtlasRegion* region = &_atlas->regions[i];
+		if (region->hash == hash
+			&& memcmp(&region->area, &_area, sizeof(_area)) == 0
+			&& strcmp(region->filename, _filename) == 0)
+		{
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+static void AnimationAtlasClearPages(AnimationAtlas* _atlas)
+{
+	for (unsigned int i = 0; i < _atlas->pagesNb; i++)
+	{
+		free(_atlas->pages[i].skyline);
+		TextureCacheRelease(_atlas->pages[i].texture);
+	}
+	_atlas->pagesNb = 0;
+	_atlas->packed = sfFalse;
+	_atlas->built = sfFalse;
+}
+
+static AtlasPage* AnimationAtlasAddPage(AnimationAtlas* _atlas)
+{
+	if (!AnimationAtlasGrow(
+		(void**)&_atlas->pages,
+		sizeof(AtlasPage),
+		_atlas->pagesNb,
+		&_atlas->pagesCapacity))
+	{
+		return NULL;
+	}
+	AtlasPage* page = &_atlas->pages[_atlas->pagesNb];
+	page->skyline = NULL;
+	page->nodesNb = 0;
+	page->nodesCapacity = 0;
+	page->size = (sfVector2u){ 0, 0 };
+	page->texture = NULL;
+	_atlas->pagesNb++;
+	return page;
+}
+
+AnimationAtlas* AnimationAtlasCreate(unsigned int _pageSize, unsigned int _padding)
+{
+	AnimationAtlas* atlas = (AnimationAtlas*)calloc(1, sizeof(AnimationAtlas));
+	if (atlas == NULL)
+	{
+		printf("Error during memory allocation !");
+		return NULL;
+	}
+	atlas->pageSize = _pageSize > 0 ? _pageSize : sfTexture_getMaximumSize();
+	atlas->padding = _padding;
+	return atlas;
+}
+
+void AnimationAtlasDestroy(AnimationAtlas* _atlas)
+{
+	if (_atlas == NULL)
+	{
+		return;
+	}
+	AnimationAtlasClearPages(_atlas);
+	for (unsigned int i = 0; i < _atlas->regionsNb; i++)
+	{
+		free(_atlas->regions[i].filename);
+	}
+	free(_atlas->regions);
+	free(_atlas->pages);
+	free(_atlas);
+}
+
+int AnimationAtlasAdd(
+	AnimationAtlas* _atlas,
+	const char* _filename,
+	sfIntRect _area)
+{
+	int index = AnimationAtlasFindRegion(_atlas, _filename, _area);
+	if (index >= 0)
+	{
+		return index;
+	}
+	if (_area.width <= 0 || _area.height <= 0)
+	{
+		printf("Error : empty sprite sheet area !");
+		return -1;
+	}
+	if (!AnimationAtlasGrow(
+		(void**)&_atlas->regions,
+		sizeof(AtlasRegion),
+		_atlas->regionsNb,
+		&_atlas->regionsCapacity))
+	{
+		return -1;
+	}
+
+	AtlasRegion* region = &_atlas->regions[_atlas->regionsNb];
+	region->filename = (char*)malloc(strlen(_filename) + 1);
+	if (region->filename == NULL)
+	{
+		printf("Error during memory allocation !");
+		return -1;
+	}
+	strcpy(region->filename, _filename);
+	region->hash = AnimationAtlasHash(_filename, _area);
+	region->area = _area;
+	region->page = 0;
+	region->position = (sfVector2i){ 0, 0 };
+
+	// The placements of the other regions are not valid anymore
+	AnimationAtlasClearPages(_atlas);
+	return (int)_atlas->regionsNb++;
+}
+
+int AnimationAtlasAddSpriteSheet(
+	AnimationAtlas* _atlas,
+	const char* _filename,
+	const char* _structure,
+	sfVector2u _frameSize,
+	unsigned char _framesNb,
+	const sfVector2u* _animationOffset,
+	const sfVector2u* _blockLength)
+{
+	sfIntRect area = AnimationLayoutGetArea(
+		AnimationLayoutFromString(_structure),
+		_animationOffset != NULL ? *_animationOffset : (sfVector2u) { 0, 0 },
+		_frameSize,
+		_framesNb,
+		_blockLength != NULL ? *_blockLength : (sfVector2u) { 0, 0 });
+	return AnimationAtlasAdd(_atlas, _filename, area);
+}
+
+// Height at which a rect fits on the skyline from a node, -1 if it does not
+static int AnimationAtlasSkylineFit(
+	const AtlasPage* _page,
+	unsigned int _node,
+	int _width,
+	int _height,
+	int _pageSize)
+{
+	if (_page->skyline[_node].x + _width > _pageSize)
+	{
+		return -1;
+	}
+	int y = _page->skyline[_node].y;
+	int widthLeft = _width;
+	for (unsigned int i = _node; widthLeft > 0; i++)
+	{
+		if (i >= _page->nodesNb)
+		{
+			return -1;
+		}
+		if (_page->skyline[i].y > y)
+		{
+			y = _page->skyline[i].y;
+		}
+		if (y + _height > _pageSize)
+		{
+			return -1;
+		}
+		widthLeft -= _page->skyline[i].width;
+	}
+	return y;
+}
+
+// Raise the skyline over a rect placed at a node
+static sfBool AnimationAtlasSkylineAdd(
+	AtlasPage* _page,
+	unsigned int _node,
+	int _y,
+	int _width,
+	int _height)
+{
+	if (!AnimationAtlasGrow(
+		(void**)&_page->skyline,
+		sizeof(AtlasSkylineNode),
+		_page->nodesNb,
+		&_page->nodesCapacity))
+	{
+		return sfFalse;
+	}
+	AtlasSkylineNode* skyline = _page->skyline;
+	memmove(
+		&skyline[_node + 1],
+		&skyline[_node],
+		sizeof(AtlasSkylineNode) * (_page->nodesNb - _node));
+	skyline[_node].y = _y + _height;
+	skyline[_node].width = _width;
+	_page->nodesNb++;
+
+	// Cut the nodes now under the new one
+	unsigned int i = _node + 1;
+	while (i < _page->nodesNb)
+	{
+		int previousEnd = skyline[i - 1].x + skyline[i - 1].width;
+		if (skyline[i].x >= previousEnd)
+		{
+			break;
+		}
+		int shrink = previousEnd - skyline[i].x;
+		skyline[i].x += shrink;
+		skyline[i].width -= shrink;
+		if (skyline[i].width > 0)
+		{
+			break;
+		}
+		memmove(
+			&skyline[i],
+			&skyline[i + 1],
+			sizeof(AtlasSkylineNode) * (_page->nodesNb - i - 1));
+		_page->nodesNb--;
+	}
+
+	// Merge the neighbours at the same height
+	i = 0;
+	while (i + 1 < _page->nodesNb)
+	{
+		if (skyline[i].y != skyline[i + 1].y)
+		{
+			i++;
+			continue;
+		}
+		skyline[i].width += skyline[i + 1].width;
+		memmove(
+			&skyline[i + 1],
+			&skyline[i + 2],
+			sizeof(AtlasSkylineNode) * (_page->nodesNb - i - 2));
+		_page->nodesNb--;
+	}
+	return sfTrue;
+}
+
+// Place a rect as high then as far left as possible, sfFalse if it does not fit
+static sfBool AnimationAtlasPlace(
+	AnimationAtlas* _atlas,
+	AtlasPage* _page,
+	int _width,
+	int _height,
+	sfVector2i* _position)
+{
+	// The padding is not needed past the edges of the page
+	int pageSize = (int)(_atlas->pageSize + _atlas->padding);
+	int bestY = -1;
+	unsigned int bestNode = 0;
+
+	if (_page->nodesNb == 0)
+	{
+		if (!AnimationAtlasGrow(
+			(void**)&_page->skyline,
+			sizeof(AtlasSkylineNode),
+			0,
+			&_page->nodesCapacity))
+		{
+			return sfFalse;
+		}
+		_page->skyline[0] = (AtlasSkylineNode){ 0, 0, pageSize };
+		_page->nodesNb = 1;
+	}
+
+	for (unsigned int i = 0; i < _page->nodesNb; i++)
+	{
+		int y = AnimationAtlasSkylineFit(_page, i, _width, _height, pageSize);
+		if (y >= 0 && (bestY < 0 || y < bestY))
+		{
+			bestY = y;
+			bestNode = i;
+		}
+	}
+	if (bestY < 0)
+	{
+		return sfFalse;
+	}
+	*_position = (sfVector2i){ _page->skyline[bestNode].x, bestY };
+	return AnimationAtlasSkylineAdd(_page, bestNode, bestY, _width, _height);
+}
+
+// Tallest first, then widest, then in the order they were added
+static int AnimationAtlasCompareItems(const void* _a, const void* _b)
+{
+	const AtlasPackItem* a = (const AtlasPackItem*)_a;
+	const AtlasPackItem* b = (const AtlasPackItem*)_b;
+	if (a->height != b->height)
+	{
+		return a->height > b->height ? -1 : 1;
+	}
+	if (a->width != b->width)
+	{
+		return a->width > b->width ? -1 : 1;
+	}
+	return a->region < b->region ? -1 : (a->region > b->region ? 1 : 0);
+}
+
+sfBool AnimationAtlasPack(AnimationAtlas* _atlas)
+{
+	AnimationAtlasClearPages(_atlas);
+	if (_atlas->regionsNb == 0)
+	{
+		_atlas->packed = sfTrue;
+		return sfTrue;
+	}
+
+	AtlasPackItem* items =
+		(AtlasPackItem*)malloc(sizeof(AtlasPackItem) * _atlas->regionsNb);
+	if (items == NULL)
+	{
+		printf("Error during memory allocation !");
+		return sfFalse;
+	}
+	for (unsigned int i = 0; i < _atlas->regionsNb; i++)
+	{
+		items[i].width = _atlas->regions[i].area.width + (int)_atlas->padding;
+		items[i].height = _atlas->regions[i].area.height + (int)_atlas->padding;
+		items[i].region = i;
+	}
+	qsort(items, _atlas->regionsNb, sizeof(AtlasPackItem), AnimationAtlasCompareItems);
+
+	sfBool packed = sfTrue;
+	for (unsigned int i = 0; i < _atlas->regionsNb && packed; i++)
+	{
+		AtlasRegion* region = &_atlas->regions[items[i].region];
+		unsigned int page = 0;
+		while (page < _atlas->pagesNb
+			&& !AnimationAtlasPlace(
+				_atlas, &_atlas->pages[page], items[i].width, items[i].height, &region->position))
+		{
+			page++;
+		}
+		if (page == _atlas->pagesNb)
+		{
+			AtlasPage* newPage = AnimationAtlasAddPage(_atlas);
+			if (newPage == NULL
+				|| !AnimationAtlasPlace(
+					_atlas, newPage, items[i].width, items[i].height, &region->position))
+			{
+				printf("Error : sprite sheet area larger than an atlas page !");
+				packed = sfFalse;
+				break;
+			}
+		}
+		region->page = page;
+
+		AtlasPage* regionPage = &_atlas->pages[page];
+		unsigned int right = (unsigned int)(region->position.x + region->area.width);
+		unsigned int bottom = (unsigned int)(region->position.y + region->area.height);
+		regionPage->size.x = right > regionPage->size.x ? right : regionPage->size.x;
+		regionPage->size.y = bottom > regionPage->size.y ? bottom : regionPage->size.y;
+	}
+	free(items);
+
+	if (!packed)
+	{
+		AnimationAtlasClearPages(_atlas);
+		return sfFalse;
+	}
+	_atlas->packed = sfTrue;
+	return sfTrue;
+}
+
+sfBool AnimationAtlasBuild(AnimationAtlas* _atlas)
+{
+	if (_atlas->built)
+	{
+		return sfTrue;
+	}
+	if (!_atlas->packed && !AnimationAtlasPack(_atlas))
+	{
+		return sfFalse;
+	}
+
+	sfImage** images = (sfImage**)calloc(_atlas->pagesNb + 1, sizeof(sfImage*));
+	if (images == NULL)
+	{
+		printf("Error during memory allocation !");
+		return sfFalse;
+	}
+	sfBool built = sfTrue;
+	for (unsigned int i = 0; i < _atlas->pagesNb && built; i++)
+	{
+		images[i] = sfImage_createFromColor(
+			_atlas->pages[i].size.x, _atlas->pages[i].size.y, sfTransparent);
+		built = images[i] != NULL;
+	}
+
+	// Decode each file once, whatever the number of its regions
+	for (unsigned int i = 0; i < _atlas->regionsNb && built; i++)
+	{
+		const char* filename = _atlas->regions[i].filename;
+		sfBool loaded = sfFalse;
+		for (unsigned int j = 0; j < i && !loaded; j++)
+		{
+			loaded = strcmp(_atlas->regions[j].filename, filename) == 0;
+		}
+		if (loaded)
+		{
+			continue;
+		}
+
+		sfImage* source = sfImage_createFromFile(filename);
+		if (source == NULL)
+		{
+			printf("Error during loading of an atlas sprite sheet !");
+			built = sfFalse;
+			break;
+		}
+		for (unsigned int j = i; j < _atlas->regionsNb; j++)
+		{
+			const AtlasRegion* region = &_atlas->regions[j];
+			if (strcmp(region->filename, filename) == 0)
+			{
+				sfImage_copyImage(
+					images[region->page],
+					source,
+					(unsigned int)region->position.x,
+					(unsigned int)region->position.y,
+					region->area,
+					sfFalse);
+			}
+		}
+		sfImage_destroy(source);
+	}
+
+	for (unsigned int i = 0; i < _atlas->pagesNb && built; i++)
+	{
+		sfTexture* texture = sfTexture_createFromImage(images[i], NULL);
+		_atlas->pages[i].texture =
+			texture != NULL ? TextureCacheAdopt(texture) : NULL;
+		if (_atlas->pages[i].texture == NULL)
+		{
+			printf("Error during cration of an atlas page texture !");
+			if (texture != NULL)
+			{
+				sfTexture_destroy(texture);
+			}
+			built = sfFalse;
+		}
+	}
+
+	for (unsigned int i = 0; i < _atlas->pagesNb; i++)
+	{
+		if (images[i] != NULL)
+		{
+			sfImage_destroy(images[i]);
+		}
+	}
+	free(images);
+
+	if (!built)
+	{
+		for (unsigned int i = 0; i < _atlas->pagesNb; i++)
+		{
+			TextureCacheRelease(_atlas->pages[i].texture);
+			_atlas->pages[i].texture = NULL;
+		}
+		return sfFalse;
+	}
+	_atlas->built = sfTrue;
+	return sfTrue;
+}
+
+// Length of the directory part of a path, separator included
+static size_t AnimationAtlasGetDirectoryLength(const char* _path)
+{
+	const char* slash = strrchr(_path, '/');
+	const char* backslash = strrchr(_path, '\\');
+	if (backslash != NULL && (slash == NULL || backslash > slash))
+	{
+		slash = backslash;
+	}
+	return slash != NULL ? (size_t)(slash - _path) + 1 : 0;
+}
+
+// File of a page, next to the description file and named after it
+static void AnimationAtlasGetPageFilename(
+	const char* _filename,
+	unsigned int _page,
+	char* _pageFilename,
+	size_t _size)
+{
+	size_t length = strlen(_filename);
+	const char* extension = strrchr(_filename, '.');
+	if (extension != NULL && extension > _filename + AnimationAtlasGetDirectoryLength(_filename))
+	{
+		length = (size_t)(extension - _filename);
+	}
+	snprintf(_pageFilename, _size, "%.*s_%u.png", (int)length, _filename, _page);
+}
+
+sfBool AnimationAtlasSave(const AnimationAtlas* _atlas, const char* _filename)
+{
+	if (!_atlas->built)
+	{
+		printf("Error : the atlas is not built !");
+		return sfFalse;
+	}
+	FILE* file = fopen(_filename, "w");
+	if (file == NULL)
+	{
+		printf("Error during opening of the atlas file !");
+		return sfFalse;
+	}
+
+	sfBool saved = sfTrue;
+	size_t directoryLength = AnimationAtlasGetDirectoryLength(_filename);
+	char pageFilename[ANIMATION_ATLAS_LINE_LENGTH];
+
+	fprintf(file, "atlas %u %u\n", _atlas->pagesNb, _atlas->regionsNb);
+	for (unsigned int i = 0; i < _atlas->pagesNb && saved; i++)
+	{
+		AnimationAtlasGetPageFilename(_filename, i, pageFilename, sizeof(pageFilename));
+		sfImage* image = sfTexture_copyToImage(_atlas->pages[i].texture);
+		saved = image != NULL && sfImage_saveToFile(image, pageFilename);
+		if (image != NULL)
+		{
+			sfImage_destroy(image);
+		}
+		// Pages are found relatively to the description file
+		fprintf(file, "page %u %u %s\n",
+			_atlas->pages[i].size.x,
+			_atlas->pages[i].size.y,
+			pageFilename + directoryLength);
+	}
+	for (unsigned int i = 0; i < _atlas->regionsNb; i++)
+	{
+		const AtlasRegion* region = &_atlas->regions[i];
+		fprintf(file, "region %u %d %d %d %d %d %d %s\n",
+			region->page,
+			region->position.x,
+			region->position.y,
+			region->area.left,
+			region->area.top,
+			region->area.width,
+			region->area.height,
+			region->filename);
+	}
+	if (fclose(file) != 0)
+	{
+		saved = sfFalse;
+	}
+	if (!saved)
+	{
+		printf("Error during saving of the atlas !");
+	}
+	return saved;
+}
+
+// Remove the line break at the end of a line
+static void AnimationAtlasTrimLine(char* _line)
+{
+	size_t length = strlen(_line);
+	while (length > 0 && (_line[length - 1] == '\n' || _line[length - 1] == '\r'))
+	{
+		_line[--length] = '\0';
+	}
+}
+
+AnimationAtlas* AnimationAtlasLoad(const char* _filename)
+{
+	FILE* file = fopen(_filename, "r");
+	if (file == NULL)
+	{
+		printf("Error during opening of the atlas file !");
+		return NULL;
+	}
+	AnimationAtlas* atlas = AnimationAtlasCreate(0, 0);
+	if (atlas == NULL)
+	{
+		fclose(file);
+		return NULL;
+	}
+
+	char line[ANIMATION_ATLAS_LINE_LENGTH];
+	char path[ANIMATION_ATLAS_LINE_LENGTH];
+	size_t directoryLength = AnimationAtlasGetDirectoryLength(_filename);
+	unsigned int pagesNb = 0;
+	unsigned int regionsNb = 0;
+	sfBool loaded = fgets(line, sizeof(line), file) != NULL
+		&& sscanf(line, "atlas %u %u", &pagesNb, &regionsNb) == 2;
+
+	for (unsigned int i = 0; i < pagesNb && loaded; i++)
+	{
+		sfVector2u size;
+		int nameStart = 0;
+		loaded = fgets(line, sizeof(line), file) != NULL
+			&& sscanf(line, "page %u %u %n", &size.x, &size.y, &nameStart) == 2
+			&& nameStart > 0;
+		AtlasPage* page = loaded ? AnimationAtlasAddPage(atlas) : NULL;
+		if (page == NULL)
+		{
+			loaded = sfFalse;
+			break;
+		}
+		AnimationAtlasTrimLine(line);
+		snprintf(path, sizeof(path), "%.*s%s",
+			(int)directoryLength, _filename, line + nameStart);
+		page->size = size;
+		sfTexture* texture = sfTexture_createFromFile(path, NULL);
+		page->texture = texture != NULL ? TextureCacheAdopt(texture) : NULL;
+		if (page->texture == NULL)
+		{
+			printf("Error during loading of an atlas page !");
+			if (texture != NULL)
+			{
+				sfTexture_destroy(texture);
+			}
+			loaded = sfFalse;
+		}
+	}
+
+	for (unsigned int i = 0; i < regionsNb && loaded; i++)
+	{
+		unsigned int page;
+		sfVector2i position;
+		sfIntRect area;
+		int nameStart = 0;
+		loaded = fgets(line, sizeof(line), file) != NULL
+			&& sscanf(line, "region %u %d %d %d %d %d %d %n",
+				&page, &position.x, &position.y,
+				&area.left, &area.top, &area.width, &area.height,
+				&nameStart) == 7
+			&& nameStart > 0
+			&& page < pagesNb;
+		if (!loaded)
+		{
+			break;
+		}
+		AnimationAtlasTrimLine(line);
+		// Regions are added by hand, adding them would drop the pages
+		if (!AnimationAtlasGrow(
+			(void**)&atlas->regions,
+			sizeof(AtlasRegion),
+			atlas->regionsNb,
+			&atlas->regionsCapacity))
+		{
+			loaded = sfFalse;
+			break;
+		}
+		AtlasRegion* region = &atlas->regions[atlas->regionsNb];
+		region->filename = (char*)malloc(strlen(line + nameStart) + 1);
+		if (region->filename == NULL)
+		{
+			printf("Error during memory allocation !");
+			loaded = sfFalse;
+			break;
+		}
+		strcpy(region->filename, line + nameStart);
+		region->hash = AnimationAtlasHash(region->filename, area);
+		region->area = area;
+		region->page = page;
+		region->position = position;
+		atlas->regionsNb++;
+	}
+	fclose(file);
+
+	if (!loaded)
+	{
+		printf("Error during loading of the atlas !");
+		AnimationAtlasDestroy(atlas);
+		return NULL;
+	}
+	atlas->packed = sfTrue;
+	atlas->built = sfTrue;
+	return atlas;
+}
+
+unsigned int AnimationAtlasGetRegionsNb(const AnimationAtlas* _atlas)
+{
+	return _atlas->regionsNb;
+}
+
+unsigned int AnimationAtlasGetPagesNb(const AnimationAtlas* _atlas)
+{
+	return _atlas->pagesNb;
+}
+
+const sfTexture* AnimationAtlasGetPageTexture(
+	const AnimationAtlas* _atlas,
+	unsigned int _page)
+{
+	return _atlas->pages[_page].texture;
+}
+
+sfBool AnimationAtlasFind(
+	const AnimationAtlas* _atlas,
+	const char* _filename,
+	sfIntRect _area,
+	unsigned int* _page,
+	sfVector2i* _position)
+{
+	int index = AnimationAtlasFindRegion(_atlas, _filename, _area);
+	if (index < 0 || !_atlas->packed)
+	{
+		return sfFalse;
+	}
+	if (_page != NULL)
+	{
+		*_page = _atlas->regions[index].page;
+	}
+	if (_position != NULL)
+	{
+		*_position = _atlas->regions[index].position;
+	}
+	return sfTrue;
+}
+
+sfBool AnimationAtlasBind(
+	const AnimationAtlas* _atlas,
+	Animation* _anim,
+	const char* _filename,
+	const char* _structure,
+	sfVector2u* _animationOffset,
+	sfVector2u* _blockLength)
+{
+	AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	AnimationLayout layout = AnimationLayoutFromString(_structure);
+	sfVector2u animationOffset =
+		_animationOffset != NULL ? *_animationOffset : (sfVector2u) { 0, 0 };
+	sfVector2u blockLength =
+		_blockLength != NULL ? *_blockLength : (sfVector2u) { 0, 0 };
+	sfVector2u frameSize = system->frameSize[i];
+
+	sfIntRect area = AnimationLayoutGetArea(
+		layout, animationOffset, frameSize, system->framesNb[i], blockLength);
+	unsigned int page;
+	sfVector2i position;
+	if (!_atlas->built
+		|| !AnimationAtlasFind(_atlas, _filename, area, &page, &position))
+	{
+		printf("Error : sprite sheet is not in the atlas !");
+		return sfFalse;
+	}
+
+	system->animationOffset[i] = animationOffset;
+	system->blockLength[i] = blockLength;
+	system->layout[i] = (unsigned char)layout;
+
+	// The frames are remapped to the place of the area in the page
+	system->sheetOrigin[i] = position;
+	AnimationSystemBuildFrameTable(system, i);
+
+	AnimationSystemSetSpriteSheet(
+		system, i, TextureCacheRetain(_atlas->pages[page].texture));
+	sfSprite_setTextureRect(
+		system->sprite[i],
+		(sfIntRect) {
+		position.x, position.y, (int)frameSize.x, (int)frameSize.y
+	});
+	return sfTrue;
+}
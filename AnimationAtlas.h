@@ -0,0 +1,210 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "Animation.h"
+
+/// @brief Sprite sheet areas packed into a few large textures
+///
+/// Animations bound to the same atlas page share one texture, so they
+/// can be batched together whatever sprite sheet they come from.
+typedef struct AnimationAtlas AnimationAtlas;
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a new empty atlas
+///
+/// @param _pageSize Maximum width and height of a page, 0 for the
+///					maximum texture size of the GPU
+///
+/// @param _padding Empty pixels kept between two areas
+///
+/// @return Atlas object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+AnimationAtlas* AnimationAtlasCreate(unsigned int _pageSize, unsigned int _padding);
+
+//////////////////////////////////////////////////////////////
+/// @brief Load an atlas written by AnimationAtlasSave
+///
+/// The pages are loaded as they are, nothing is packed again.
+///
+/// @param _filename Path of the atlas description file
+///
+/// @return Built atlas object, or NULL if it cannot be loaded
+//////////////////////////////////////////////////////////////
+AnimationAtlas* AnimationAtlasLoad(const char* _filename);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy an existing atlas
+///
+/// Animations bound to the atlas keep their page textures.
+///
+/// @param _atlas Atlas object
+//////////////////////////////////////////////////////////////
+void AnimationAtlasDestroy(AnimationAtlas* _atlas);
+
+//////////////////////////////////////////////////////////////
+/// @brief Add an area of a file to an atlas
+///
+/// Adding the same file and area twice gives a single region.
+///
+/// @param _atlas Atlas object, not built yet
+///
+/// @param _filename Path of the image file
+///
+/// @param _area Area of the image to pack
+///
+/// @return Index of the region, or -1 if it cannot be added
+//////////////////////////////////////////////////////////////
+int AnimationAtlasAdd(
+	AnimationAtlas* _atlas,
+	const char* _filename,
+	sfIntRect _area);
+
+//////////////////////////////////////////////////////////////
+/// @brief Add the sprite sheet area of an animation to an atlas
+///
+/// The area is the one AnimationSetSpriteSheet would load.
+///
+/// @param _atlas Atlas object, not built yet
+///
+/// @param _filename Path of the sprite sheet file
+///
+/// @param _structure Sprite sheet structure ("horizontal", "vertical" or "block")
+///
+/// @param _frameSize Size of a frame
+///
+/// @param _framesNb Number of frames
+///
+/// @param _animationOffset Offset of the animation, NULL for none
+///
+/// @param _blockLength Block dimension of the sprite sheet, NULL for none
+///
+/// @return Index of the region, or -1 if it cannot be added
+//////////////////////////////////////////////////////////////
+int AnimationAtlasAddSpriteSheet(
+	AnimationAtlas* _atlas,
+	const char* _filename,
+	const char* _structure,
+	sfVector2u _frameSize,
+	unsigned char _framesNb,
+	const sfVector2u* _animationOffset,
+	const sfVector2u* _blockLength);
+
+//////////////////////////////////////////////////////////////
+/// @brief Pack the regions of an atlas into pages
+///
+/// Regions are placed from the tallest to the shortest with a skyline
+/// packer, a new page is opened when a region fits in none.
+/// Only the placements are computed, no image is loaded.
+///
+/// @param _atlas Atlas object
+///
+/// @return sfTrue if every region is placed, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationAtlasPack(AnimationAtlas* _atlas);
+
+//////////////////////////////////////////////////////////////
+/// @brief Pack an atlas if needed and create the page textures
+///
+/// @param _atlas Atlas object
+///
+/// @return sfTrue if the pages are created, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationAtlasBuild(AnimationAtlas* _atlas);
+
+//////////////////////////////////////////////////////////////
+/// @brief Write a built atlas to disk
+///
+/// Writes the description file and one PNG per page, named after the
+/// description file ("hero.atlas" gives "hero_0.png", "hero_1.png"...).
+///
+/// @param _atlas Atlas object
+///
+/// @param _filename Path of the description file
+///
+/// @return sfTrue if everything is written, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationAtlasSave(const AnimationAtlas* _atlas, const char* _filename);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of regions of an atlas
+///
+/// @param _atlas Atlas object
+///
+/// @return Number of regions
+//////////////////////////////////////////////////////////////
+unsigned int AnimationAtlasGetRegionsNb(const AnimationAtlas* _atlas);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of pages of a packed atlas
+///
+/// @param _atlas Atlas object
+///
+/// @return Number of pages
+//////////////////////////////////////////////////////////////
+unsigned int AnimationAtlasGetPagesNb(const AnimationAtlas* _atlas);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the texture of a page of a built atlas
+///
+/// @param _atlas Atlas object
+///
+/// @param _page Index of the page
+///
+/// @return Page texture
+//////////////////////////////////////////////////////////////
+const sfTexture* AnimationAtlasGetPageTexture(
+	const AnimationAtlas* _atlas,
+	unsigned int _page);
+
+//////////////////////////////////////////////////////////////
+/// @brief Find where an area of a file is in an atlas
+///
+/// @param _atlas Atlas object
+///
+/// @param _filename Path of the image file
+///
+/// @param _area Area of the image
+///
+/// @param _page Receives the index of the page, can be NULL
+///
+/// @param _position Receives the corner of the area in the page, can be NULL
+///
+/// @return sfTrue if the area is in the atlas, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationAtlasFind(
+	const AnimationAtlas* _atlas,
+	const char* _filename,
+	sfIntRect _area,
+	unsigned int* _page,
+	sfVector2i* _position);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the sprite sheet of an animation from a built atlas
+///
+/// Takes the same parameters as AnimationSetSpriteSheet, the frames
+/// are remapped to the page holding the sprite sheet area.
+///
+/// @param _atlas Built atlas object
+///
+/// @param _anim Animation object
+///
+/// @param _filename Path of the sprite sheet file
+///
+/// @param _structure Sprite sheet structure ("horizontal", "vertical" or "block")
+///
+/// @param _animationOffset Offset of the animation, NULL for none
+///
+/// @param _blockLength Block dimension of the sprite sheet, NULL for none
+///
+/// @return sfTrue if the area is in the atlas, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationAtlasBind(
+	const AnimationAtlas* _atlas,
+	Animation* _anim,
+	const char* _filename,
+	const char* _structure,
+	sfVector2u* _animationOffset,
+	sfVector2u* _blockLength);
@@ -0,0 +1,268 @@
+#include "AnimationBatch.h"
+#include "AnimationInternal.h"
+#include "AnimationProfiler.h"
+
+#include <SFML/Graphics.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct AnimationBatch
+{
+	sfVertexArray* vertices;
+	const sfTexture* spriteSheet;
+};
+
+AnimationBatch* AnimationBatchCreate(void)
+{
+	AnimationBatch* batch = (AnimationBatch*)malloc(sizeof(AnimationBatch));
+	if (batch == NULL)
+	{
+		printf("Error during memory allocation !");
+		return NULL;
+	}
+	batch->vertices = sfVertexArray_create();
+	if (batch->vertices == NULL)
+	{
+		printf("Error during cration of the vertex array !");
+		free(batch);
+		return NULL;
+	}
+	sfVertexArray_setPrimitiveType(batch->vertices, sfQuads);
+	batch->spriteSheet = NULL;
+	return batch;
+}
+
+void AnimationBatchDestroy(AnimationBatch* _batch)
+{
+	if (_batch == NULL)
+	{
+		return;
+	}
+	sfVertexArray_destroy(_batch->vertices);
+	free(_batch);
+}
+
+// Write the quad of a frame with the same transform as an sfSprite
+static void AnimationBatchWriteQuad(
+	sfVertex* _quad,
+	sfVector2f _position,
+	float _rotation,
+	sfVector2f _scale,
+	sfVector2f _origin,
+	sfIntRect _rect,
+	sfColor _color)
+{
+	float angle = -_rotation * 3.141592654f / 180.f;
+	float cosine = cosf(angle);
+	float sine = sinf(angle);
+	float sxc = _scale.x * cosine;
+	float syc = _scale.y * cosine;
+	float sxs = _scale.x * sine;
+	float sys = _scale.y * sine;
+	float tx = -_origin.x * sxc - _origin.y * sys + _position.x;
+	float ty = _origin.x * sxs - _origin.y * syc + _position.y;
+
+	float width = (float)_rect.width;
+	float height = (float)_rect.height;
+	float left = (float)_rect.left;
+	float top = (float)_rect.top;
+
+	// Corners in the order expected by sfQuads
+	const sfVector2f corners[4] = {
+		{ 0, 0 }, { width, 0 }, { width, height }, { 0, height }
+	};
+	for (int i = 0; i < 4; i++)
+	{
+		_quad[i].position = (sfVector2f){
+			sxc * corners[i].x + sys * corners[i].y + tx,
+			-sxs * corners[i].x + syc * corners[i].y + ty
+		};
+		_quad[i].texCoords = (sfVector2f){
+			left + corners[i].x,
+			top + corners[i].y
+		};
+		_quad[i].color = _color;
+	}
+}
+
+// Write the quad of a frame of a table, trimmed frames are smaller quads
+// around the same middle
+static void AnimationBatchWriteFrame(
+	sfVertex* _quad,
+	const FrameTable* _table,
+	unsigned int _frame,
+	sfVector2u _frameSize,
+	sfVector2f _position,
+	float _rotation,
+	sfVector2f _scale,
+	sfColor _color)
+{
+	sfVector2f origin = { (float)_frameSize.x / 2, (float)_frameSize.y / 2 };
+	sfIntRect rect = _table->rects[_frame];
+	if (_table->trims != NULL)
+	{
+		origin = _table->trimOrigins[_frame];
+		rect = _table->trims[_frame];
+	}
+	AnimationBatchWriteQuad(_quad, _position, _rotation, _scale, origin, rect, _color);
+}
+
+unsigned int AnimationBatchBuild(
+	AnimationBatch* _batch,
+	const AnimationSystem* _system,
+	const sfTexture* _spriteSheet)
+{
+	_batch->spriteSheet = _spriteSheet;
+
+	// Reserve the worst case, then shrink to the quads actually written
+	sfVertexArray_resize(_batch->vertices, (size_t)_system->count * 4);
+	unsigned int quadsNb = 0;
+
+	for (unsigned int i = 0; i < _system->count; i++)
+	{
+		const FrameTable* table = _system->frameTable[i];
+		if (_system->spriteSheet[i] != _spriteSheet || table == NULL
+			|| !AnimationSystemIsVisible(_system, i))
+		{
+			continue;
+		}
+
+		unsigned int frame = AnimationSystemGetFrame(_system, i);
+		if (frame >= table->framesNb)
+		{
+			frame = table->framesNb - 1;
+		}
+
+		sfVector2f scale = _system->scale[i];
+		if (_system->state[i] & FLIP_X)
+		{
+			scale.x = -scale.x;
+		}
+		if (_system->state[i] & FLIP_Y)
+		{
+			scale.y = -scale.y;
+		}
+
+		AnimationBatchWriteFrame(
+			sfVertexArray_getVertex(_batch->vertices, (size_t)quadsNb * 4),
+			table,
+			frame,
+			_system->frameSize[i],
+			_system->position[i],
+			_system->rotation[i],
+			scale,
+			_system->color[i]);
+		quadsNb++;
+	}
+
+	sfVertexArray_resize(_batch->vertices, (size_t)quadsNb * 4);
+	return quadsNb;
+}
+
+unsigned int AnimationBatchBuildInstances(
+	AnimationBatch* _batch,
+	const AnimationInstance* _instances,
+	unsigned int _instancesNb,
+	const sfTexture* _spriteSheet)
+{
+	_batch->spriteSheet = _spriteSheet;
+	sfVertexArray_resize(_batch->vertices, (size_t)_instancesNb * 4);
+	unsigned int quadsNb = 0;
+
+	for (unsigned int i = 0; i < _instancesNb; i++)
+	{
+		const AnimationInstance* instance = &_instances[i];
+		const AnimationClip* clip = instance->clip;
+		if (clip->spriteSheet != _spriteSheet)
+		{
+			continue;
+		}
+		const FrameTable* table = clip->frameTable;
+		unsigned int frame = instance->currentFrame < table->framesNb
+			? instance->currentFrame
+			: table->framesNb - 1;
+
+		sfVector2f scale = instance->scale;
+		if (instance->state & FLIP_X)
+		{
+			scale.x = -scale.x;
+		}
+		if (instance->state & FLIP_Y)
+		{
+			scale.y = -scale.y;
+		}
+		AnimationBatchWriteFrame(
+			sfVertexArray_getVertex(_batch->vertices, (size_t)quadsNb * 4),
+			table,
+			frame,
+			clip->frameSize,
+			instance->position,
+			instance->rotation,
+			scale,
+			instance->color);
+		quadsNb++;
+	}
+
+	sfVertexArray_resize(_batch->vertices, (size_t)quadsNb * 4);
+	return quadsNb;
+}
+
+const sfVertexArray* AnimationBatchGetVertexArray(const AnimationBatch* _batch)
+{
+	return _batch->vertices;
+}
+
+// Render states of a batch, the sprite sheet replaces the given texture
+static sfRenderStates AnimationBatchGetStates(
+	const AnimationBatch* _batch,
+	const sfRenderStates* _states)
+{
+	sfRenderStates states;
+	if (_states != NULL)
+	{
+		states = *_states;
+	}
+	else
+	{
+		states.blendMode = sfBlendAlpha;
+		states.transform = sfTransform_Identity;
+		states.shader = NULL;
+	}
+	states.texture = _batch->spriteSheet;
+	return states;
+}
+
+void AnimationBatchDraw(
+	const sfRenderWindow* _window,
+	const AnimationBatch* _batch,
+	const sfRenderStates* _states)
+{
+	if (sfVertexArray_getVertexCount(_batch->vertices) == 0)
+	{
+		return;
+	}
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_DRAW);
+	sfRenderStates states = AnimationBatchGetStates(_batch, _states);
+	sfRenderWindow_drawVertexArray(
+		(sfRenderWindow*)_window, _batch->vertices, &states);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_DRAW_CALLS, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_DRAW);
+}
+
+void AnimationBatchDrawRenderTex(
+	const sfRenderTexture* _renderTex,
+	const AnimationBatch* _batch,
+	const sfRenderStates* _states)
+{
+	if (sfVertexArray_getVertexCount(_batch->vertices) == 0)
+	{
+		return;
+	}
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_DRAW);
+	sfRenderStates states = AnimationBatchGetStates(_batch, _states);
+	sfRenderTexture_drawVertexArray(
+		(sfRenderTexture*)_renderTex, _batch->vertices, &states);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_DRAW_CALLS, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_DRAW);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "AnimationClip.h"
+#include "AnimationSystem.h"
+
+/// @brief Vertices of all the animations of a system sharing a sprite sheet,
+/// drawn with a single draw call
+typedef struct AnimationBatch AnimationBatch;
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a new animation batch
+///
+/// @return Animation batch object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+AnimationBatch* AnimationBatchCreate(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy an existing animation batch
+///
+/// @param _batch Animation batch object
+//////////////////////////////////////////////////////////////
+void AnimationBatchDestroy(AnimationBatch* _batch);
+
+//////////////////////////////////////////////////////////////
+/// @brief Build the vertices of the animations using a sprite sheet
+///
+/// Each animation gives a quad (4 vertices) with the texture coordinates
+/// of its current frame, its transform, flip state and color baked in.
+/// No CSFML object other than the vertex array is touched, so the
+/// result can be inspected without a render target.
+/// Animations culled by the last AnimationSystemCull are left out.
+///
+/// @param _batch Animation batch object
+///
+/// @param _system Animation system object
+///
+/// @param _spriteSheet Sprite sheet texture shared by the animations
+///
+/// @return Number of quads in the batch
+//////////////////////////////////////////////////////////////
+unsigned int AnimationBatchBuild(
+	AnimationBatch* _batch,
+	const AnimationSystem* _system,
+	const sfTexture* _spriteSheet);
+
+//////////////////////////////////////////////////////////////
+/// @brief Build the vertices of the instances of clips using a sprite sheet
+///
+/// Same quads as AnimationBatchBuild, for instances of any clips reading
+/// the sprite sheet.
+///
+/// @param _batch Animation batch object
+///
+/// @param _instances Animation instances
+///
+/// @param _instancesNb Number of instances
+///
+/// @param _spriteSheet Sprite sheet texture shared by the clips
+///
+/// @return Number of quads in the batch
+//////////////////////////////////////////////////////////////
+unsigned int AnimationBatchBuildInstances(
+	AnimationBatch* _batch,
+	const AnimationInstance* _instances,
+	unsigned int _instancesNb,
+	const sfTexture* _spriteSheet);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the vertices built by AnimationBatchBuild
+///
+/// @param _batch Animation batch object
+///
+/// @return Vertex array of quads
+//////////////////////////////////////////////////////////////
+const sfVertexArray* AnimationBatchGetVertexArray(const AnimationBatch* _batch);
+
+//////////////////////////////////////////////////////////////
+/// @brief Draw an animation batch
+///
+/// @param _window Render window object
+///
+/// @param _batch Animation batch object
+///
+/// @param _states Render states to use, NULL to use the default states.
+///				  The texture is replaced by the sprite sheet of the batch
+//////////////////////////////////////////////////////////////
+void AnimationBatchDraw(
+	const sfRenderWindow* _window,
+	const AnimationBatch* _batch,
+	const sfRenderStates* _states);
+
+//////////////////////////////////////////////////////////////
+/// @brief Draw an animation batch on a render texture
+///
+/// @param _renderTex Render texture object
+///
+/// @param _batch Animation batch object
+///
+/// @param _states Render states to use, NULL to use the default states.
+///				  The texture is replaced by the sprite sheet of the batch
+//////////////////////////////////////////////////////////////
+void AnimationBatchDrawRenderTex(
+	const sfRenderTexture* _renderTex,
+	const AnimationBatch* _batch,
+	const sfRenderStates* _states);
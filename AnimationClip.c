@@ -0,0 +1,314 @@
+#include "AnimationClip.h"
+#include "AnimationInternal.h"
+#include "AnimationProfiler.h"
+#include "AnimationTrim.h"
+#include "TextureCache.h"
+
+#include <SFML/Graphics.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Fails to compile if an instance grows past 48 bytes
+typedef char AnimationInstanceSizeCheck[sizeof(AnimationInstance) <= 48 ? 1 : -1];
+
+// Allocate a clip and its sprite, the sprite sheet is set by the caller
+static AnimationClip* AnimationClipAlloc(void)
+{
+	AnimationClip* clip = (AnimationClip*)calloc(1, sizeof(AnimationClip));
+	if (clip == NULL)
+	{
+		printf("Error during memory allocation !");
+		return NULL;
+	}
+	clip->sprite = sfSprite_create();
+	if (clip->sprite == NULL)
+	{
+		printf("Error during cration of the sprite !");
+		free(clip);
+		return NULL;
+	}
+	return clip;
+}
+
+AnimationClip* AnimationClipCreate(
+	const char* _filename,
+	const char* _structure,
+	sfVector2u _frameSize,
+	unsigned char _framesNb,
+	float _duration,
+	sfVector2u* _animationOffset,
+	sfVector2u* _blockLength)
+{
+	AnimationClip* clip = AnimationClipAlloc();
+	if (clip == NULL)
+	{
+		return NULL;
+	}
+	clip->frameSize = _frameSize;
+	clip->framesNb = _framesNb;
+	clip->duration = _duration;
+	clip->layout = (unsigned char)AnimationLayoutFromString(_structure);
+	clip->animationOffset = _animationOffset != NULL ? *_animationOffset : (sfVector2u){ 0, 0 };
+	clip->blockLength = _blockLength != NULL ? *_blockLength : (sfVector2u){ 0, 0 };
+	clip->sheetOrigin = (sfVector2i){ 0, 0 };
+
+	// The same texture and frames as an animation reading the sprite sheet
+	// the same way
+	sfIntRect area = AnimationLayoutGetArea(
+		(AnimationLayout)clip->layout,
+		clip->animationOffset,
+		_frameSize,
+		_framesNb,
+		clip->blockLength);
+	clip->spriteSheet = TextureCacheAcquire(_filename, &area);
+	if (clip->spriteSheet == NULL)
+	{
+		printf("Error during cration of the sprite sheet texture !");
+		AnimationClipDestroy(clip);
+		return NULL;
+	}
+	const CollisionMask* mask = AnimationIsTrimmingEnabled()
+		? TextureCacheBuildVisibleMask(clip->spriteSheet)
+		: NULL;
+	clip->frameTable = mask != NULL
+		? FrameTableAcquireTrimmed(
+			(AnimationLayout)clip->layout,
+			clip->sheetOrigin,
+			_frameSize,
+			_framesNb,
+			clip->blockLength,
+			clip->spriteSheet,
+			mask)
+		: FrameTableAcquire(
+			(AnimationLayout)clip->layout,
+			clip->sheetOrigin,
+			_frameSize,
+			_framesNb,
+			clip->blockLength);
+	if (clip->frameTable == NULL)
+	{
+		printf("Error during cration of the frame table !");
+		AnimationClipDestroy(clip);
+		return NULL;
+	}
+	sfSprite_setTexture(clip->sprite, clip->spriteSheet, sfFalse);
+	return clip;
+}
+
+AnimationClip* AnimationClipCreateFromAnimation(const Animation* _anim)
+{
+	const AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	if (system->spriteSheet[i] == NULL || system->frameTable[i] == NULL)
+	{
+		printf("Error : the animation has no sprite sheet loaded !");
+		return NULL;
+	}
+	AnimationClip* clip = AnimationClipAlloc();
+	if (clip == NULL)
+	{
+		return NULL;
+	}
+	clip->spriteSheet = TextureCacheRetain(system->spriteSheet[i]);
+	clip->frameTable = FrameTableRetain(system->frameTable[i]);
+	clip->frameSize = system->frameSize[i];
+	clip->framesNb = system->framesNb[i];
+	clip->duration = system->duration[i];
+	clip->layout = system->layout[i];
+	clip->sheetOrigin = system->sheetOrigin[i];
+	clip->animationOffset = system->animationOffset[i];
+	clip->blockLength = system->blockLength[i];
+	sfSprite_setTexture(clip->sprite, clip->spriteSheet, sfFalse);
+	return clip;
+}
+
+void AnimationClipDestroy(AnimationClip* _clip)
+{
+	if (_clip == NULL)
+	{
+		return;
+	}
+	sfSprite_destroy(_clip->sprite);
+	FrameTableRelease(_clip->frameTable);
+	TextureCacheRelease(_clip->spriteSheet);
+	free(_clip);
+}
+
+const sfTexture* AnimationClipGetSpriteSheetTexture(const AnimationClip* _clip)
+{
+	return _clip->spriteSheet;
+}
+
+sfVector2u AnimationClipGetFrameSize(const AnimationClip* _clip)
+{
+	return _clip->frameSize;
+}
+
+unsigned char AnimationClipGetFramesNb(const AnimationClip* _clip)
+{
+	return _clip->framesNb;
+}
+
+float AnimationClipGetDuration(const AnimationClip* _clip)
+{
+	return _clip->duration;
+}
+
+AnimationInstance AnimationClipSpawn(
+	const AnimationClip* _clip,
+	sfVector2f _position,
+	unsigned char _state)
+{
+	AnimationInstance instance;
+	instance.clip = _clip;
+	instance.position = _position;
+	instance.scale = (sfVector2f){ 1, 1 };
+	instance.rotation = 0;
+	instance.color = sfWhite;
+	instance.reserved = 0;
+	AnimationInstancePlay(&instance, _state);
+	return instance;
+}
+
+Animation* AnimationClipCreateAnimation(const AnimationClip* _clip, AnimationSystem* _system)
+{
+	AnimationSystem* system = _system != NULL ? _system : AnimationSystemGetDefault();
+	if (system == NULL)
+	{
+		return NULL;
+	}
+	Animation* anim = AnimationSystemCreateAnimation(system, _clip->frameSize, _clip->framesNb);
+	if (anim == NULL)
+	{
+		return NULL;
+	}
+	unsigned int i = anim->index;
+	system->duration[i] = _clip->duration;
+	system->layout[i] = _clip->layout;
+	system->sheetOrigin[i] = _clip->sheetOrigin;
+	system->animationOffset[i] = _clip->animationOffset;
+	system->blockLength[i] = _clip->blockLength;
+
+	// Shared, nothing is compiled or loaded again
+	system->frameTable[i] = FrameTableRetain(_clip->frameTable);
+	system->variableTimes[i] = _clip->frameTable->times != NULL;
+	AnimationSystemSetSpriteSheet(system, i, TextureCacheRetain(_clip->spriteSheet));
+	AnimationSystemFrameUpdate(system, i);
+	AnimationSystemSchedule(system, i);
+	return anim;
+}
+
+void AnimationInstancePlay(AnimationInstance* _instance, unsigned char _state)
+{
+	_instance->state = (unsigned char)(_state & ~LAZY);
+	_instance->isPlaying = sfTrue;
+	_instance->clock = 0;
+	_instance->currentFrame = 0;
+	if (_instance->state & REVERSED)
+	{
+		_instance->clock = _instance->clip->duration;
+		_instance->currentFrame = _instance->clip->framesNb - 1;
+	}
+}
+
+void AnimationInstanceUpdate(AnimationInstance* _instance, float _dt)
+{
+	if (!_instance->isPlaying)
+	{
+		return;
+	}
+	// Same playback as the animations of a system
+	const AnimationClip* clip = _instance->clip;
+	_instance->isPlaying = AnimationStep(
+		&_instance->clock,
+		&_instance->currentFrame,
+		_instance->state,
+		clip->duration,
+		clip->framesNb,
+		clip->frameTable,
+		_dt);
+}
+
+void AnimationInstanceUpdateAll(
+	AnimationInstance* _instances,
+	unsigned int _instancesNb,
+	float _dt)
+{
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_UPDATE);
+	for (unsigned int i = 0; i < _instancesNb; i++)
+	{
+		AnimationInstanceUpdate(&_instances[i], _dt);
+	}
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_UPDATES, _instancesNb);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_UPDATE);
+}
+
+// Current frame of an instance in the table of its clip
+static unsigned int AnimationInstanceGetTableFrame(const AnimationInstance* _instance)
+{
+	unsigned int framesNb = _instance->clip->frameTable->framesNb;
+	return _instance->currentFrame < framesNb ? _instance->currentFrame : framesNb - 1;
+}
+
+sfIntRect AnimationInstanceGetTextureRect(const AnimationInstance* _instance)
+{
+	const FrameTable* table = _instance->clip->frameTable;
+	unsigned int frame = AnimationInstanceGetTableFrame(_instance);
+	return table->trims != NULL ? table->trims[frame] : table->rects[frame];
+}
+
+// Set the sprite of the clip of an instance to draw it
+static const sfSprite* AnimationInstanceGetSprite(const AnimationInstance* _instance)
+{
+	const AnimationClip* clip = _instance->clip;
+	const FrameTable* table = clip->frameTable;
+	sfVector2f origin = { (float)clip->frameSize.x / 2, (float)clip->frameSize.y / 2 };
+	if (table->trims != NULL)
+	{
+		origin = table->trimOrigins[AnimationInstanceGetTableFrame(_instance)];
+	}
+	sfVector2f scale = _instance->scale;
+	if (_instance->state & FLIP_X)
+	{
+		scale.x = -scale.x;
+	}
+	if (_instance->state & FLIP_Y)
+	{
+		scale.y = -scale.y;
+	}
+	sfSprite_setTextureRect(clip->sprite, AnimationInstanceGetTextureRect(_instance));
+	sfSprite_setOrigin(clip->sprite, origin);
+	sfSprite_setPosition(clip->sprite, _instance->position);
+	sfSprite_setRotation(clip->sprite, _instance->rotation);
+	sfSprite_setScale(clip->sprite, scale);
+	sfSprite_setColor(clip->sprite, _instance->color);
+	return clip->sprite;
+}
+
+void AnimationInstanceDraw(
+	const sfRenderWindow* _window,
+	const AnimationInstance* _instance,
+	const sfRenderStates* _states)
+{
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_DRAW);
+	sfRenderWindow_drawSprite(
+		(sfRenderWindow*)_window,
+		AnimationInstanceGetSprite(_instance),
+		_states);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_DRAW_CALLS, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_DRAW);
+}
+
+void AnimationInstanceDrawRenderTex(
+	const sfRenderTexture* _renderTex,
+	const AnimationInstance* _instance,
+	const sfRenderStates* _states)
+{
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_DRAW);
+	sfRenderTexture_drawSprite(
+		(sfRenderTexture*)_renderTex,
+		AnimationInstanceGetSprite(_instance),
+		_states);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_DRAW_CALLS, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_DRAW);
+}
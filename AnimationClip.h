@@ -0,0 +1,240 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "Animation.h"
+#include "AnimationSystem.h"
+
+// A clip is what the animations reading a sprite sheet the same way have
+// in common : the texture, the compiled frames and their durations, the
+// frame size and the layout. It is created once, never changes and is
+// shared by any number of instances.
+// An instance only holds its playback state and transform, 40 bytes
+// with no sprite, no texture reference and no allocation : spawning one
+// is filling a struct, it can be stored by value in the arrays of the
+// game and copied or dropped freely. The clip must outlive its
+// instances, it owns everything they point to.
+// Instances are advanced like the animations of a system and drawn with
+// the sprite of their clip or batched (see AnimationBatchBuildInstances).
+// The LAZY state is not available to instances.
+
+typedef struct AnimationClip AnimationClip;
+
+/// @brief Playback state and transform of an instance of a clip
+typedef struct AnimationInstance
+{
+	/// Shared definition of the animation
+	const AnimationClip* clip;
+	sfVector2f position;
+	sfVector2f scale;
+	float rotation;
+	float clock;
+	sfColor color;
+	unsigned char currentFrame;
+	/// Combination of the State flags, without LAZY
+	unsigned char state;
+	unsigned char isPlaying;
+	unsigned char reserved;
+} AnimationInstance;
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a clip from a sprite sheet
+///
+/// The texture is shared with the animations loading the same file
+/// and area, the frames are trimmed when trimming is enabled.
+///
+/// @param _filename Path of the sprite sheet image
+///
+/// @param _structure Layout of the sprite sheet, as for
+///					  AnimationSetSpriteSheet
+///
+/// @param _frameSize Size of a frame
+///
+/// @param _framesNb Number of frames
+///
+/// @param _duration Duration of the clip
+///
+/// @param _animationOffset Position of the first frame in the image, NULL
+///							for (0, 0)
+///
+/// @param _blockLength Width and height of the block, in frames, NULL if
+///						the layout is not a block
+///
+/// @return Clip object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+AnimationClip* AnimationClipCreate(
+	const char* _filename,
+	const char* _structure,
+	sfVector2u _frameSize,
+	unsigned char _framesNb,
+	float _duration,
+	sfVector2u* _animationOffset,
+	sfVector2u* _blockLength);
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a clip from the sprite sheet, frames and duration of
+/// an animation
+///
+/// The texture and the frame table, durations included, are shared
+/// with the animation.
+///
+/// @param _anim Animation object with a loaded sprite sheet
+///
+/// @return Clip object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+AnimationClip* AnimationClipCreateFromAnimation(const Animation* _anim);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy a clip
+///
+/// Its instances must not be used any more, the animations created
+/// from it keep their own references.
+///
+/// @param _clip Clip object, NULL is ignored
+//////////////////////////////////////////////////////////////
+void AnimationClipDestroy(AnimationClip* _clip);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the sprite sheet texture of a clip
+///
+/// @param _clip Clip object
+///
+/// @return Sprite sheet texture
+//////////////////////////////////////////////////////////////
+const sfTexture* AnimationClipGetSpriteSheetTexture(const AnimationClip* _clip);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the size of the frames of a clip
+///
+/// @param _clip Clip object
+///
+/// @return Size of a frame
+//////////////////////////////////////////////////////////////
+sfVector2u AnimationClipGetFrameSize(const AnimationClip* _clip);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of frames of a clip
+///
+/// @param _clip Clip object
+///
+/// @return Number of frames
+//////////////////////////////////////////////////////////////
+unsigned char AnimationClipGetFramesNb(const AnimationClip* _clip);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the duration of a clip
+///
+/// @param _clip Clip object
+///
+/// @return Duration of the clip
+//////////////////////////////////////////////////////////////
+float AnimationClipGetDuration(const AnimationClip* _clip);
+
+//////////////////////////////////////////////////////////////
+/// @brief Spawn an instance of a clip playing from its start
+///
+/// Constant time, nothing is allocated.
+///
+/// @param _clip Clip object
+///
+/// @param _position Position of the instance
+///
+/// @param _state State to play the clip with, LAZY is ignored
+///
+/// @return Instance of the clip
+//////////////////////////////////////////////////////////////
+AnimationInstance AnimationClipSpawn(
+	const AnimationClip* _clip,
+	sfVector2f _position,
+	unsigned char _state);
+
+//////////////////////////////////////////////////////////////
+/// @brief Create an animation of a system sharing the sprite sheet and
+/// the frames of a clip
+///
+/// The animation has all the features of the animations of a system and
+/// is destroyed with AnimationDestroy. It keeps its own references, it
+/// can outlive the clip.
+///
+/// @param _clip Clip object
+///
+/// @param _system Animation system object, NULL for the default system
+///
+/// @return Animation object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+Animation* AnimationClipCreateAnimation(const AnimationClip* _clip, AnimationSystem* _system);
+
+//////////////////////////////////////////////////////////////
+/// @brief Play an instance with the given state from the start of its clip
+///
+/// @param _instance Animation instance
+///
+/// @param _state State to play the clip with, LAZY is ignored
+//////////////////////////////////////////////////////////////
+void AnimationInstancePlay(AnimationInstance* _instance, unsigned char _state);
+
+//////////////////////////////////////////////////////////////
+/// @brief Update an instance
+///
+/// @param _instance Animation instance
+///
+/// @param _dt Delta time
+//////////////////////////////////////////////////////////////
+void AnimationInstanceUpdate(AnimationInstance* _instance, float _dt);
+
+//////////////////////////////////////////////////////////////
+/// @brief Update an array of instances
+///
+/// @param _instances Animation instances, of any clips
+///
+/// @param _instancesNb Number of instances
+///
+/// @param _dt Delta time
+//////////////////////////////////////////////////////////////
+void AnimationInstanceUpdateAll(
+	AnimationInstance* _instances,
+	unsigned int _instancesNb,
+	float _dt);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the texture rect of the current frame of an instance
+///
+/// @param _instance Animation instance
+///
+/// @return Texture rect, trimmed if the frames of the clip are
+//////////////////////////////////////////////////////////////
+sfIntRect AnimationInstanceGetTextureRect(const AnimationInstance* _instance);
+
+//////////////////////////////////////////////////////////////
+/// @brief Draw an instance with the sprite of its clip
+///
+/// The sprite of the clip is set to the instance before it is drawn,
+/// instances of a clip are not drawn from several threads. Batching
+/// them draws many at once.
+///
+/// @param _window Render window object
+///
+/// @param _instance Animation instance
+///
+/// @param _states Render states to use, NULL to use the default states
+//////////////////////////////////////////////////////////////
+void AnimationInstanceDraw(
+	const sfRenderWindow* _window,
+	const AnimationInstance* _instance,
+	const sfRenderStates* _states);
+
+//////////////////////////////////////////////////////////////
+/// @brief Draw an instance on a render texture with the sprite of its clip
+///
+/// @param _renderTex Render texture object
+///
+/// @param _instance Animation instance
+///
+/// @param _states Render states to use, NULL to use the default states
+//////////////////////////////////////////////////////////////
+void AnimationInstanceDrawRenderTex(
+	const sfRenderTexture* _renderTex,
+	const AnimationInstance* _instance,
+	const sfRenderStates* _states);
@@ -0,0 +1,295 @@
+#include "AnimationCollision.h"
+#include "AnimationInternal.h"
+#include "CollisionMask.h"
+#include "TextureCache.h"
+
+#include <SFML/Graphics.h>
+#include <math.h>
+
+#define ANIMATION_COLLISION_DEGREES_TO_RADIANS (3.14159265358979323846 / 180.0)
+/// Tolerance of the steps telling that a row maps onto a row
+#define ANIMATION_COLLISION_EPSILON 1e-6
+
+static sfBool collisionMasksEnabled = sfFalse;
+static sfBool collisionBoundsTrimmed = sfFalse;
+
+/// @brief Current frame of an animation in the mask of its sprite sheet
+typedef struct AnimationCollisionFrame
+{
+	const CollisionMask* mask;
+	sfIntRect rect;
+	/// Middle of the untrimmed frame in the rect
+	sfVector2f origin;
+} AnimationCollisionFrame;
+
+/// @brief Affine map from the pixels of a frame to the world
+typedef struct AnimationCollisionAffine
+{
+	double originX, originY;
+	double axisXx, axisXy;
+	double axisYx, axisYy;
+} AnimationCollisionAffine;
+
+void AnimationSetCollisionMasksEnabled(sfBool _enabled)
+{
+	collisionMasksEnabled = _enabled;
+}
+
+sfBool AnimationAreCollisionMasksEnabled(void)
+{
+	return collisionMasksEnabled;
+}
+
+void AnimationSetCollisionBoundsTrimmed(sfBool _trimmed)
+{
+	collisionBoundsTrimmed = _trimmed;
+}
+
+sfBool AnimationAreCollisionBoundsTrimmed(void)
+{
+	return collisionBoundsTrimmed;
+}
+
+sfBool AnimationBuildCollisionMask(Animation* _anim)
+{
+	sfTexture* spriteSheet = _anim->system->spriteSheet[_anim->index];
+	return spriteSheet != NULL && TextureCacheBuildCollisionMask(spriteSheet) != NULL;
+}
+
+static sfBool AnimationCollisionGetFrame(
+	const Animation* _anim,
+	AnimationCollisionFrame* _frame)
+{
+	const AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	const FrameTable* table = system->frameTable[i];
+	if (system->spriteSheet[i] == NULL || table == NULL)
+	{
+		return sfFalse;
+	}
+	_frame->mask = TextureCacheGetCollisionMask(system->spriteSheet[i]);
+	if (_frame->mask == NULL)
+	{
+		return sfFalse;
+	}
+	unsigned int frame = AnimationSystemGetFrame(system, i);
+	frame = frame < table->framesNb ? frame : table->framesNb - 1;
+	// Trimmed frames hold every solid pixel, with less to compare
+	if (table->trims != NULL)
+	{
+		_frame->rect = table->trims[frame];
+		_frame->origin = table->trimOrigins[frame];
+	}
+	else
+	{
+		_frame->rect = table->rects[frame];
+		_frame->origin = (sfVector2f){
+			(float)system->frameSize[i].x / 2, (float)system->frameSize[i].y / 2
+		};
+	}
+	return sfTrue;
+}
+
+// Map of the pixels of the frame of a slot to the world, as its sprite
+static AnimationCollisionAffine AnimationCollisionGetAffine(
+	const AnimationSystem* _system,
+	unsigned int _index,
+	sfVector2f _origin)
+{
+	double angle = _system->rotation[_index] * ANIMATION_COLLISION_DEGREES_TO_RADIANS;
+	double cosine = cos(angle);
+	double sine = sin(angle);
+	double scaleX = _system->state[_index] & FLIP_X
+		? -_system->scale[_index].x : _system->scale[_index].x;
+	double scaleY = _system->state[_index] & FLIP_Y
+		? -_system->scale[_index].y : _system->scale[_index].y;
+	double originX = _origin.x;
+	double originY = _origin.y;
+
+	AnimationCollisionAffine affine;
+	affine.axisXx = cosine * scaleX;
+	affine.axisXy = sine * scaleX;
+	affine.axisYx = -sine * scaleY;
+	affine.axisYy = cosine * scaleY;
+	affine.originX = _system->position[_index].x - affine.axisXx * originX - affine.axisYx * originY;
+	affine.originY = _system->position[_index].y - affine.axisXy * originX - affine.axisYy * originY;
+	return affine;
+}
+
+// Map of the pixels of a first frame to the pixels of a second one
+static sfBool AnimationCollisionGetRelative(
+	const AnimationCollisionAffine* _first,
+	const AnimationCollisionAffine* _second,
+	AnimationCollisionAffine* _relative)
+{
+	double determinant = _second->axisXx * _second->axisYy - _second->axisYx * _second->axisXy;
+	if (fabs(determinant) < ANIMATION_COLLISION_EPSILON)
+	{
+		// A flattened animation has no pixel to hit
+		return sfFalse;
+	}
+	double inverseXx = _second->axisYy / determinant;
+	double inverseXy = -_second->axisXy / determinant;
+	double inverseYx = -_second->axisYx / determinant;
+	double inverseYy = _second->axisXx / determinant;
+
+	double x = _first->originX - _second->originX;
+	double y = _first->originY - _second->originY;
+	_relative->originX = inverseXx * x + inverseYx * y;
+	_relative->originY = inverseXy * x + inverseYy * y;
+	_relative->axisXx = inverseXx * _first->axisXx + inverseYx * _first->axisXy;
+	_relative->axisXy = inverseXy * _first->axisXx + inverseYy * _first->axisXy;
+	_relative->axisYx = inverseXx * _first->axisYx + inverseYx * _first->axisYy;
+	_relative->axisYy = inverseXy * _first->axisYx + inverseYy * _first->axisYy;
+	return sfTrue;
+}
+
+// Bits from the first to the last one excluded, clamped to a word
+static unsigned long long AnimationCollisionGetRange(long long _first, long long _last)
+{
+	_first = _first > 0 ? _first : 0;
+	_last = _last < 64 ? _last : 64;
+	if (_last <= _first)
+	{
+		return 0;
+	}
+	unsigned long long range = _last - _first == 64 ? ~0ull : (1ull << (_last - _first)) - 1;
+	return range << _first;
+}
+
+static unsigned long long AnimationCollisionReverse(unsigned long long _bits)
+{
+	_bits = (_bits >> 1 & 0x5555555555555555ull) | (_bits & 0x5555555555555555ull) << 1;
+	_bits = (_bits >> 2 & 0x3333333333333333ull) | (_bits & 0x3333333333333333ull) << 2;
+	_bits = (_bits >> 4 & 0x0F0F0F0F0F0F0F0Full) | (_bits & 0x0F0F0F0F0F0F0F0Full) << 4;
+	_bits = (_bits >> 8 & 0x00FF00FF00FF00FFull) | (_bits & 0x00FF00FF00FF00FFull) << 8;
+	_bits = (_bits >> 16 & 0x0000FFFF0000FFFFull) | (_bits & 0x0000FFFF0000FFFFull) << 16;
+	return _bits >> 32 | _bits << 32;
+}
+
+// Pixels of the second frame under 64 pixels of a row of the first one,
+// when the row maps onto a row of the second frame
+static unsigned long long AnimationCollisionGetRowBits(
+	const AnimationCollisionFrame* _second,
+	double _x,
+	double _y,
+	sfBool _mirrored)
+{
+	long long row = (long long)floor(_y);
+	if (row < 0 || row >= _second->rect.height)
+	{
+		return 0;
+	}
+	long long column = (long long)floor(_x);
+	int top = _second->rect.top + (int)row;
+	if (!_mirrored)
+	{
+		return CollisionMaskGetBits(_second->mask, _second->rect.left + (int)column, top)
+			& AnimationCollisionGetRange(-column, _second->rect.width - column);
+	}
+
+	// Pixel k is the column - k, read the 64 columns ending there backward
+	unsigned long long bits = AnimationCollisionReverse(
+		CollisionMaskGetBits(_second->mask, _second->rect.left + (int)column - 63, top));
+	return bits & AnimationCollisionGetRange(column - _second->rect.width + 1, column + 1);
+}
+
+// Tell if a solid pixel of a word of the first frame hits the second one,
+// sampling its pixels one by one
+static sfBool AnimationCollisionSampleBits(
+	const AnimationCollisionFrame* _second,
+	const AnimationCollisionAffine* _relative,
+	unsigned long long _bits,
+	double _x,
+	double _y)
+{
+	for (unsigned int k = 0; _bits != 0; k++, _bits >>= 1)
+	{
+		if (!(_bits & 1))
+		{
+			continue;
+		}
+		double x = floor(_x + _relative->axisXx * k);
+		double y = floor(_y + _relative->axisXy * k);
+		if (x >= 0 && y >= 0 && x < _second->rect.width && y < _second->rect.height
+			&& CollisionMaskGetPixel(_second->mask,
+				_second->rect.left + (int)x, _second->rect.top + (int)y))
+		{
+			return sfTrue;
+		}
+	}
+	return sfFalse;
+}
+
+sfBool AnimationCollides(const Animation* _first, const Animation* _second)
+{
+	sfFloatRect firstBounds;
+	sfFloatRect secondBounds;
+	if (collisionBoundsTrimmed)
+	{
+		firstBounds = AnimationSystemGetTrimmedBounds(_first->system, _first->index);
+		secondBounds = AnimationSystemGetTrimmedBounds(_second->system, _second->index);
+	}
+	else
+	{
+		firstBounds = AnimationSystemGetBounds(_first->system, _first->index);
+		secondBounds = AnimationSystemGetBounds(_second->system, _second->index);
+	}
+	if (!sfFloatRect_intersects(&firstBounds, &secondBounds, NULL))
+	{
+		return sfFalse;
+	}
+	AnimationCollisionFrame first;
+	AnimationCollisionFrame second;
+	if (!AnimationCollisionGetFrame(_first, &first)
+		|| !AnimationCollisionGetFrame(_second, &second))
+	{
+		return sfTrue;
+	}
+
+	AnimationCollisionAffine firstAffine =
+		AnimationCollisionGetAffine(_first->system, _first->index, first.origin);
+	AnimationCollisionAffine secondAffine =
+		AnimationCollisionGetAffine(_second->system, _second->index, second.origin);
+	AnimationCollisionAffine relative;
+	if (!AnimationCollisionGetRelative(&firstAffine, &secondAffine, &relative))
+	{
+		return sfFalse;
+	}
+
+	// Moved or flipped frames map the rows of the first onto the rows of
+	// the second, the pixels of a word are then side by side
+	sfBool rowToRow = fabs(relative.axisXy) < ANIMATION_COLLISION_EPSILON
+		&& fabs(fabs(relative.axisXx) - 1) < ANIMATION_COLLISION_EPSILON;
+	sfBool mirrored = relative.axisXx < 0;
+
+	for (int v = 0; v < first.rect.height; v++)
+	{
+		for (int u = 0; u < first.rect.width; u += 64)
+		{
+			unsigned long long bits =
+				CollisionMaskGetBits(first.mask, first.rect.left + u, first.rect.top + v)
+				& AnimationCollisionGetRange(0, first.rect.width - u);
+			if (bits == 0)
+			{
+				continue;
+			}
+
+			// Middle of the first pixel of the word in the second frame
+			double x = relative.originX + relative.axisXx * (u + 0.5) + relative.axisYx * (v + 0.5);
+			double y = relative.originY + relative.axisXy * (u + 0.5) + relative.axisYy * (v + 0.5);
+			if (rowToRow)
+			{
+				if (bits & AnimationCollisionGetRowBits(&second, x, y, mirrored))
+				{
+					return sfTrue;
+				}
+			}
+			else if (AnimationCollisionSampleBits(&second, &relative, bits, x, y))
+			{
+				return sfTrue;
+			}
+		}
+	}
+	return sfFalse;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "Animation.h"
+
+//////////////////////////////////////////////////////////////
+/// @brief Build the collision masks of the sprite sheets when they
+/// are loaded
+///
+/// The mask of a sprite sheet is a 1-bit copy of its alpha shared by
+/// every animation using it (see CollisionMask.h). Off by default.
+///
+/// @param _enabled sfTrue to build the masks of the sprite sheets set
+///					from now on, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+void AnimationSetCollisionMasksEnabled(sfBool _enabled);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if the collision masks are built with the sprite sheets
+///
+/// @return sfTrue if the masks are built, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationAreCollisionMasksEnabled(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Compare the bounds of the trimmed frames instead of the whole
+/// frames (see AnimationTrim.h)
+///
+/// The bounds reject the animations far from each other before their
+/// pixels are compared, and are compared alone without collision masks,
+/// where trimmed bounds leave out the transparent padding. Off by default.
+///
+/// @param _trimmed sfTrue to compare the trimmed bounds, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+void AnimationSetCollisionBoundsTrimmed(sfBool _trimmed);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if the bounds of the trimmed frames are compared
+///
+/// @return sfTrue if the trimmed bounds are compared, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationAreCollisionBoundsTrimmed(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Build the collision mask of the sprite sheet of an animation
+///
+/// For sprite sheets set while the masks were disabled.
+///
+/// @param _anim Animation object
+///
+/// @return sfTrue if the sprite sheet has a mask, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationBuildCollisionMask(Animation* _anim);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if the solid pixels of two animations overlap
+///
+/// The current frames are compared with the transforms and flip states
+/// of the animations applied. When the frames are only moved or flipped
+/// relative to each other, rows are compared 64 pixels at a time, other
+/// transforms sample the pixels of the second animation one by one.
+/// Without collision masks, the global bounds are compared.
+///
+/// @param _first First animation object
+///
+/// @param _second Second animation object
+///
+/// @return sfTrue if the animations overlap, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationCollides(const Animation* _first, const Animation* _second);
@@ -0,0 +1,107 @@
+#include "AnimationHandle.h"
+#include "AnimationInternal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/// Animations of a slab, a power of two
+#define ANIMATION_HANDLE_SLAB_SIZE 256u
+#define ANIMATION_HANDLE_SLAB_SHIFT 8u
+/// Link of the last free animation
+#define ANIMATION_HANDLE_NO_SLOT 0xFFFFFFFFu
+
+/// Slabs of animations, never freed so that every slot keeps its generation
+static Animation** slabs = NULL;
+static unsigned int slabsNb = 0;
+static unsigned int slabsCapacity = 0;
+/// First free slot, the free slots are linked through their index
+static unsigned int freeSlot = ANIMATION_HANDLE_NO_SLOT;
+
+static Animation* AnimationHandleGetSlot(unsigned int _slot)
+{
+	return &slabs[_slot >> ANIMATION_HANDLE_SLAB_SHIFT][_slot & (ANIMATION_HANDLE_SLAB_SIZE - 1)];
+}
+
+// Add a slab of free animations
+static sfBool AnimationHandleGrow(void)
+{
+	if (slabsNb == slabsCapacity)
+	{
+		unsigned int capacity = slabsCapacity > 0 ? slabsCapacity * 2 : 16;
+		Animation** grown = (Animation**)realloc(slabs, sizeof(Animation*) * capacity);
+		if (grown == NULL)
+		{
+			printf("Error during memory allocation !");
+			return sfFalse;
+		}
+		slabs = grown;
+		slabsCapacity = capacity;
+	}
+	Animation* slab = (Animation*)malloc(sizeof(Animation) * ANIMATION_HANDLE_SLAB_SIZE);
+	if (slab == NULL)
+	{
+		printf("Error during memory allocation !");
+		return sfFalse;
+	}
+	slabs[slabsNb] = slab;
+
+	// Linked in order so that the first slots are used first
+	unsigned int first = slabsNb << ANIMATION_HANDLE_SLAB_SHIFT;
+	for (unsigned int i = ANIMATION_HANDLE_SLAB_SIZE; i-- > 0;)
+	{
+		slab[i].system = NULL;
+		slab[i].index = freeSlot;
+		slab[i].slot = first + i;
+		slab[i].generation = 1;
+		freeSlot = first + i;
+	}
+	slabsNb++;
+	return sfTrue;
+}
+
+Animation* AnimationHandleAlloc(void)
+{
+	if (freeSlot == ANIMATION_HANDLE_NO_SLOT && !AnimationHandleGrow())
+	{
+		return NULL;
+	}
+	Animation* anim = AnimationHandleGetSlot(freeSlot);
+	freeSlot = anim->index;
+	return anim;
+}
+
+void AnimationHandleFree(Animation* _anim)
+{
+	// Handles on the old animation become stale
+	if (++_anim->generation == 0)
+	{
+		_anim->generation = 1;
+	}
+	_anim->system = NULL;
+	_anim->index = freeSlot;
+	freeSlot = _anim->slot;
+}
+
+AnimationHandle AnimationGetHandle(const Animation* _anim)
+{
+	return (AnimationHandle) { _anim->slot, _anim->generation };
+}
+
+Animation* AnimationHandleGet(AnimationHandle _handle)
+{
+	if ((_handle.slot >> ANIMATION_HANDLE_SLAB_SHIFT) >= slabsNb)
+	{
+		return NULL;
+	}
+	Animation* anim = AnimationHandleGetSlot(_handle.slot);
+	if (anim->generation != _handle.generation || anim->system == NULL)
+	{
+		return NULL;
+	}
+	return anim;
+}
+
+sfBool AnimationHandleIsValid(AnimationHandle _handle)
+{
+	return AnimationHandleGet(_handle) != NULL;
+}
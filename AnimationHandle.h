@@ -0,0 +1,47 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Config.h>
+#include "Animation.h"
+
+/// @brief Generational reference to an animation
+///
+/// Animation objects live in slabs that are reused once the animation
+/// is destroyed. A handle remembers the generation of the animation it
+/// was taken from, so a handle kept after the animation is destroyed
+/// is detected instead of reaching the animation reusing its slot.
+/// The zero handle is never valid.
+typedef struct AnimationHandle
+{
+	unsigned int slot;
+	unsigned int generation;
+} AnimationHandle;
+
+//////////////////////////////////////////////////////////////
+/// @brief Get a generational handle on an animation
+///
+/// @param _anim Animation object
+///
+/// @return Handle valid until the animation is destroyed
+//////////////////////////////////////////////////////////////
+AnimationHandle AnimationGetHandle(const Animation* _anim);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the animation of a generational handle
+///
+/// @param _handle Handle returned by AnimationGetHandle
+///
+/// @return Animation object, NULL if it was destroyed
+//////////////////////////////////////////////////////////////
+Animation* AnimationHandleGet(AnimationHandle _handle);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if the animation of a generational handle is alive
+///
+/// @param _handle Handle returned by AnimationGetHandle
+///
+/// @return sfTrue if the animation is alive, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationHandleIsValid(AnimationHandle _handle);
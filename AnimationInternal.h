@@ -0,0 +1,690 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include <math.h>
+#include "Animation.h"
+#include "AnimationClip.h"
+#include "AnimationSystem.h"
+#include "FrameTable.h"
+#include "SpatialGrid.h"
+#include "SpriteSheetLoader.h"
+#include "TimingWheel.h"
+
+/// @brief Handle given to the users of the Animation API
+///
+/// The data of an animation lives in its system, the handle only
+/// knows where to find it. Handles are allocated in slabs, see
+/// AnimationHandle.h.
+struct Animation
+{
+	/// NULL when the handle is free
+	AnimationSystem* system;
+	/// Slot in the system, next free handle when the handle is free
+	unsigned int index;
+	/// Place of the handle in the slabs
+	unsigned int slot;
+	/// Incremented each time the handle is freed
+	unsigned int generation;
+};
+
+/// @brief Compiled frames of a sprite sheet
+struct FrameTable
+{
+	unsigned int refCount;
+	unsigned int framesNb;
+	/// Texture rect of each frame
+	sfIntRect* rects;
+	/// Start of each frame relative to the clip (framesNb + 1 values),
+	/// NULL when all the frames have the same duration
+	float* times;
+	/// Texture rect of the visible pixels of each frame, NULL when the
+	/// frames are not trimmed
+	sfIntRect* trims;
+	/// Middle of each untrimmed frame in its trimmed rect, the origin of
+	/// the sprite drawing it
+	sfVector2f* trimOrigins;
+	/// Texture the frames are trimmed to
+	const sfTexture* trimTexture;
+};
+
+/// @brief Shared definition of the instances of an animation
+struct AnimationClip
+{
+	/// Reference of the texture cache
+	sfTexture* spriteSheet;
+	FrameTable* frameTable;
+	/// Sprite the instances are drawn with
+	sfSprite* sprite;
+	sfVector2u frameSize;
+	float duration;
+	unsigned char framesNb;
+	unsigned char layout;
+	/// Corner of the sprite sheet area in the texture
+	sfVector2i sheetOrigin;
+	sfVector2u animationOffset;
+	sfVector2u blockLength;
+};
+
+/// @brief Structure-of-arrays storage of the animations
+///
+/// Every array has "capacity" elements, the "count" first ones are alive.
+/// Hot playback data comes first, then the transform and the cold data.
+struct AnimationSystem
+{
+	unsigned int count;
+	unsigned int capacity;
+
+	// Playback
+	float* clock;
+	float* duration;
+	unsigned char* framesNb;
+	unsigned char* currentFrame;
+	unsigned char* state;
+	unsigned char* isPlaying;
+	unsigned char* frameDirty;
+	/// Texture rect of the current frame, valid when the frame is dirty
+	sfIntRect* frameRect;
+	/// Non zero when the frame table has per-frame durations
+	unsigned char* variableTimes;
+	/// Event time the clock is up to date at, in event-driven mode
+	double* clockStamp;
+	/// Time of the global clock the clip of a lazy slot started at
+	double* startTime;
+	/// Clock and duration in ticks, in tick mode
+	unsigned int* ticks;
+	unsigned int* durationTicks;
+	/// Tick at which the frame of a playing slot changes in its direction,
+	/// in tick mode
+	unsigned int* frameChangeTick;
+	/// Fraction of a tick left by the last float update of the slot alone,
+	/// in tick mode
+	double* tickFraction;
+	/// Level of detail, the slot is advanced once every 2^tier updates
+	unsigned char* lodTier;
+	/// Updates of the slot, to find the ones it is advanced at
+	unsigned char* lodPhase;
+	/// Time of the updates skipped since the slot was last advanced
+	float* lodTime;
+	/// Cull stamp of the last cull that saw the slot, the slot is visible
+	/// when it is the one of the system
+	unsigned int* visibleStamp;
+
+	// Transform
+	sfVector2f* position;
+	float* rotation;
+	sfVector2f* scale;
+	sfColor* color;
+
+	// Sprite sheet
+	sfSprite** sprite;
+	sfTexture** spriteSheet;
+	/// Sprite sheet being loaded in the background, NULL when none
+	SpriteSheetRequest** pendingSheet;
+	FrameTable** frameTable;
+	sfVector2u* frameSize;
+	/// Corner of the sprite sheet area in the texture, not zero in an atlas
+	sfVector2i* sheetOrigin;
+	unsigned char* layout;
+	sfVector2u* animationOffset;
+	sfVector2u* blockLength;
+
+	// Handle owning each slot
+	Animation** handles;
+
+	/// Sprites of the removed slots, given to the next slots added
+	sfSprite** spareSprites;
+	unsigned int spareSpritesNb;
+	unsigned int spareSpritesCapacity;
+
+	// Event-driven update
+	/// Next frame change of the playing slots, NULL when every slot is
+	/// advanced at each update
+	TimingWheel* wheel;
+	/// Time elapsed since the event-driven mode is enabled
+	double eventTime;
+
+	// Tick mode
+	/// Ticks per second, 0 when the clocks are floats
+	unsigned int tickRate;
+	/// Fraction of a tick left by the last float update
+	double tickRemainder;
+
+	// Culling
+	/// Global bounds of the slots, NULL when every slot is visible
+	SpatialGrid* grid;
+	/// Incremented by each cull
+	unsigned int cullStamp;
+
+	/// Slots below the full update rate
+	unsigned int lodSlotsNb;
+};
+
+//////////////////////////////////////////////////////////////
+/// @brief Find the frame of a clip at a clock
+///
+/// @param _clock Time elapsed in the clip
+///
+/// @param _duration Duration of the clip
+///
+/// @param _framesNb Number of frames of the clip
+///
+/// @param _table Frame table of the clip, NULL for uniform timings
+///
+/// @param _hint Frame played before
+///
+/// @return Frame index, below 0 or above the last frame when the clock
+///		   is outside of the clip
+//////////////////////////////////////////////////////////////
+static inline int AnimationFindFrame(
+	float _clock,
+	float _duration,
+	unsigned char _framesNb,
+	const FrameTable* _table,
+	unsigned char _hint)
+{
+	double progression = (double)_clock / (double)_duration;
+	if (_table != NULL && _table->times != NULL)
+	{
+		return FrameTableFind(_table, progression, _hint);
+	}
+	return (int)floor(progression * (double)_framesNb);
+}
+
+//////////////////////////////////////////////////////////////
+/// @brief Advance the clock of a playing clip and find its frame
+///
+/// The playback of the animations of a system, of the instances of a
+/// clip and of the sync groups: at the end of the clip, a LOOPED clip
+/// starts over and the others stop on their last frame.
+///
+/// @param _clock Time elapsed in the clip, advanced
+///
+/// @param _currentFrame Frame of the clip, updated
+///
+/// @param _state Combination of LOOPED and REVERSED
+///
+/// @param _duration Duration of the clip
+///
+/// @param _framesNb Number of frames of the clip
+///
+/// @param _table Frame table of the clip, NULL for uniform timings
+///
+/// @param _dt Delta time
+///
+/// @return sfFalse if the clip stopped at its end, sfTrue otherwise
+//////////////////////////////////////////////////////////////
+static inline sfBool AnimationStep(
+	float* _clock,
+	unsigned char* _currentFrame,
+	unsigned char _state,
+	float _duration,
+	unsigned char _framesNb,
+	const FrameTable* _table,
+	float _dt)
+{
+	if (_state & REVERSED)
+	{
+		// Play animation in reverse
+		*_clock -= _dt;
+
+		int nextFrame = AnimationFindFrame(*_clock, _duration, _framesNb, _table, *_currentFrame);
+
+		// If animation has played his last frame
+		if (*_clock < 0 && nextFrame < 0)
+		{
+			if (_state & LOOPED)
+			{
+				*_clock = _duration;
+				*_currentFrame = _framesNb - 1;
+				return sfTrue;
+			}
+			*_currentFrame = 0;
+			return sfFalse;
+		}
+		// Update the animation frame
+		*_currentFrame = (unsigned char)nextFrame;
+		return sfTrue;
+	}
+
+	// Play animation
+	*_clock += _dt;
+
+	int nextFrame = AnimationFindFrame(*_clock, _duration, _framesNb, _table, *_currentFrame);
+
+	// If animation has played his last frame
+	if (*_clock > _duration && nextFrame > _framesNb - 1)
+	{
+		if (_state & LOOPED)
+		{
+			*_clock = 0;
+			*_currentFrame = 0;
+			return sfTrue;
+		}
+		*_currentFrame = _framesNb - 1;
+		return sfFalse;
+	}
+	// Update the animation frame
+	*_currentFrame = (unsigned char)nextFrame;
+	return sfTrue;
+}
+
+//////////////////////////////////////////////////////////////
+/// @brief Take a free handle from the slabs
+///
+/// @return Animation handle to fill, NULL if it cannot be allocated
+//////////////////////////////////////////////////////////////
+Animation* AnimationHandleAlloc(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Give a handle back to the slabs
+///
+/// @param _anim Animation handle, its generation handles become stale
+//////////////////////////////////////////////////////////////
+void AnimationHandleFree(Animation* _anim);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get a sprite for a new slot, reusing a removed one if any
+///
+/// The sprite has the default transform, color and an empty texture
+/// rect. A reused sprite may still point to an old texture, it must
+/// not be drawn before a sprite sheet is set.
+///
+/// @param _system Animation system object
+///
+/// @return Sprite object, NULL if it cannot be created
+//////////////////////////////////////////////////////////////
+sfSprite* AnimationSystemTakeSprite(AnimationSystem* _system);
+
+//////////////////////////////////////////////////////////////
+/// @brief Keep the sprite of a removed slot for the next slots
+///
+/// @param _system Animation system object
+///
+/// @param _sprite Sprite object, destroyed if it cannot be kept
+//////////////////////////////////////////////////////////////
+void AnimationSystemGiveSprite(AnimationSystem* _system, sfSprite* _sprite);
+
+//////////////////////////////////////////////////////////////
+/// @brief Free the default animation system if it is the given one
+/// and it has no animation left
+///
+/// @param _system Animation system object
+//////////////////////////////////////////////////////////////
+void AnimationSystemReleaseDefault(AnimationSystem* _system);
+
+//////////////////////////////////////////////////////////////
+/// @brief Add a slot with default values to an animation system
+///
+/// @param _system Animation system object
+///
+/// @param _handle Handle owning the new slot
+///
+/// @param _frameSize Size of a frame
+///
+/// @param _framesNb Number of frames
+///
+/// @return sfTrue if the slot is added, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationSystemAdd(
+	AnimationSystem* _system,
+	Animation* _handle,
+	sfVector2u _frameSize,
+	unsigned char _framesNb);
+
+//////////////////////////////////////////////////////////////
+/// @brief Add a slot copying the values of another slot
+///
+/// The sprite and the texture are not copied, the frame table is shared.
+///
+/// @param _system Animation system object
+///
+/// @param _handle Handle owning the new slot
+///
+/// @param _source Index of the slot to copy
+///
+/// @return sfTrue if the slot is added, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationSystemDuplicate(
+	AnimationSystem* _system,
+	Animation* _handle,
+	unsigned int _source);
+
+//////////////////////////////////////////////////////////////
+/// @brief Remove a slot from an animation system
+///
+/// The last slot is moved into the hole and its handle is updated.
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot to remove
+//////////////////////////////////////////////////////////////
+void AnimationSystemRemove(AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Advance the clocks and frames of a range of slots
+///
+/// Only touches the playback arrays, no CSFML call is made.
+///
+/// @param _system Animation system object
+///
+/// @param _begin First slot of the range
+///
+/// @param _end Slot after the last one of the range
+///
+/// @param _dt Delta time
+//////////////////////////////////////////////////////////////
+void AnimationSystemAdvance(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end,
+	float _dt);
+
+//////////////////////////////////////////////////////////////
+/// @brief Compute the texture rects of the dirty frames of a range of slots
+///
+/// Only touches the system arrays, no CSFML call is made.
+///
+/// @param _system Animation system object
+///
+/// @param _begin First slot of the range
+///
+/// @param _end Slot after the last one of the range
+//////////////////////////////////////////////////////////////
+void AnimationSystemComputeRects(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end);
+
+//////////////////////////////////////////////////////////////
+/// @brief Apply the flip state and the computed frame rects of a range
+/// of slots to their sprites
+///
+/// @param _system Animation system object
+///
+/// @param _begin First slot of the range
+///
+/// @param _end Slot after the last one of the range
+//////////////////////////////////////////////////////////////
+void AnimationSystemApply(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end);
+
+//////////////////////////////////////////////////////////////
+/// @brief Count an update of a slot in its level of detail
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot, playing
+///
+/// @param _dt Delta time of the update, set to the time to advance the
+///			   slot by when it is advanced
+///
+/// @return sfTrue if the slot is advanced at this update, sfFalse if
+///		 the time is kept for a later one
+//////////////////////////////////////////////////////////////
+sfBool AnimationSystemStepLod(AnimationSystem* _system, unsigned int _index, float* _dt);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the level of detail of a slot
+///
+/// The time skipped by the slot is caught up first.
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+///
+/// @param _tier Slot advanced once every 2^tier updates, up to 3
+//////////////////////////////////////////////////////////////
+void AnimationSystemSetLodTier(AnimationSystem* _system, unsigned int _index, unsigned char _tier);
+
+//////////////////////////////////////////////////////////////
+/// @brief Advance the tick clocks and frames of a range of slots
+///
+/// Only touches the playback arrays, no CSFML call is made. Frames are
+/// only marked dirty when they change.
+///
+/// @param _system Animation system object, in tick mode
+///
+/// @param _begin First slot of the range
+///
+/// @param _end Slot after the last one of the range
+///
+/// @param _ticks Ticks elapsed
+//////////////////////////////////////////////////////////////
+void AnimationSystemAdvanceTicks(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end,
+	unsigned int _ticks);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the tick clock of a slot and its frame right away
+///
+/// @param _system Animation system object, in tick mode
+///
+/// @param _index Index of the slot
+///
+/// @param _ticks Clock in ticks, clamped to the duration
+//////////////////////////////////////////////////////////////
+void AnimationSystemSetTicks(AnimationSystem* _system, unsigned int _index, unsigned int _ticks);
+
+//////////////////////////////////////////////////////////////
+/// @brief Bring the clock and the sprite of a slot up to the event time
+///
+/// In tick mode, the float clock is set from the tick clock. The time
+/// skipped by a slot below the full update rate is caught up. Does
+/// nothing otherwise unless the system is event-driven.
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+//////////////////////////////////////////////////////////////
+void AnimationSystemSync(AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Schedule the next frame change of a slot
+///
+/// Must be called after the playback of the slot is changed, with its
+/// clock up to date. In tick mode, the tick clock is set from the float
+/// clock. Does nothing otherwise unless the system is event-driven.
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+//////////////////////////////////////////////////////////////
+void AnimationSystemSchedule(AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Change the state of a slot
+///
+/// A slot leaving the LAZY state keeps the clock and the frame it was
+/// at, a slot entering it plays from its clock.
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+///
+/// @param _state New state
+//////////////////////////////////////////////////////////////
+void AnimationSystemSetState(
+	AnimationSystem* _system,
+	unsigned int _index,
+	unsigned char _state);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the clock of a slot, lazy or not
+///
+/// The time skipped by a lower level of detail is dropped.
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+///
+/// @param _clock New clock
+//////////////////////////////////////////////////////////////
+void AnimationSystemSetClock(AnimationSystem* _system, unsigned int _index, float _clock);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the frame of a slot, lazy slots are moved to its start
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+///
+/// @param _frame New frame
+//////////////////////////////////////////////////////////////
+void AnimationSystemSetFrame(AnimationSystem* _system, unsigned int _index, unsigned char _frame);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the clock of a slot at the global clock
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of a lazy slot
+///
+/// @param _playing Set to sfFalse when a clip not looped is over,
+///				   can be NULL
+///
+/// @return Clock of the slot
+//////////////////////////////////////////////////////////////
+float AnimationSystemGetLazyClock(
+	const AnimationSystem* _system,
+	unsigned int _index,
+	sfBool* _playing);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the frame played by a slot, lazy or not
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+///
+/// @return Frame index
+//////////////////////////////////////////////////////////////
+unsigned int AnimationSystemGetFrame(const AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the texture rect of a lazy slot to the frame at the
+/// global clock, before it is drawn or read
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot, ignored if it is not lazy
+//////////////////////////////////////////////////////////////
+void AnimationSystemShowFrame(AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Replace the sprite sheet texture of a slot
+///
+/// The previous texture and the pending request are released.
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+///
+/// @param _texture Texture with a reference for the slot, can be NULL
+//////////////////////////////////////////////////////////////
+void AnimationSystemSetSpriteSheet(
+	AnimationSystem* _system,
+	unsigned int _index,
+	sfTexture* _texture);
+
+//////////////////////////////////////////////////////////////
+/// @brief Take the texture of the pending sprite sheet of a slot
+/// once it is loaded
+///
+/// Only reads the state of the request, SpriteSheetLoaderUpload must be
+/// called before to upload the sprite sheets decoded since.
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot, with a pending sprite sheet
+//////////////////////////////////////////////////////////////
+void AnimationSystemResolveSpriteSheet(AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the flipped scale of a slot on its sprite
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+//////////////////////////////////////////////////////////////
+void AnimationSystemSetFlipState(AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Compile the frame table of a slot from its layout
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+//////////////////////////////////////////////////////////////
+void AnimationSystemBuildFrameTable(AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Trim the frames of a slot to the visible pixels of its sprite
+/// sheet
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+//////////////////////////////////////////////////////////////
+void AnimationSystemTrimFrames(AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the texture rect of the current frame of a slot
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+//////////////////////////////////////////////////////////////
+void AnimationSystemFrameUpdate(AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if a slot was seen by the last cull
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+///
+/// @return sfTrue if the slot is visible or culling is off, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationSystemIsVisible(const AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Compute the global bounds of a slot from its transform
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+///
+/// @return Bounds of the frame of the slot, in world coordinates
+//////////////////////////////////////////////////////////////
+sfFloatRect AnimationSystemGetBounds(const AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Compute the global bounds of the trimmed current frame of a slot
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+///
+/// @return Bounds of the visible pixels of the frame, in world
+///		 coordinates, the bounds of the frame if it is not trimmed
+//////////////////////////////////////////////////////////////
+sfFloatRect AnimationSystemGetTrimmedBounds(const AnimationSystem* _system, unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Update the global bounds of a slot in the spatial grid
+///
+/// Called when the transform or the frame size of a slot changes,
+/// nothing is done when culling is off.
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the slot
+//////////////////////////////////////////////////////////////
+void AnimationSystemUpdateBounds(AnimationSystem* _system, unsigned int _index);
@@ -0,0 +1,393 @@
+#include "AnimationKernel.h"
+#include "AnimationInternal.h"
+
+#include <SFML/Graphics.h>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define ANIMATION_KERNEL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Let GCC and Clang emit vector code for a single function
+#if defined(ANIMATION_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ANIMATION_KERNEL_TARGET(_isa) __attribute__((target(_isa)))
+#else
+#define ANIMATION_KERNEL_TARGET(_isa)
+#endif
+
+/// Number of animations advanced per vector iteration
+#define ANIMATION_KERNEL_WIDTH 8
+
+static AnimationKernelLevel kernelLevel = ANIMATION_KERNEL_SCALAR;
+static sfBool kernelLevelDetected = sfFalse;
+
+AnimationKernelLevel AnimationKernelGetSupportedLevel(void)
+{
+#if defined(ANIMATION_KERNEL_X86) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	int maxLeaf = info[0];
+	__cpuid(info, 1);
+	sfBool sse2 = (info[3] & (1 << 26)) != 0;
+	// AVX needs the OS to save the YMM registers
+	sfBool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0
+		&& (_xgetbv(0) & 6) == 6;
+	sfBool avx2 = sfFalse;
+	if (avx && maxLeaf >= 7)
+	{
+		__cpuidex(info, 7, 0);
+		avx2 = (info[1] & (1 << 5)) != 0;
+	}
+	if (avx2)
+	{
+		return ANIMATION_KERNEL_AVX2;
+	}
+	return sse2 ? ANIMATION_KERNEL_SSE2 : ANIMATION_KERNEL_SCALAR;
+#elif defined(ANIMATION_KERNEL_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return ANIMATION_KERNEL_AVX2;
+	}
+	return __builtin_cpu_supports("sse2")
+		? ANIMATION_KERNEL_SSE2
+		: ANIMATION_KERNEL_SCALAR;
+#else
+	return ANIMATION_KERNEL_SCALAR;
+#endif
+}
+
+AnimationKernelLevel AnimationKernelGetLevel(void)
+{
+	if (!kernelLevelDetected)
+	{
+		kernelLevel = AnimationKernelGetSupportedLevel();
+		kernelLevelDetected = sfTrue;
+	}
+	return kernelLevel;
+}
+
+void AnimationKernelSetLevel(AnimationKernelLevel _level)
+{
+	AnimationKernelLevel supported = AnimationKernelGetSupportedLevel();
+	kernelLevel = _level < supported ? _level : supported;
+	kernelLevelDetected = sfTrue;
+}
+
+// Tell if a group of animations holds a clip with per-frame durations
+static sfBool AnimationKernelHasVariableTimes(
+	const AnimationSystem* _system,
+	unsigned int _index)
+{
+	unsigned long long flags;
+	memcpy(&flags, &_system->variableTimes[_index], sizeof(flags));
+	return flags != 0;
+}
+
+#if defined(ANIMATION_KERNEL_X86)
+
+ANIMATION_KERNEL_TARGET("sse2")
+static __m128i AnimationKernelBlendSse2(__m128i _mask, __m128i _a, __m128i _b)
+{
+	return _mm_or_si128(_mm_and_si128(_mask, _a), _mm_andnot_si128(_mask, _b));
+}
+
+// (int)floor of two doubles, without the SSE4.1 rounding instructions
+ANIMATION_KERNEL_TARGET("sse2")
+static __m128i AnimationKernelFloorSse2(__m128d _value)
+{
+	__m128i truncated = _mm_cvttpd_epi32(_value);
+	__m128d greater = _mm_cmpgt_pd(_mm_cvtepi32_pd(truncated), _value);
+	// Keep the low half of each 64 bit mask, -1 where truncation rounded up
+	__m128i correction = _mm_shuffle_epi32(
+		_mm_castpd_si128(greater), _MM_SHUFFLE(3, 3, 2, 0));
+	return _mm_add_epi32(truncated, correction);
+}
+
+// Advance 4 clocks, return their frames and the mask of stopped animations
+ANIMATION_KERNEL_TARGET("sse2")
+static __m128i AnimationKernelQuadSse2(
+	float* _clock,
+	const float* _duration,
+	__m128i _framesNb,
+	__m128i _state,
+	__m128i _playing,
+	float _dt,
+	__m128i* _stopped)
+{
+	const __m128i reversedBit = _mm_set1_epi32(REVERSED);
+	const __m128i loopedBit = _mm_set1_epi32(LOOPED);
+	const __m128i zero = _mm_setzero_si128();
+
+	__m128i reversed = _mm_cmpeq_epi32(_mm_and_si128(_state, reversedBit), reversedBit);
+	__m128i looped = _mm_cmpeq_epi32(_mm_and_si128(_state, loopedBit), loopedBit);
+
+	__m128 clock = _mm_loadu_ps(_clock);
+	__m128 duration = _mm_loadu_ps(_duration);
+
+	// clock - dt is exactly clock + (-dt)
+	__m128 dt = _mm_castsi128_ps(AnimationKernelBlendSse2(
+		reversed,
+		_mm_castps_si128(_mm_set1_ps(-_dt)),
+		_mm_castps_si128(_mm_set1_ps(_dt))));
+	__m128 advanced = _mm_add_ps(clock, dt);
+
+	// Same double precision progression as the scalar update
+	__m128d framesLow = _mm_cvtepi32_pd(_framesNb);
+	__m128d framesHigh = _mm_cvtepi32_pd(_mm_shuffle_epi32(_framesNb, _MM_SHUFFLE(3, 2, 3, 2)));
+	__m128d progressionLow = _mm_div_pd(
+		_mm_cvtps_pd(advanced), _mm_cvtps_pd(duration));
+	__m128d progressionHigh = _mm_div_pd(
+		_mm_cvtps_pd(_mm_movehl_ps(advanced, advanced)),
+		_mm_cvtps_pd(_mm_movehl_ps(duration, duration)));
+	__m128i nextFrame = _mm_unpacklo_epi64(
+		AnimationKernelFloorSse2(_mm_mul_pd(progressionLow, framesLow)),
+		AnimationKernelFloorSse2(_mm_mul_pd(progressionHigh, framesHigh)));
+
+	// Has the animation played its last frame
+	__m128i lastFrame = _mm_sub_epi32(_framesNb, _mm_set1_epi32(1));
+	__m128i forwardEnd = _mm_and_si128(
+		_mm_castps_si128(_mm_cmpgt_ps(advanced, duration)),
+		_mm_cmpgt_epi32(nextFrame, lastFrame));
+	__m128i reversedEnd = _mm_and_si128(
+		_mm_castps_si128(_mm_cmplt_ps(advanced, _mm_setzero_ps())),
+		_mm_cmplt_epi32(nextFrame, zero));
+	__m128i end = AnimationKernelBlendSse2(reversed, reversedEnd, forwardEnd);
+
+	// Looping restarts at the first played frame, stopping keeps the last one
+	__m128i endFrame = _mm_andnot_si128(_mm_xor_si128(looped, reversed), lastFrame);
+	__m128i loopClock = _mm_and_si128(reversed, _mm_castps_si128(duration));
+	__m128i endClock = AnimationKernelBlendSse2(
+		looped, loopClock, _mm_castps_si128(advanced));
+	__m128i newClock = AnimationKernelBlendSse2(
+		end, endClock, _mm_castps_si128(advanced));
+	newClock = AnimationKernelBlendSse2(
+		_playing, newClock, _mm_castps_si128(clock));
+	_mm_storeu_ps(_clock, _mm_castsi128_ps(newClock));
+
+	*_stopped = _mm_andnot_si128(looped, end);
+	return AnimationKernelBlendSse2(end, endFrame, nextFrame);
+}
+
+ANIMATION_KERNEL_TARGET("sse2")
+static void AnimationKernelAdvanceSse2(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end,
+	float _dt)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+	unsigned int i = _begin;
+
+	for (; i + ANIMATION_KERNEL_WIDTH <= _end; i += ANIMATION_KERNEL_WIDTH)
+	{
+		__m128i playing = _mm_loadl_epi64((const __m128i*)&_system->isPlaying[i]);
+		__m128i playingMask = _mm_xor_si128(
+			_mm_cmpeq_epi8(playing, zero), _mm_set1_epi8(-1));
+		if ((_mm_movemask_epi8(playingMask) & 0xFF) == 0)
+		{
+			continue;
+		}
+		if (AnimationKernelHasVariableTimes(_system, i))
+		{
+			AnimationSystemAdvance(_system, i, i + ANIMATION_KERNEL_WIDTH, _dt);
+			continue;
+		}
+
+		// Widen the byte arrays to 32 bit lanes
+		__m128i state = _mm_unpacklo_epi8(
+			_mm_loadl_epi64((const __m128i*)&_system->state[i]), zero);
+		__m128i framesNb = _mm_unpacklo_epi8(
+			_mm_loadl_epi64((const __m128i*)&_system->framesNb[i]), zero);
+		__m128i playing16 = _mm_unpacklo_epi8(playingMask, playingMask);
+
+		__m128i stoppedLow;
+		__m128i stoppedHigh;
+		__m128i frameLow = AnimationKernelQuadSse2(
+			&_system->clock[i],
+			&_system->duration[i],
+			_mm_unpacklo_epi16(framesNb, zero),
+			_mm_unpacklo_epi16(state, zero),
+			_mm_unpacklo_epi16(playing16, playing16),
+			_dt,
+			&stoppedLow);
+		__m128i frameHigh = AnimationKernelQuadSse2(
+			&_system->clock[i + 4],
+			&_system->duration[i + 4],
+			_mm_unpackhi_epi16(framesNb, zero),
+			_mm_unpackhi_epi16(state, zero),
+			_mm_unpackhi_epi16(playing16, playing16),
+			_dt,
+			&stoppedHigh);
+
+		// Narrow back to bytes, truncating like the unsigned char cast
+		__m128i frames = _mm_packs_epi32(
+			_mm_and_si128(frameLow, byteMask), _mm_and_si128(frameHigh, byteMask));
+		frames = _mm_packus_epi16(frames, frames);
+		__m128i stopped = _mm_packs_epi32(stoppedLow, stoppedHigh);
+		stopped = _mm_packs_epi16(stopped, stopped);
+
+		__m128i currentFrame = _mm_loadl_epi64((const __m128i*)&_system->currentFrame[i]);
+		__m128i frameDirty = _mm_loadl_epi64((const __m128i*)&_system->frameDirty[i]);
+		_mm_storel_epi64(
+			(__m128i*)&_system->currentFrame[i],
+			AnimationKernelBlendSse2(playingMask, frames, currentFrame));
+		_mm_storel_epi64(
+			(__m128i*)&_system->isPlaying[i],
+			_mm_andnot_si128(stopped, playing));
+		_mm_storel_epi64(
+			(__m128i*)&_system->frameDirty[i],
+			_mm_or_si128(frameDirty, _mm_and_si128(playingMask, _mm_set1_epi8(1))));
+	}
+
+	AnimationSystemAdvance(_system, i, _end, _dt);
+}
+
+ANIMATION_KERNEL_TARGET("avx2")
+static __m256i AnimationKernelBlendAvx2(__m256i _mask, __m256i _a, __m256i _b)
+{
+	return _mm256_blendv_epi8(_b, _a, _mask);
+}
+
+// Narrow eight 32 bit lanes to the low bytes, truncating
+ANIMATION_KERNEL_TARGET("avx2")
+static __m128i AnimationKernelNarrowAvx2(__m256i _value)
+{
+	__m256i bytes = _mm256_and_si256(_value, _mm256_set1_epi32(0xFF));
+	__m128i words = _mm_packs_epi32(
+		_mm256_castsi256_si128(bytes), _mm256_extracti128_si256(bytes, 1));
+	return _mm_packus_epi16(words, words);
+}
+
+ANIMATION_KERNEL_TARGET("avx2")
+static void AnimationKernelAdvanceAvx2(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end,
+	float _dt)
+{
+	const __m256i reversedBit = _mm256_set1_epi32(REVERSED);
+	const __m256i loopedBit = _mm256_set1_epi32(LOOPED);
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i zero = _mm256_setzero_si256();
+	unsigned int i = _begin;
+
+	for (; i + ANIMATION_KERNEL_WIDTH <= _end; i += ANIMATION_KERNEL_WIDTH)
+	{
+		__m128i playingBytes = _mm_loadl_epi64((const __m128i*)&_system->isPlaying[i]);
+		__m128i stoppedBytes = _mm_cmpeq_epi8(playingBytes, _mm_setzero_si128());
+		if ((_mm_movemask_epi8(stoppedBytes) & 0xFF) == 0xFF)
+		{
+			continue;
+		}
+		if (AnimationKernelHasVariableTimes(_system, i))
+		{
+			AnimationSystemAdvance(_system, i, i + ANIMATION_KERNEL_WIDTH, _dt);
+			continue;
+		}
+
+		__m256i playing = _mm256_xor_si256(
+			_mm256_cmpeq_epi32(_mm256_cvtepu8_epi32(playingBytes), zero),
+			_mm256_set1_epi32(-1));
+		__m256i state = _mm256_cvtepu8_epi32(
+			_mm_loadl_epi64((const __m128i*)&_system->state[i]));
+		__m256i framesNb = _mm256_cvtepu8_epi32(
+			_mm_loadl_epi64((const __m128i*)&_system->framesNb[i]));
+		__m256i reversed = _mm256_cmpeq_epi32(_mm256_and_si256(state, reversedBit), reversedBit);
+		__m256i looped = _mm256_cmpeq_epi32(_mm256_and_si256(state, loopedBit), loopedBit);
+
+		__m256 clock = _mm256_loadu_ps(&_system->clock[i]);
+		__m256 duration = _mm256_loadu_ps(&_system->duration[i]);
+
+		// clock - dt is exactly clock + (-dt)
+		__m256 dt = _mm256_blendv_ps(
+			_mm256_set1_ps(_dt), _mm256_set1_ps(-_dt), _mm256_castsi256_ps(reversed));
+		__m256 advanced = _mm256_add_ps(clock, dt);
+
+		// Same double precision progression as the scalar update
+		__m256d progressionLow = _mm256_div_pd(
+			_mm256_cvtps_pd(_mm256_castps256_ps128(advanced)),
+			_mm256_cvtps_pd(_mm256_castps256_ps128(duration)));
+		__m256d progressionHigh = _mm256_div_pd(
+			_mm256_cvtps_pd(_mm256_extractf128_ps(advanced, 1)),
+			_mm256_cvtps_pd(_mm256_extractf128_ps(duration, 1)));
+		__m128i frameLow = _mm256_cvttpd_epi32(_mm256_floor_pd(_mm256_mul_pd(
+			progressionLow,
+			_mm256_cvtepi32_pd(_mm256_castsi256_si128(framesNb)))));
+		__m128i frameHigh = _mm256_cvttpd_epi32(_mm256_floor_pd(_mm256_mul_pd(
+			progressionHigh,
+			_mm256_cvtepi32_pd(_mm256_extracti128_si256(framesNb, 1)))));
+		__m256i nextFrame = _mm256_inserti128_si256(
+			_mm256_castsi128_si256(frameLow), frameHigh, 1);
+
+		// Has the animation played its last frame
+		__m256i lastFrame = _mm256_sub_epi32(framesNb, one);
+		__m256i forwardEnd = _mm256_and_si256(
+			_mm256_castps_si256(_mm256_cmp_ps(advanced, duration, _CMP_GT_OQ)),
+			_mm256_cmpgt_epi32(nextFrame, lastFrame));
+		__m256i reversedEnd = _mm256_and_si256(
+			_mm256_castps_si256(_mm256_cmp_ps(advanced, _mm256_setzero_ps(), _CMP_LT_OQ)),
+			_mm256_cmpgt_epi32(zero, nextFrame));
+		__m256i end = AnimationKernelBlendAvx2(reversed, reversedEnd, forwardEnd);
+
+		// Looping restarts at the first played frame, stopping keeps the last one
+		__m256i endFrame = _mm256_andnot_si256(_mm256_xor_si256(looped, reversed), lastFrame);
+		__m256i loopClock = _mm256_and_si256(reversed, _mm256_castps_si256(duration));
+		__m256i endClock = AnimationKernelBlendAvx2(
+			looped, loopClock, _mm256_castps_si256(advanced));
+		__m256i newClock = AnimationKernelBlendAvx2(
+			end, endClock, _mm256_castps_si256(advanced));
+		newClock = AnimationKernelBlendAvx2(
+			playing, newClock, _mm256_castps_si256(clock));
+		_mm256_storeu_ps(&_system->clock[i], _mm256_castsi256_ps(newClock));
+
+		__m256i frames = AnimationKernelBlendAvx2(end, endFrame, nextFrame);
+		frames = AnimationKernelBlendAvx2(
+			playing,
+			frames,
+			_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)&_system->currentFrame[i])));
+		__m256i stillPlaying = _mm256_andnot_si256(
+			_mm256_andnot_si256(looped, end), _mm256_and_si256(playing, one));
+		__m256i frameDirty = _mm256_or_si256(
+			_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)&_system->frameDirty[i])),
+			_mm256_and_si256(playing, one));
+
+		_mm_storel_epi64(
+			(__m128i*)&_system->currentFrame[i], AnimationKernelNarrowAvx2(frames));
+		_mm_storel_epi64(
+			(__m128i*)&_system->isPlaying[i], AnimationKernelNarrowAvx2(stillPlaying));
+		_mm_storel_epi64(
+			(__m128i*)&_system->frameDirty[i], AnimationKernelNarrowAvx2(frameDirty));
+	}
+
+	AnimationSystemAdvance(_system, i, _end, _dt);
+}
+
+#endif
+
+void AnimationKernelAdvance(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end,
+	float _dt)
+{
+	switch (AnimationKernelGetLevel())
+	{
+#if defined(ANIMATION_KERNEL_X86)
+	case ANIMATION_KERNEL_AVX2:
+		AnimationKernelAdvanceAvx2(_system, _begin, _end, _dt);
+		break;
+	case ANIMATION_KERNEL_SSE2:
+		AnimationKernelAdvanceSse2(_system, _begin, _end, _dt);
+		break;
+#endif
+	default:
+		AnimationSystemAdvance(_system, _begin, _end, _dt);
+		break;
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "AnimationSystem.h"
+
+/// @brief Instruction sets the clock kernel can run with
+/// (SCALAR, SSE2, AVX2)
+typedef enum AnimationKernelLevel
+{
+	/// @brief Portable C, one animation at a time
+	ANIMATION_KERNEL_SCALAR = 0,
+	/// @brief 8 animations per iteration with SSE2
+	ANIMATION_KERNEL_SSE2,
+	/// @brief 8 animations per iteration with AVX2
+	ANIMATION_KERNEL_AVX2
+} AnimationKernelLevel;
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the best kernel level supported by the CPU
+///
+/// @return Highest supported level
+//////////////////////////////////////////////////////////////
+AnimationKernelLevel AnimationKernelGetSupportedLevel(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the kernel level used by AnimationKernelAdvance
+///
+/// Defaults to the best supported level, detected by the first call,
+/// which AnimationSystemCreate makes before any update can run.
+///
+/// @return Current level
+//////////////////////////////////////////////////////////////
+AnimationKernelLevel AnimationKernelGetLevel(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Force the kernel level used by AnimationKernelAdvance
+///
+/// Levels above the supported one are lowered to it. Must not be called
+/// while a system is updated by a job pool.
+///
+/// @param _level Wanted level
+//////////////////////////////////////////////////////////////
+void AnimationKernelSetLevel(AnimationKernelLevel _level);
+
+//////////////////////////////////////////////////////////////
+/// @brief Advance the clocks and frames of a range of animations
+///
+/// Gives the same clocks, frames and playing flags as AnimationUpdate.
+/// Vector levels resolve the REVERSED and LOOPED cases with masks
+/// instead of branches; groups holding a clip with per-frame durations
+/// fall back to the scalar code.
+///
+/// @param _system Animation system object
+///
+/// @param _begin First animation of the range
+///
+/// @param _end Animation after the last one of the range
+///
+/// @param _dt Delta time
+//////////////////////////////////////////////////////////////
+void AnimationKernelAdvance(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end,
+	float _dt);
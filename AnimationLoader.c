@@ -0,0 +1,235 @@
+#include "AnimationLoader.h"
+#include "AnimationProfiler.h"
+#include "FrameTable.h"
+#include "SpriteSheetCache.h"
+#include "TextureCache.h"
+
+#include <SFML/Graphics.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Sprite sheet decoded for one or more entries
+typedef struct AnimationLoadSheet
+{
+	/// First entry loading the sprite sheet
+	unsigned int entry;
+	sfIntRect area;
+	sfImage* image;
+	/// Texture already in the cache, with one reference
+	sfTexture* texture;
+} AnimationLoadSheet;
+
+/// @brief Data of the decoding job
+typedef struct AnimationLoadJob
+{
+	AnimationLoadEntry* entries;
+	AnimationLoadSheet* sheets;
+	/// Indices of the sprite sheets to decode
+	unsigned int* decoded;
+	/// Clock read by every worker
+	const sfClock* clock;
+} AnimationLoadJob;
+
+// Decode a chunk of the sprite sheets, on the workers of the pool
+static void AnimationLoadDecode(
+	void* _userData,
+	unsigned int _begin,
+	unsigned int _end,
+	unsigned int _worker)
+{
+	(void)_worker;
+	AnimationLoadJob* job = _userData;
+	for (unsigned int i = _begin; i < _end; i++)
+	{
+		AnimationLoadSheet* sheet = &job->sheets[job->decoded[i]];
+		AnimationLoadEntry* entry = &job->entries[sheet->entry];
+
+		sfInt64 start = sfClock_getElapsedTime(job->clock).microseconds;
+		ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_LOAD);
+		sheet->image = SpriteSheetCacheLoadImage(entry->filename, &sheet->area);
+		ANIMATION_PROFILE_END(ANIMATION_PROFILER_LOAD);
+		entry->decodeTime = (float)(sfClock_getElapsedTime(job->clock).microseconds - start) / 1000000.f;
+	}
+}
+
+// Find the sprite sheet of a previous entry with the same file and area
+static unsigned int AnimationLoadFindSheet(
+	const AnimationLoadEntry* _entries,
+	const AnimationLoadSheet* _sheets,
+	unsigned int _sheetsNb,
+	const char* _filename,
+	sfIntRect _area)
+{
+	for (unsigned int i = 0; i < _sheetsNb; i++)
+	{
+		const AnimationLoadSheet* sheet = &_sheets[i];
+		if (sheet->area.left == _area.left
+			&& sheet->area.top == _area.top
+			&& sheet->area.width == _area.width
+			&& sheet->area.height == _area.height
+			&& strcmp(_entries[sheet->entry].filename, _filename) == 0)
+		{
+			return i;
+		}
+	}
+	return _sheetsNb;
+}
+
+unsigned int AnimationLoadManifest(
+	AnimationLoadEntry* _entries,
+	unsigned int _entriesNb,
+	AnimationSystem* _system,
+	JobPool* _pool,
+	AnimationLoadReport* _report)
+{
+	AnimationLoadReport report = { 0 };
+	sfClock* clock = sfClock_create();
+	AnimationLoadSheet* sheets = malloc(_entriesNb * sizeof(AnimationLoadSheet));
+	unsigned int* decoded = malloc(_entriesNb * sizeof(unsigned int));
+	unsigned int* entrySheet = malloc(_entriesNb * sizeof(unsigned int));
+	if (clock == NULL
+		|| (_entriesNb > 0 && (sheets == NULL || decoded == NULL || entrySheet == NULL)))
+	{
+		printf("Error during cration of the manifest loader !");
+		if (clock != NULL)
+		{
+			sfClock_destroy(clock);
+		}
+		free(sheets);
+		free(decoded);
+		free(entrySheet);
+		return 0;
+	}
+
+	// Gather the sprite sheets, each file and area once, skipping the
+	// ones already loaded
+	unsigned int sheetsNb = 0;
+	unsigned int decodedNb = 0;
+	for (unsigned int i = 0; i < _entriesNb; i++)
+	{
+		AnimationLoadEntry* entry = &_entries[i];
+		entry->anim = NULL;
+		entry->decodeTime = 0.f;
+		entry->uploadTime = 0.f;
+		entry->loaded = sfFalse;
+
+		sfIntRect area = AnimationLayoutGetArea(
+			AnimationLayoutFromString(entry->structure),
+			entry->animationOffset != NULL ? *entry->animationOffset : (sfVector2u) { 0, 0 },
+			entry->frameSize,
+			entry->framesNb,
+			entry->blockLength != NULL ? *entry->blockLength : (sfVector2u) { 0, 0 });
+
+		unsigned int sheet = AnimationLoadFindSheet(
+			_entries, sheets, sheetsNb, entry->filename, area);
+		if (sheet == sheetsNb)
+		{
+			sheets[sheetsNb].entry = i;
+			sheets[sheetsNb].area = area;
+			sheets[sheetsNb].image = NULL;
+			sheets[sheetsNb].texture = TextureCacheLookup(entry->filename, &area);
+			if (sheets[sheetsNb].texture == NULL)
+			{
+				decoded[decodedNb++] = sheetsNb;
+			}
+			sheetsNb++;
+		}
+		entrySheet[i] = sheet;
+	}
+
+	// Decode in parallel, one sprite sheet per chunk as their sizes vary
+	JobPool* pool = _pool != NULL ? _pool : JobPoolCreate(0);
+	AnimationLoadJob job = { _entries, sheets, decoded, clock };
+	if (pool != NULL)
+	{
+		JobPoolRun(pool, AnimationLoadDecode, &job, decodedNb, 1);
+	}
+	else
+	{
+		AnimationLoadDecode(&job, 0, decodedNb, 0);
+	}
+	if (pool != _pool)
+	{
+		JobPoolDestroy(pool);
+	}
+
+	// Create the textures, the cache holds them until the animations
+	// acquire them
+	for (unsigned int i = 0; i < decodedNb; i++)
+	{
+		AnimationLoadSheet* sheet = &sheets[decoded[i]];
+		AnimationLoadEntry* entry = &_entries[sheet->entry];
+		report.decodeTime += entry->decodeTime;
+		if (sheet->image == NULL)
+		{
+			continue;
+		}
+
+		sfInt64 start = sfClock_getElapsedTime(clock).microseconds;
+		sfTexture* texture = NULL;
+		ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_LOAD);
+		texture = sfTexture_createFromImage(sheet->image, NULL);
+		ANIMATION_PROFILE_END(ANIMATION_PROFILER_LOAD);
+		ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_TEXTURE_LOADS, texture != NULL);
+		sfImage_destroy(sheet->image);
+		sheet->image = NULL;
+		sheet->texture = texture != NULL
+			? TextureCacheInsert(entry->filename, &sheet->area, texture)
+			: NULL;
+		if (sheet->texture == NULL && texture != NULL)
+		{
+			sfTexture_destroy(texture);
+		}
+		entry->uploadTime = (float)(sfClock_getElapsedTime(clock).microseconds - start) / 1000000.f;
+		report.uploadTime += entry->uploadTime;
+		report.decodedNb++;
+	}
+
+	// Bind the animations, the sprite sheets are found in the cache
+	unsigned int loadedNb = 0;
+	for (unsigned int i = 0; i < _entriesNb; i++)
+	{
+		AnimationLoadEntry* entry = &_entries[i];
+		entry->anim = _system != NULL
+			? AnimationSystemCreateAnimation(_system, entry->frameSize, entry->framesNb)
+			: AnimationCreate(entry->frameSize, entry->framesNb);
+		if (entry->anim == NULL)
+		{
+			report.failedNb++;
+			continue;
+		}
+		if (sheets[entrySheet[i]].texture == NULL)
+		{
+			// Reported once per entry, as AnimationSetSpriteSheet would
+			printf("Error during cration of the sprite sheet texture !");
+			report.failedNb++;
+			continue;
+		}
+		AnimationSetSpriteSheet(
+			entry->anim,
+			entry->filename,
+			entry->structure,
+			entry->animationOffset,
+			entry->blockLength);
+		entry->loaded = sfTrue;
+		loadedNb++;
+	}
+
+	// The animations hold their own references
+	for (unsigned int i = 0; i < sheetsNb; i++)
+	{
+		TextureCacheRelease(sheets[i].texture);
+	}
+
+	report.totalTime = sfTime_asSeconds(sfClock_getElapsedTime(clock));
+	if (_report != NULL)
+	{
+		*_report = report;
+	}
+	sfClock_destroy(clock);
+	free(sheets);
+	free(decoded);
+	free(entrySheet);
+	return loadedNb;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "Animation.h"
+#include "AnimationSystem.h"
+#include "JobPool.h"
+
+// The loader creates the animations of a manifest in a single call, for
+// the startup of a game. The sprite sheets of all the entries are decoded
+// in parallel by a job pool, each file and area only once, then the
+// textures are created and the animations are bound on the calling
+// thread, the one owning the OpenGL context. The textures are shared
+// through the texture cache, as if every entry was loaded with
+// AnimationSetSpriteSheet.
+
+/// @brief Sprite sheet of a manifest and the animation created with it
+typedef struct AnimationLoadEntry
+{
+	/// Path of the sprite sheet file
+	const char* filename;
+	/// Sprite sheet structure ("horizontal", "vertical" or "block")
+	const char* structure;
+	/// Size of a frame
+	sfVector2u frameSize;
+	/// Number of frames
+	unsigned char framesNb;
+	/// Offset of the animation, NULL for none
+	sfVector2u* animationOffset;
+	/// Width and height of the block sprite sheet, NULL if not a block
+	sfVector2u* blockLength;
+
+	/// Animation created, set by the loader
+	Animation* anim;
+	/// Seconds spent decoding the sprite sheet, 0 when it was shared
+	/// with a previous entry or already loaded
+	float decodeTime;
+	/// Seconds spent creating the texture, 0 when it was shared
+	float uploadTime;
+	/// sfTrue if the sprite sheet was loaded, set by the loader
+	sfBool loaded;
+} AnimationLoadEntry;
+
+/// @brief Times of a manifest load
+typedef struct AnimationLoadReport
+{
+	/// Seconds spent in AnimationLoadManifest
+	float totalTime;
+	/// Seconds spent decoding the sprite sheets, all workers together
+	float decodeTime;
+	/// Seconds spent creating the textures
+	float uploadTime;
+	/// Number of sprite sheets decoded
+	unsigned int decodedNb;
+	/// Number of entries whose sprite sheet cannot be load
+	unsigned int failedNb;
+} AnimationLoadReport;
+
+//////////////////////////////////////////////////////////////
+/// @brief Load the sprite sheets of a manifest and create its animations
+///
+/// Must be called from the thread owning the OpenGL context. An entry
+/// whose sprite sheet cannot be load still gets an animation, drawn
+/// without texture like after a failed AnimationSetSpriteSheet.
+///
+/// @param _entries Entries of the manifest, their animations are set
+///
+/// @param _entriesNb Number of entries
+///
+/// @param _system Animation system creating the animations, NULL for
+///				  the default system
+///
+/// @param _pool Job pool decoding the sprite sheets, NULL to use a
+///			    worker per core during the call
+///
+/// @param _report Times of the load, NULL if not needed
+///
+/// @return Number of entries whose sprite sheet was loaded
+//////////////////////////////////////////////////////////////
+unsigned int AnimationLoadManifest(
+	AnimationLoadEntry* _entries,
+	unsigned int _entriesNb,
+	AnimationSystem* _system,
+	JobPool* _pool,
+	AnimationLoadReport* _report);
@@ -0,0 +1,67 @@
+#include "AnimationLod.h"
+#include "AnimationInternal.h"
+
+#include <math.h>
+#include <stdio.h>
+
+// Tier of a ratio to a full rate threshold, one tier per doubling
+static unsigned char AnimationLodGetTier(float _ratio)
+{
+	if (_ratio <= 1)
+	{
+		return ANIMATION_LOD_FULL;
+	}
+	if (_ratio <= 2)
+	{
+		return ANIMATION_LOD_HALF;
+	}
+	if (_ratio <= 4)
+	{
+		return ANIMATION_LOD_QUARTER;
+	}
+	return ANIMATION_LOD_EIGHTH;
+}
+
+void AnimationSetLodTier(Animation* _anim, AnimationLodTier _tier)
+{
+	if (_tier > ANIMATION_LOD_EIGHTH)
+	{
+		printf("Error : unknown level of detail !");
+		return;
+	}
+	AnimationSystemSetLodTier(_anim->system, _anim->index, (unsigned char)_tier);
+}
+
+AnimationLodTier AnimationGetLodTier(const Animation* _anim)
+{
+	return (AnimationLodTier)_anim->system->lodTier[_anim->index];
+}
+
+unsigned int AnimationSystemSetLodTiers(
+	AnimationSystem* _system,
+	sfVector2f _focus,
+	float _fullRateDistance,
+	float _fullRateSize)
+{
+	for (unsigned int i = 0; i < _system->count; i++)
+	{
+		unsigned char tier = ANIMATION_LOD_FULL;
+		if (_fullRateDistance > 0)
+		{
+			float x = _system->position[i].x - _focus.x;
+			float y = _system->position[i].y - _focus.y;
+			tier = AnimationLodGetTier(sqrtf(x * x + y * y) / _fullRateDistance);
+		}
+		if (_fullRateSize > 0)
+		{
+			sfFloatRect bounds = AnimationSystemGetBounds(_system, i);
+			float size = bounds.width > bounds.height ? bounds.width : bounds.height;
+			// A flattened animation is as small as it gets
+			unsigned char sizeTier = size > 0
+				? AnimationLodGetTier(_fullRateSize / size) : ANIMATION_LOD_EIGHTH;
+			tier = sizeTier > tier ? sizeTier : tier;
+		}
+		AnimationSystemSetLodTier(_system, i, tier);
+	}
+	return _system->lodSlotsNb;
+}
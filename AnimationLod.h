@@ -0,0 +1,78 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "Animation.h"
+#include "AnimationSystem.h"
+
+// An animation below the full rate is only advanced at one update out
+// of 2, 4 or 8, by the time of all the updates since it was last
+// advanced, so its clock never drifts: reading or changing it, or
+// bringing it back to the full rate, first catches up with the skipped
+// time. The animations of a tier are spread over the updates so that
+// they are not all advanced by the same one.
+// Levels of detail only apply to the updates of a system that is
+// neither event-driven nor in tick mode, those already only do the
+// work they need.
+
+/// @brief Update rates of an animation
+typedef enum AnimationLodTier
+{
+	/// Advanced at every update
+	ANIMATION_LOD_FULL,
+	/// Advanced at one update out of 2
+	ANIMATION_LOD_HALF,
+	/// Advanced at one update out of 4
+	ANIMATION_LOD_QUARTER,
+	/// Advanced at one update out of 8
+	ANIMATION_LOD_EIGHTH
+} AnimationLodTier;
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the update rate of an animation
+///
+/// @param _anim Animation object
+///
+/// @param _tier Update rate, ANIMATION_LOD_FULL by default
+//////////////////////////////////////////////////////////////
+void AnimationSetLodTier(Animation* _anim, AnimationLodTier _tier);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the update rate of an animation
+///
+/// @param _anim Animation object
+///
+/// @return Update rate of the animation
+//////////////////////////////////////////////////////////////
+AnimationLodTier AnimationGetLodTier(const Animation* _anim);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the update rate of every animation of a system from its
+/// distance to a focus point and its size
+///
+/// Each criterion lowers the rate by a tier each time the distance
+/// doubles past its threshold or the size halves below it, the lowest
+/// of the two rates is kept. Call it again when the focus or the view
+/// moves, it costs about as much as an update.
+///
+/// @param _system Animation system object
+///
+/// @param _focus Point of interest, usually the player or the middle of
+///				  the view, in world coordinates
+///
+/// @param _fullRateDistance Distance to the focus up to which animations
+///							 are at the full rate, 0 to ignore the distance
+///
+/// @param _fullRateSize Largest side of the global bounds down to which
+///						 animations are at the full rate, 0 to ignore
+///						 the size
+///
+/// @return Number of animations below the full rate
+//////////////////////////////////////////////////////////////
+unsigned int AnimationSystemSetLodTiers(
+	AnimationSystem* _system,
+	sfVector2f _focus,
+	float _fullRateDistance,
+	float _fullRateSize);
@@ -0,0 +1,316 @@
+#include "AnimationProfiler.h"
+
+#include <stdio.h>
+
+#if defined(ANIMATION_PROFILING)
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ANIMATION_PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#define ANIMATION_PROFILER_THREAD_LOCAL _Thread_local
+#endif
+
+static const char* const counterNames[ANIMATION_PROFILER_COUNTERS_NB] = {
+	"updates", "frame_changes", "texture_rects", "draw_calls", "texture_loads"
+};
+static const char* const zoneNames[ANIMATION_PROFILER_ZONES_NB] = {
+	"update", "frame_update", "draw", "load"
+};
+
+/// @brief Time spent once in a path
+typedef struct AnimationProfilerEvent
+{
+	sfInt64 start;
+	sfInt64 duration;
+	unsigned int thread;
+	unsigned int zone;
+} AnimationProfilerEvent;
+
+/// @brief Counters and time spent in each path during a frame
+typedef struct AnimationProfilerFrame
+{
+	sfInt64 end;
+	long long counters[ANIMATION_PROFILER_COUNTERS_NB];
+	long long zoneTimes[ANIMATION_PROFILER_ZONES_NB];
+} AnimationProfilerFrame;
+
+static sfClock* profilerClock = NULL;
+static volatile long long recording = 0;
+
+/// Ring of timings, the writers reserve their event with an atomic add
+static AnimationProfilerEvent events[ANIMATION_PROFILER_EVENTS_NB];
+static volatile long long eventsWritten = 0;
+
+// Current frame
+static volatile long long counters[ANIMATION_PROFILER_COUNTERS_NB];
+static volatile long long zoneTimes[ANIMATION_PROFILER_ZONES_NB];
+
+/// Ring of the closed frames
+static AnimationProfilerFrame frames[ANIMATION_PROFILER_FRAMES_NB];
+static unsigned long long framesWritten = 0;
+
+/// Ids of the recording threads, 0 until a thread records
+static volatile long long threadsNb = 0;
+static ANIMATION_PROFILER_THREAD_LOCAL unsigned int threadId = 0;
+
+static long long AnimationProfilerFetchAdd(volatile long long* _value, long long _amount)
+{
+#if defined(_MSC_VER)
+	return _InterlockedExchangeAdd64(_value, _amount);
+#else
+	return __atomic_fetch_add(_value, _amount, __ATOMIC_RELAXED);
+#endif
+}
+
+static long long AnimationProfilerExchange(volatile long long* _value, long long _amount)
+{
+#if defined(_MSC_VER)
+	return _InterlockedExchange64(_value, _amount);
+#else
+	return __atomic_exchange_n(_value, _amount, __ATOMIC_RELAXED);
+#endif
+}
+
+void AnimationProfilerStart(void)
+{
+	if (profilerClock == NULL)
+	{
+		profilerClock = sfClock_create();
+		if (profilerClock == NULL)
+		{
+			printf("Error during cration of the profiler clock !");
+			return;
+		}
+	}
+	for (unsigned int i = 0; i < ANIMATION_PROFILER_COUNTERS_NB; i++)
+	{
+		counters[i] = 0;
+	}
+	for (unsigned int i = 0; i < ANIMATION_PROFILER_ZONES_NB; i++)
+	{
+		zoneTimes[i] = 0;
+	}
+	eventsWritten = 0;
+	framesWritten = 0;
+	sfClock_restart(profilerClock);
+	recording = 1;
+}
+
+void AnimationProfilerStop(void)
+{
+	recording = 0;
+}
+
+sfBool AnimationProfilerIsRecording(void)
+{
+	return recording != 0;
+}
+
+sfInt64 AnimationProfilerGetTime(void)
+{
+	if (!recording)
+	{
+		return 0;
+	}
+	return sfTime_asMicroseconds(sfClock_getElapsedTime(profilerClock));
+}
+
+void AnimationProfilerRecord(AnimationProfilerZone _zone, sfInt64 _start)
+{
+	if (!recording)
+	{
+		return;
+	}
+	sfInt64 duration = AnimationProfilerGetTime() - _start;
+	if (threadId == 0)
+	{
+		threadId = (unsigned int)AnimationProfilerFetchAdd(&threadsNb, 1) + 1;
+	}
+
+	// The oldest event is overwritten once the ring is full
+	long long index = AnimationProfilerFetchAdd(&eventsWritten, 1);
+	AnimationProfilerEvent* event = &events[index & (ANIMATION_PROFILER_EVENTS_NB - 1)];
+	event->start = _start;
+	event->duration = duration;
+	event->thread = threadId;
+	event->zone = _zone;
+	AnimationProfilerFetchAdd(&zoneTimes[_zone], duration);
+}
+
+void AnimationProfilerCount(AnimationProfilerCounter _counter, unsigned int _amount)
+{
+	if (recording)
+	{
+		AnimationProfilerFetchAdd(&counters[_counter], _amount);
+	}
+}
+
+void AnimationProfilerEndFrame(void)
+{
+	if (!recording)
+	{
+		return;
+	}
+	AnimationProfilerFrame* frame = &frames[framesWritten & (ANIMATION_PROFILER_FRAMES_NB - 1)];
+	frame->end = AnimationProfilerGetTime();
+	for (unsigned int i = 0; i < ANIMATION_PROFILER_COUNTERS_NB; i++)
+	{
+		frame->counters[i] = AnimationProfilerExchange(&counters[i], 0);
+	}
+	for (unsigned int i = 0; i < ANIMATION_PROFILER_ZONES_NB; i++)
+	{
+		frame->zoneTimes[i] = AnimationProfilerExchange(&zoneTimes[i], 0);
+	}
+	framesWritten++;
+}
+
+sfBool AnimationProfilerWriteTrace(const char* _filename)
+{
+	FILE* file = fopen(_filename, "w");
+	if (file == NULL)
+	{
+		printf("Error during opening of the trace file !");
+		return sfFalse;
+	}
+
+	fprintf(file, "{\"traceEvents\":[\n");
+	const char* separator = "";
+	unsigned long long written = (unsigned long long)eventsWritten;
+	unsigned long long first = written > ANIMATION_PROFILER_EVENTS_NB
+		? written - ANIMATION_PROFILER_EVENTS_NB : 0;
+	for (unsigned long long i = first; i < written; i++)
+	{
+		const AnimationProfilerEvent* event = &events[i & (ANIMATION_PROFILER_EVENTS_NB - 1)];
+		fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"animation\",\"ph\":\"X\","
+			"\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%u}",
+			separator, zoneNames[event->zone],
+			(long long)event->start, (long long)event->duration, event->thread);
+		separator = ",\n";
+	}
+
+	// Counters are drawn as graphs, one point per frame
+	first = framesWritten > ANIMATION_PROFILER_FRAMES_NB
+		? framesWritten - ANIMATION_PROFILER_FRAMES_NB : 0;
+	for (unsigned long long i = first; i < framesWritten; i++)
+	{
+		const AnimationProfilerFrame* frame = &frames[i & (ANIMATION_PROFILER_FRAMES_NB - 1)];
+		fprintf(file, "%s{\"name\":\"counters\",\"ph\":\"C\",\"ts\":%lld,\"pid\":1,\"args\":{",
+			separator, (long long)frame->end);
+		for (unsigned int j = 0; j < ANIMATION_PROFILER_COUNTERS_NB; j++)
+		{
+			fprintf(file, "%s\"%s\":%lld", j > 0 ? "," : "", counterNames[j], frame->counters[j]);
+		}
+		fprintf(file, "}}");
+		separator = ",\n";
+	}
+	fprintf(file, "\n]}\n");
+
+	sfBool saved = ferror(file) == 0;
+	fclose(file);
+	if (!saved)
+	{
+		printf("Error during writing of the trace file !");
+	}
+	return saved;
+}
+
+sfBool AnimationProfilerWriteCsv(const char* _filename)
+{
+	FILE* file = fopen(_filename, "w");
+	if (file == NULL)
+	{
+		printf("Error during opening of the CSV file !");
+		return sfFalse;
+	}
+
+	fprintf(file, "frame,end_us");
+	for (unsigned int i = 0; i < ANIMATION_PROFILER_COUNTERS_NB; i++)
+	{
+		fprintf(file, ",%s", counterNames[i]);
+	}
+	for (unsigned int i = 0; i < ANIMATION_PROFILER_ZONES_NB; i++)
+	{
+		fprintf(file, ",%s_us", zoneNames[i]);
+	}
+	fprintf(file, "\n");
+
+	unsigned long long first = framesWritten > ANIMATION_PROFILER_FRAMES_NB
+		? framesWritten - ANIMATION_PROFILER_FRAMES_NB : 0;
+	for (unsigned long long i = first; i < framesWritten; i++)
+	{
+		const AnimationProfilerFrame* frame = &frames[i & (ANIMATION_PROFILER_FRAMES_NB - 1)];
+		fprintf(file, "%llu,%lld", i, (long long)frame->end);
+		for (unsigned int j = 0; j < ANIMATION_PROFILER_COUNTERS_NB; j++)
+		{
+			fprintf(file, ",%lld", frame->counters[j]);
+		}
+		for (unsigned int j = 0; j < ANIMATION_PROFILER_ZONES_NB; j++)
+		{
+			fprintf(file, ",%lld", frame->zoneTimes[j]);
+		}
+		fprintf(file, "\n");
+	}
+
+	sfBool saved = ferror(file) == 0;
+	fclose(file);
+	if (!saved)
+	{
+		printf("Error during writing of the CSV file !");
+	}
+	return saved;
+}
+
+#else
+
+// Built without ANIMATION_PROFILING, nothing is recorded
+
+void AnimationProfilerStart(void)
+{
+}
+
+void AnimationProfilerStop(void)
+{
+}
+
+sfBool AnimationProfilerIsRecording(void)
+{
+	return sfFalse;
+}
+
+sfInt64 AnimationProfilerGetTime(void)
+{
+	return 0;
+}
+
+void AnimationProfilerRecord(AnimationProfilerZone _zone, sfInt64 _start)
+{
+	(void)_zone;
+	(void)_start;
+}
+
+void AnimationProfilerCount(AnimationProfilerCounter _counter, unsigned int _amount)
+{
+	(void)_counter;
+	(void)_amount;
+}
+
+void AnimationProfilerEndFrame(void)
+{
+}
+
+sfBool AnimationProfilerWriteTrace(const char* _filename)
+{
+	(void)_filename;
+	printf("Error : the profiler is not built, define ANIMATION_PROFILING !");
+	return sfFalse;
+}
+
+sfBool AnimationProfilerWriteCsv(const char* _filename)
+{
+	(void)_filename;
+	printf("Error : the profiler is not built, define ANIMATION_PROFILING !");
+	return sfFalse;
+}
+
+#endif
@@ -0,0 +1,130 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/System.h>
+
+/// @brief Counters summed over a frame
+typedef enum AnimationProfilerCounter
+{
+	/// Animations advanced by an update
+	ANIMATION_PROFILER_UPDATES,
+	/// Frames changed and shown
+	ANIMATION_PROFILER_FRAME_CHANGES,
+	/// Calls to sfSprite_setTextureRect
+	ANIMATION_PROFILER_TEXTURE_RECTS,
+	/// Sprites and vertex arrays drawn
+	ANIMATION_PROFILER_DRAW_CALLS,
+	/// Sprite sheets loaded from their files
+	ANIMATION_PROFILER_TEXTURE_LOADS,
+	ANIMATION_PROFILER_COUNTERS_NB
+} AnimationProfilerCounter;
+
+/// @brief Timed paths of the library
+typedef enum AnimationProfilerZone
+{
+	ANIMATION_PROFILER_UPDATE,
+	ANIMATION_PROFILER_FRAME_UPDATE,
+	ANIMATION_PROFILER_DRAW,
+	ANIMATION_PROFILER_LOAD,
+	ANIMATION_PROFILER_ZONES_NB
+} AnimationProfilerZone;
+
+/// Timings recorded before the oldest ones are overwritten, a power of two
+#define ANIMATION_PROFILER_EVENTS_NB 65536u
+/// Frames of counters kept, a power of two
+#define ANIMATION_PROFILER_FRAMES_NB 1024u
+
+// The library is only instrumented when built with ANIMATION_PROFILING,
+// otherwise the macros below compile to nothing.
+// BEGIN opens a block that END closes, so that they can be used where a
+// statement is expected, after a label included. Both must be in the
+// same block, and what is declared between them is only seen up to END.
+#if defined(ANIMATION_PROFILING)
+#define ANIMATION_PROFILE_BEGIN(_zone) \
+	{ sfInt64 animationProfileStart##_zone = AnimationProfilerGetTime()
+#define ANIMATION_PROFILE_END(_zone) \
+	AnimationProfilerRecord(_zone, animationProfileStart##_zone); }
+#define ANIMATION_PROFILE_COUNT(_counter, _amount) \
+	AnimationProfilerCount(_counter, _amount)
+#else
+#define ANIMATION_PROFILE_BEGIN(_zone) ((void)0)
+#define ANIMATION_PROFILE_END(_zone) ((void)0)
+#define ANIMATION_PROFILE_COUNT(_counter, _amount) ((void)sizeof(_amount))
+#endif
+
+//////////////////////////////////////////////////////////////
+/// @brief Clear what was recorded and start recording
+///
+/// Does nothing unless the library is built with ANIMATION_PROFILING.
+//////////////////////////////////////////////////////////////
+void AnimationProfilerStart(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Stop recording, what was recorded can still be written
+//////////////////////////////////////////////////////////////
+void AnimationProfilerStop(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if the profiler is recording
+///
+/// @return sfTrue if it is recording, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationProfilerIsRecording(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Close the counters of the current frame, once per game frame
+//////////////////////////////////////////////////////////////
+void AnimationProfilerEndFrame(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Write the timings and counters in the Chrome trace format,
+/// to open in about:tracing or Perfetto
+///
+/// Must not be called while another thread updates animations.
+///
+/// @param _filename Path of the JSON file to write
+///
+/// @return sfTrue if the file is written, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationProfilerWriteTrace(const char* _filename);
+
+//////////////////////////////////////////////////////////////
+/// @brief Write the counters and the time spent in each path, one line
+/// per frame
+///
+/// @param _filename Path of the CSV file to write
+///
+/// @return sfTrue if the file is written, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationProfilerWriteCsv(const char* _filename);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the time of the profiler, for ANIMATION_PROFILE_BEGIN
+///
+/// @return Microseconds since the recording started, 0 when not recording
+//////////////////////////////////////////////////////////////
+sfInt64 AnimationProfilerGetTime(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Record the time spent in a path, for ANIMATION_PROFILE_END
+///
+/// Lock-free, any thread can record.
+///
+/// @param _zone Path timed
+///
+/// @param _start Time returned by AnimationProfilerGetTime at its start
+//////////////////////////////////////////////////////////////
+void AnimationProfilerRecord(AnimationProfilerZone _zone, sfInt64 _start);
+
+//////////////////////////////////////////////////////////////
+/// @brief Add to a counter of the current frame, for ANIMATION_PROFILE_COUNT
+///
+/// Lock-free, any thread can count.
+///
+/// @param _counter Counter to increase
+///
+/// @param _amount Amount to add
+//////////////////////////////////////////////////////////////
+void AnimationProfilerCount(AnimationProfilerCounter _counter, unsigned int _amount);
@@ -0,0 +1,182 @@
+#include "AnimationQuery.h"
+#include "AnimationInternal.h"
+#include "SpatialGrid.h"
+
+#include <SFML/Graphics.h>
+#include <math.h>
+
+#define ANIMATION_QUERY_DEGREES_TO_RADIANS (3.14159265358979323846 / 180.0)
+
+// Tell if a point is in the rotated and scaled frame of a slot
+static sfBool AnimationQueryHoldsPoint(
+	const AnimationSystem* _system,
+	unsigned int _index,
+	sfVector2f _point)
+{
+	double angle = _system->rotation[_index] * ANIMATION_QUERY_DEGREES_TO_RADIANS;
+	double cosine = cos(angle);
+	double sine = sin(angle);
+	double x = _point.x - _system->position[_index].x;
+	double y = _point.y - _system->position[_index].y;
+
+	// Back in the frame, whose origin is its middle so flips do not matter
+	double localX = x * cosine + y * sine;
+	double localY = y * cosine - x * sine;
+	double halfWidth = fabs(_system->scale[_index].x) * _system->frameSize[_index].x / 2.0;
+	double halfHeight = fabs(_system->scale[_index].y) * _system->frameSize[_index].y / 2.0;
+	return fabs(localX) <= halfWidth && fabs(localY) <= halfHeight;
+}
+
+static sfBool AnimationQueryIntersects(sfFloatRect _bounds, sfFloatRect _area)
+{
+	return _bounds.left <= _area.left + _area.width
+		&& _area.left <= _bounds.left + _bounds.width
+		&& _bounds.top <= _area.top + _area.height
+		&& _area.top <= _bounds.top + _bounds.height;
+}
+
+unsigned int AnimationSystemQueryPoint(
+	AnimationSystem* _system,
+	sfVector2f _point,
+	Animation** _results,
+	unsigned int _resultsMax)
+{
+	unsigned int resultsNb = 0;
+	if (_system->grid != NULL)
+	{
+		const unsigned int* found = NULL;
+		unsigned int foundNb = SpatialGridQuery(
+			_system->grid, (sfFloatRect){ _point.x, _point.y, 0, 0 }, &found);
+		for (unsigned int f = 0; f < foundNb && resultsNb < _resultsMax; f++)
+		{
+			if (AnimationQueryHoldsPoint(_system, found[f], _point))
+			{
+				_results[resultsNb++] = _system->handles[found[f]];
+			}
+		}
+		return resultsNb;
+	}
+	for (unsigned int i = 0; i < _system->count && resultsNb < _resultsMax; i++)
+	{
+		if (AnimationQueryHoldsPoint(_system, i, _point))
+		{
+			_results[resultsNb++] = _system->handles[i];
+		}
+	}
+	return resultsNb;
+}
+
+unsigned int AnimationSystemQueryRect(
+	AnimationSystem* _system,
+	sfFloatRect _area,
+	Animation** _results,
+	unsigned int _resultsMax)
+{
+	unsigned int resultsNb = 0;
+	if (_system->grid != NULL)
+	{
+		// The grid tests the bounds already
+		const unsigned int* found = NULL;
+		unsigned int foundNb = SpatialGridQuery(_system->grid, _area, &found);
+		for (unsigned int f = 0; f < foundNb && resultsNb < _resultsMax; f++)
+		{
+			_results[resultsNb++] = _system->handles[found[f]];
+		}
+		return resultsNb;
+	}
+	for (unsigned int i = 0; i < _system->count && resultsNb < _resultsMax; i++)
+	{
+		if (AnimationQueryIntersects(AnimationSystemGetBounds(_system, i), _area))
+		{
+			_results[resultsNb++] = _system->handles[i];
+		}
+	}
+	return resultsNb;
+}
+
+static double AnimationQueryGetDistance(
+	const AnimationSystem* _system,
+	unsigned int _index,
+	sfVector2f _point)
+{
+	double x = _system->position[_index].x - _point.x;
+	double y = _system->position[_index].y - _point.y;
+	return x * x + y * y;
+}
+
+// Insert a slot in the results sorted by distance if it is among the k closest
+static unsigned int AnimationQueryKeepNearest(
+	const AnimationSystem* _system,
+	unsigned int _index,
+	sfVector2f _point,
+	Animation** _results,
+	unsigned int _resultsNb,
+	unsigned int _k)
+{
+	double distance = AnimationQueryGetDistance(_system, _index, _point);
+	unsigned int place = _resultsNb;
+	while (place > 0
+		&& AnimationQueryGetDistance(_system, _results[place - 1]->index, _point) > distance)
+	{
+		place--;
+	}
+	if (place >= _k)
+	{
+		return _resultsNb;
+	}
+	unsigned int last = _resultsNb < _k ? _resultsNb : _k - 1;
+	for (unsigned int j = last; j > place; j--)
+	{
+		_results[j] = _results[j - 1];
+	}
+	_results[place] = _system->handles[_index];
+	return _resultsNb < _k ? _resultsNb + 1 : _k;
+}
+
+unsigned int AnimationSystemQueryNearest(
+	AnimationSystem* _system,
+	sfVector2f _point,
+	Animation** _results,
+	unsigned int _k)
+{
+	unsigned int resultsNb = 0;
+	if (_k == 0)
+	{
+		return 0;
+	}
+	if (_system->grid == NULL)
+	{
+		for (unsigned int i = 0; i < _system->count; i++)
+		{
+			resultsNb = AnimationQueryKeepNearest(
+				_system, i, _point, _results, resultsNb, _k);
+		}
+		return resultsNb;
+	}
+
+	// Look in squares twice as large each time, until the k closest found
+	// are nearer than any animation out of the square
+	unsigned int total = SpatialGridGetCount(_system->grid);
+	double radius = SpatialGridGetCellSize(_system->grid);
+	for (;;)
+	{
+		const unsigned int* found = NULL;
+		unsigned int foundNb = SpatialGridQuery(_system->grid, (sfFloatRect) {
+			(float)(_point.x - radius), (float)(_point.y - radius),
+			(float)(2 * radius), (float)(2 * radius)
+		}, &found);
+		resultsNb = 0;
+		for (unsigned int f = 0; f < foundNb; f++)
+		{
+			resultsNb = AnimationQueryKeepNearest(
+				_system, found[f], _point, _results, resultsNb, _k);
+		}
+		if (foundNb >= total
+			|| (resultsNb == _k && AnimationQueryGetDistance(
+				_system, _results[_k - 1]->index, _point) <= radius * radius))
+		{
+			return resultsNb;
+		}
+		radius *= 2;
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "Animation.h"
+#include "AnimationSystem.h"
+
+// Queries look in the spatial grid of the system when culling is set
+// (see AnimationSystemSetCulling), through every animation otherwise.
+// Results are written in an array given by the caller, nothing is
+// allocated.
+
+//////////////////////////////////////////////////////////////
+/// @brief Find the animations whose frame holds a point
+///
+/// The point is tested against the rotated and scaled frame of each
+/// animation, not only its global bounds.
+///
+/// @param _system Animation system object
+///
+/// @param _point Point to look at, in world coordinates
+///
+/// @param _results Filled with the animations found
+///
+/// @param _resultsMax Size of the results array
+///
+/// @return Number of animations written in the results
+//////////////////////////////////////////////////////////////
+unsigned int AnimationSystemQueryPoint(
+	AnimationSystem* _system,
+	sfVector2f _point,
+	Animation** _results,
+	unsigned int _resultsMax);
+
+//////////////////////////////////////////////////////////////
+/// @brief Find the animations whose global bounds intersect an area
+///
+/// @param _system Animation system object
+///
+/// @param _area Area to look in, in world coordinates
+///
+/// @param _results Filled with the animations found
+///
+/// @param _resultsMax Size of the results array
+///
+/// @return Number of animations written in the results
+//////////////////////////////////////////////////////////////
+unsigned int AnimationSystemQueryRect(
+	AnimationSystem* _system,
+	sfFloatRect _area,
+	Animation** _results,
+	unsigned int _resultsMax);
+
+//////////////////////////////////////////////////////////////
+/// @brief Find the animations closest to a point
+///
+/// Distances are measured to the position of the animations.
+///
+/// @param _system Animation system object
+///
+/// @param _point Point to measure from, in world coordinates
+///
+/// @param _results Filled with the animations found, closest first
+///
+/// @param _k Number of animations to find, the size of the results array
+///
+/// @return Number of animations written in the results, lower than k
+///			when the system has fewer animations
+//////////////////////////////////////////////////////////////
+unsigned int AnimationSystemQueryNearest(
+	AnimationSystem* _system,
+	sfVector2f _point,
+	Animation** _results,
+	unsigned int _k);
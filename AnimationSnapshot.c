@@ -0,0 +1,288 @@
+#include "AnimationSnapshot.h"
+#include "AnimationHandle.h"
+#include "AnimationInternal.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/// "ANSN" in the first bytes of the snapshots
+#define ANIMATION_SNAPSHOT_MAGIC 0x4E534E41u
+/// Flag of the snapshots only holding the animations that changed
+#define ANIMATION_SNAPSHOT_DELTA 1u
+
+/// @brief First bytes of a snapshot
+typedef struct AnimationSnapshotHeader
+{
+	unsigned int magic;
+	unsigned short version;
+	unsigned short recordSize;
+	unsigned int recordsNb;
+	unsigned int flags;
+	double globalClock;
+	/// Fraction of a tick left by the float updates of the system
+	double tickRemainder;
+} AnimationSnapshotHeader;
+
+/// @brief State of an animation, without padding so that records are
+/// compared byte for byte
+typedef struct AnimationSnapshotRecord
+{
+	double startTime;
+	/// Fraction of a tick left by the float updates of the animation
+	double tickFraction;
+	AnimationHandle handle;
+	sfVector2f position;
+	sfVector2f scale;
+	float rotation;
+	float clock;
+	/// Time not advanced yet by a lower level of detail
+	float lodTime;
+	unsigned int ticks;
+	unsigned int frameChangeTick;
+	sfColor color;
+	unsigned char currentFrame;
+	unsigned char state;
+	unsigned char isPlaying;
+	unsigned char lodPhase;
+	unsigned char reserved[4];
+} AnimationSnapshotRecord;
+
+size_t AnimationSystemGetSnapshotSize(const AnimationSystem* _system)
+{
+	return sizeof(AnimationSnapshotHeader) + sizeof(AnimationSnapshotRecord) * _system->count;
+}
+
+static void AnimationSnapshotWriteHeader(
+	const AnimationSystem* _system,
+	void* _buffer,
+	unsigned int _recordsNb,
+	unsigned int _flags)
+{
+	AnimationSnapshotHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = ANIMATION_SNAPSHOT_MAGIC;
+	header.version = ANIMATION_SNAPSHOT_VERSION;
+	header.recordSize = sizeof(AnimationSnapshotRecord);
+	header.recordsNb = _recordsNb;
+	header.flags = _flags;
+	header.globalClock = AnimationGetGlobalClock();
+	header.tickRemainder = _system->tickRemainder;
+	memcpy(_buffer, &header, sizeof(header));
+}
+
+// Read the header of a snapshot, sfFalse if it is not one
+static sfBool AnimationSnapshotReadHeader(
+	const void* _snapshot,
+	size_t _size,
+	AnimationSnapshotHeader* _header)
+{
+	if (_snapshot == NULL || _size < sizeof(AnimationSnapshotHeader))
+	{
+		return sfFalse;
+	}
+	memcpy(_header, _snapshot, sizeof(AnimationSnapshotHeader));
+	return _header->magic == ANIMATION_SNAPSHOT_MAGIC
+		&& _header->version == ANIMATION_SNAPSHOT_VERSION
+		&& _header->recordSize == sizeof(AnimationSnapshotRecord)
+		&& (_size - sizeof(AnimationSnapshotHeader)) / sizeof(AnimationSnapshotRecord)
+			>= _header->recordsNb;
+}
+
+static void AnimationSnapshotFillRecord(
+	AnimationSystem* _system,
+	unsigned int _index,
+	AnimationSnapshotRecord* _record)
+{
+	// Event-driven slots are caught up, as when their clock is read
+	if (_system->wheel != NULL)
+	{
+		AnimationSystemSync(_system, _index);
+	}
+	memset(_record, 0, sizeof(*_record));
+	_record->startTime = _system->startTime[_index];
+	_record->tickFraction = _system->tickFraction[_index];
+	_record->handle = AnimationGetHandle(_system->handles[_index]);
+	_record->position = _system->position[_index];
+	_record->scale = _system->scale[_index];
+	_record->rotation = _system->rotation[_index];
+	_record->clock = _system->clock[_index];
+	_record->lodTime = _system->lodTime[_index];
+	_record->ticks = _system->ticks[_index];
+	_record->frameChangeTick = _system->frameChangeTick[_index];
+	_record->color = _system->color[_index];
+	_record->currentFrame = _system->currentFrame[_index];
+	_record->state = _system->state[_index];
+	_record->isPlaying = _system->isPlaying[_index];
+	_record->lodPhase = _system->lodPhase[_index];
+}
+
+static void AnimationSnapshotRestoreRecord(
+	AnimationSystem* _system,
+	unsigned int _index,
+	const AnimationSnapshotRecord* _record)
+{
+	unsigned int i = _index;
+	sfSprite* sprite = _system->sprite[i];
+	// Nothing left to catch up from the state replaced
+	_system->lodTime[i] = 0;
+	_system->tickFraction[i] = _record->tickFraction;
+	_system->clockStamp[i] = _system->eventTime;
+	_system->state[i] = _record->state;
+	_system->clock[i] = _record->clock;
+	_system->startTime[i] = _record->startTime;
+	_system->currentFrame[i] = _record->currentFrame;
+	_system->isPlaying[i] = _record->isPlaying;
+	_system->lodPhase[i] = _record->lodPhase;
+
+	_system->position[i] = _record->position;
+	sfSprite_setPosition(sprite, _record->position);
+	sfSprite_setRotation(sprite, _record->rotation);
+	_system->rotation[i] = sfSprite_getRotation(sprite);
+	_system->scale[i] = _record->scale;
+	AnimationSystemSetFlipState(_system, i);
+	_system->color[i] = _record->color;
+	sfSprite_setColor(sprite, _record->color);
+	AnimationSystemUpdateBounds(_system, i);
+
+	_system->ticks[i] = _record->ticks;
+	_system->frameChangeTick[i] = _record->frameChangeTick;
+	_system->frameDirty[i] = sfTrue;
+	if (_system->tickRate > 0)
+	{
+		// The float clock follows the ticks
+		AnimationSystemSync(_system, i);
+	}
+	else
+	{
+		// Kept for the next update of its level of detail, caught up now
+		// if the slot is back at the full rate
+		_system->lodTime[i] = _record->lodTime;
+		if (_system->lodTier[i] == 0)
+		{
+			AnimationSystemSync(_system, i);
+		}
+		AnimationSystemSchedule(_system, i);
+	}
+	AnimationSystemComputeRects(_system, i, i + 1);
+	AnimationSystemApply(_system, i, i + 1);
+}
+
+size_t AnimationSystemSaveSnapshot(
+	AnimationSystem* _system,
+	void* _buffer,
+	size_t _bufferSize)
+{
+	size_t size = AnimationSystemGetSnapshotSize(_system);
+	if (_buffer == NULL || _bufferSize < size)
+	{
+		printf("Error : the snapshot buffer is too small !");
+		return 0;
+	}
+	unsigned char* records = (unsigned char*)_buffer + sizeof(AnimationSnapshotHeader);
+	for (unsigned int i = 0; i < _system->count; i++)
+	{
+		AnimationSnapshotRecord record;
+		AnimationSnapshotFillRecord(_system, i, &record);
+		memcpy(records + sizeof(record) * i, &record, sizeof(record));
+	}
+	AnimationSnapshotWriteHeader(_system, _buffer, _system->count, 0);
+	return size;
+}
+
+// Find the record of a handle in a snapshot, from the place it is expected at
+static const unsigned char* AnimationSnapshotFindRecord(
+	const unsigned char* _records,
+	unsigned int _recordsNb,
+	unsigned int _expected,
+	AnimationHandle _handle)
+{
+	for (unsigned int n = 0; n < _recordsNb; n++)
+	{
+		unsigned int j = _expected + n < _recordsNb ? _expected + n : _expected + n - _recordsNb;
+		AnimationSnapshotRecord record;
+		memcpy(&record, _records + sizeof(record) * j, sizeof(record));
+		if (record.handle.slot == _handle.slot && record.handle.generation == _handle.generation)
+		{
+			return _records + sizeof(record) * j;
+		}
+	}
+	return NULL;
+}
+
+size_t AnimationSystemSaveSnapshotDelta(
+	AnimationSystem* _system,
+	const void* _previous,
+	size_t _previousSize,
+	void* _buffer,
+	size_t _bufferSize)
+{
+	AnimationSnapshotHeader previous;
+	if (!AnimationSnapshotReadHeader(_previous, _previousSize, &previous)
+		|| previous.flags & ANIMATION_SNAPSHOT_DELTA)
+	{
+		printf("Error : the previous snapshot is not valid !");
+		return 0;
+	}
+	if (_buffer == NULL || _bufferSize < AnimationSystemGetSnapshotSize(_system))
+	{
+		printf("Error : the snapshot buffer is too small !");
+		return 0;
+	}
+	const unsigned char* previousRecords =
+		(const unsigned char*)_previous + sizeof(AnimationSnapshotHeader);
+	unsigned char* records = (unsigned char*)_buffer + sizeof(AnimationSnapshotHeader);
+	unsigned int recordsNb = 0;
+	for (unsigned int i = 0; i < _system->count; i++)
+	{
+		AnimationSnapshotRecord record;
+		AnimationSnapshotFillRecord(_system, i, &record);
+		const unsigned char* old = AnimationSnapshotFindRecord(
+			previousRecords, previous.recordsNb, i, record.handle);
+		if (old == NULL || memcmp(old, &record, sizeof(record)) != 0)
+		{
+			memcpy(records + sizeof(record) * recordsNb, &record, sizeof(record));
+			recordsNb++;
+		}
+	}
+	AnimationSnapshotWriteHeader(_system, _buffer, recordsNb, ANIMATION_SNAPSHOT_DELTA);
+	return sizeof(AnimationSnapshotHeader) + sizeof(AnimationSnapshotRecord) * recordsNb;
+}
+
+sfBool AnimationSystemRestoreSnapshot(
+	AnimationSystem* _system,
+	const void* _snapshot,
+	size_t _size)
+{
+	AnimationSnapshotHeader header;
+	if (!AnimationSnapshotReadHeader(_snapshot, _size, &header))
+	{
+		printf("Error : the snapshot is not valid !");
+		return sfFalse;
+	}
+	_system->tickRemainder = header.tickRemainder;
+
+	const unsigned char* records = (const unsigned char*)_snapshot + sizeof(AnimationSnapshotHeader);
+	for (unsigned int n = 0; n < header.recordsNb; n++)
+	{
+		AnimationSnapshotRecord record;
+		memcpy(&record, records + sizeof(record) * n, sizeof(record));
+		Animation* anim = AnimationHandleGet(record.handle);
+		if (anim != NULL && anim->system == _system)
+		{
+			AnimationSnapshotRestoreRecord(_system, anim->index, &record);
+		}
+	}
+	return sfTrue;
+}
+
+sfBool AnimationSnapshotRestoreGlobalClock(const void* _snapshot, size_t _size)
+{
+	AnimationSnapshotHeader header;
+	if (!AnimationSnapshotReadHeader(_snapshot, _size, &header))
+	{
+		printf("Error : the snapshot is not valid !");
+		return sfFalse;
+	}
+	AnimationSetGlobalClock(header.globalClock);
+	return sfTrue;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Config.h>
+#include <stddef.h>
+#include "AnimationSystem.h"
+
+/// Version written in the snapshots, restoring another one fails
+#define ANIMATION_SNAPSHOT_VERSION 2
+
+// A snapshot holds the playback state of the animations of a system
+// (clock, frame, state, playing flag, ticks and tick fractions), their
+// transform and color, and the global clock, in a header followed by one
+// fixed size record per animation. Records are in native byte order,
+// snapshots are meant to be restored by the same build, on the same
+// machine or on the peers of a rollback game.
+// Animations are found again by their generational handle, so a
+// snapshot restores the animations still alive in any order. The
+// animations created since are left as they are, the sprite sheets and
+// frame durations are not saved.
+// The global clock is shared by the lazy animations of every system, so
+// restoring a system leaves it as it is. A game rolling back the whole
+// world restores it once with AnimationSnapshotRestoreGlobalClock.
+// Replaying the same updates after a restore gives the same state bit
+// for bit, except in event-driven systems whose clocks are caught up
+// when saved, as when they are read.
+// Snapshots are written in a buffer given by the caller, nothing is
+// allocated.
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the size of a snapshot of a system
+///
+/// @param _system Animation system object
+///
+/// @return Size in bytes of a snapshot or a delta of the system
+//////////////////////////////////////////////////////////////
+size_t AnimationSystemGetSnapshotSize(const AnimationSystem* _system);
+
+//////////////////////////////////////////////////////////////
+/// @brief Save the state of every animation of a system
+///
+/// @param _system Animation system object
+///
+/// @param _buffer Filled with the snapshot
+///
+/// @param _bufferSize Size of the buffer, at least
+///					   AnimationSystemGetSnapshotSize
+///
+/// @return Size in bytes of the snapshot, 0 if the buffer is too small
+//////////////////////////////////////////////////////////////
+size_t AnimationSystemSaveSnapshot(
+	AnimationSystem* _system,
+	void* _buffer,
+	size_t _bufferSize);
+
+//////////////////////////////////////////////////////////////
+/// @brief Save the animations of a system that changed since a
+/// previous snapshot
+///
+/// Restoring the delta after the previous snapshot gives the same
+/// state as a full snapshot. Animations are compared at the same place
+/// first, then searched for when animations were removed in between.
+///
+/// @param _system Animation system object
+///
+/// @param _previous Snapshot returned by AnimationSystemSaveSnapshot
+///
+/// @param _previousSize Size of the previous snapshot
+///
+/// @param _buffer Filled with the delta
+///
+/// @param _bufferSize Size of the buffer, at least
+///					   AnimationSystemGetSnapshotSize
+///
+/// @return Size in bytes of the delta, 0 if the previous snapshot is
+///		 not valid or the buffer is too small
+//////////////////////////////////////////////////////////////
+size_t AnimationSystemSaveSnapshotDelta(
+	AnimationSystem* _system,
+	const void* _previous,
+	size_t _previousSize,
+	void* _buffer,
+	size_t _bufferSize);
+
+//////////////////////////////////////////////////////////////
+/// @brief Restore the animations of a system from a snapshot or a delta
+///
+/// The global clock is not changed, lazy animations are read from it.
+///
+/// @param _system Animation system object
+///
+/// @param _snapshot Snapshot or delta of the system
+///
+/// @param _size Size of the snapshot
+///
+/// @return sfTrue if the snapshot is restored, sfFalse if it is not valid
+//////////////////////////////////////////////////////////////
+sfBool AnimationSystemRestoreSnapshot(
+	AnimationSystem* _system,
+	const void* _snapshot,
+	size_t _size);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the global clock back to its time in a snapshot
+///
+/// Rewinds the lazy animations of every system, not only the ones of
+/// the system saved in the snapshot.
+///
+/// @param _snapshot Snapshot or delta of any system
+///
+/// @param _size Size of the snapshot
+///
+/// @return sfTrue if the global clock is restored, sfFalse if the
+///		   snapshot is not valid
+//////////////////////////////////////////////////////////////
+sfBool AnimationSnapshotRestoreGlobalClock(const void* _snapshot, size_t _size);
@@ -0,0 +1,548 @@
+#include "AnimationStream.h"
+#include "AnimationInternal.h"
+#include "AnimationProfiler.h"
+#include "SpriteSheetLoader.h"
+
+#include <SFML/Graphics.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Length of the path of a page file
+#define ANIMATION_STREAM_PATH_LENGTH 1024
+
+/// Page of a free resident page
+#define ANIMATION_STREAM_NO_PAGE UINT_MAX
+
+/// @brief Texture holding one page of the clip
+typedef struct AnimationStreamSlot
+{
+	sfTexture* texture;
+	/// Page held or being loaded, ANIMATION_STREAM_NO_PAGE when free
+	unsigned int page;
+	/// Decoding of the page, NULL once it is uploaded
+	SpriteSheetRequest* request;
+	/// Last streaming pass that needed the page
+	unsigned long long lastUse;
+} AnimationStreamSlot;
+
+struct AnimationStream
+{
+	char* pattern;
+	unsigned int framesNb;
+	unsigned int pageFramesNb;
+	/// Texture rects of the frames in a page
+	FrameTable* pageFrames;
+	AnimationStreamSlot* slots;
+	unsigned int slotsNb;
+	unsigned int prefetchFramesNb;
+
+	// Playback
+	double clock;
+	double framerate;
+	unsigned int currentFrame;
+	unsigned char state;
+	sfBool isPlaying;
+
+	// Display
+	sfSprite* sprite;
+	sfVector2f scale;
+	/// Frame on the sprite and the slot it is read from, none at first
+	unsigned int shownFrame;
+	unsigned int shownSlot;
+
+	/// Incremented by each streaming pass
+	unsigned long long useStamp;
+	unsigned int pageLoadsNb;
+	unsigned int lateUpdatesNb;
+};
+
+AnimationStream* AnimationStreamCreate(
+	const char* _pattern,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	unsigned int _pageColumns,
+	unsigned int _pageFramesNb,
+	unsigned int _residentPagesNb,
+	float _framerate)
+{
+	if (_framesNb == 0 || _pageColumns == 0 || _pageFramesNb == 0
+		|| _residentPagesNb < 2 || _framerate <= 0)
+	{
+		printf("Error : invalid streamed animation !");
+		return NULL;
+	}
+	AnimationStream* stream = (AnimationStream*)calloc(1, sizeof(AnimationStream));
+	if (stream == NULL)
+	{
+		printf("Error during memory allocation !");
+		return NULL;
+	}
+	stream->pattern = (char*)malloc(strlen(_pattern) + 1);
+	stream->slots = (AnimationStreamSlot*)calloc(_residentPagesNb, sizeof(AnimationStreamSlot));
+	if (stream->pattern == NULL || stream->slots == NULL)
+	{
+		printf("Error during memory allocation !");
+		AnimationStreamDestroy(stream);
+		return NULL;
+	}
+	strcpy(stream->pattern, _pattern);
+	stream->framesNb = _framesNb;
+	stream->pageFramesNb = _pageFramesNb;
+	stream->slotsNb = _residentPagesNb;
+	stream->prefetchFramesNb = _pageFramesNb;
+	stream->framerate = _framerate;
+	stream->state = DEFAULT;
+	stream->scale = (sfVector2f){ 1, 1 };
+	stream->shownFrame = ANIMATION_STREAM_NO_PAGE;
+
+	// Every page has the same layout, a single table gives the rects
+	sfVector2u pageLength = {
+		_pageColumns,
+		(_pageFramesNb + _pageColumns - 1) / _pageColumns
+	};
+	stream->pageFrames = FrameTableAcquire(
+		ANIMATION_LAYOUT_BLOCK, (sfVector2i){ 0, 0 }, _frameSize, _pageFramesNb, pageLength);
+	stream->sprite = sfSprite_create();
+	if (stream->pageFrames == NULL || stream->sprite == NULL)
+	{
+		printf("Error during cration of the streamed animation !");
+		AnimationStreamDestroy(stream);
+		return NULL;
+	}
+	sfSprite_setOrigin(stream->sprite,
+		(sfVector2f) { (float)_frameSize.x / 2, (float)_frameSize.y / 2 });
+
+	// The textures are created once and updated in place
+	for (unsigned int i = 0; i < _residentPagesNb; i++)
+	{
+		stream->slots[i].page = ANIMATION_STREAM_NO_PAGE;
+		stream->slots[i].texture = sfTexture_create(
+			pageLength.x * _frameSize.x, pageLength.y * _frameSize.y);
+		if (stream->slots[i].texture == NULL)
+		{
+			printf("Error during cration of the sprite sheet texture !");
+			AnimationStreamDestroy(stream);
+			return NULL;
+		}
+	}
+	return stream;
+}
+
+void AnimationStreamDestroy(AnimationStream* _stream)
+{
+	if (_stream == NULL)
+	{
+		return;
+	}
+	if (_stream->slots != NULL)
+	{
+		for (unsigned int i = 0; i < _stream->slotsNb; i++)
+		{
+			SpriteSheetRequestRelease(_stream->slots[i].request);
+			if (_stream->slots[i].texture != NULL)
+			{
+				sfTexture_destroy(_stream->slots[i].texture);
+			}
+		}
+	}
+	if (_stream->sprite != NULL)
+	{
+		sfSprite_destroy(_stream->sprite);
+	}
+	FrameTableRelease(_stream->pageFrames);
+	free(_stream->slots);
+	free(_stream->pattern);
+	free(_stream);
+}
+
+void AnimationStreamSetPrefetchFrames(AnimationStream* _stream, unsigned int _framesNb)
+{
+	_stream->prefetchFramesNb = _framesNb;
+}
+
+// Set the flipped scale on the sprite
+static void AnimationStreamSetFlipState(AnimationStream* _stream)
+{
+	sfVector2f scale = _stream->scale;
+	if (_stream->state & FLIP_X)
+	{
+		scale.x = -scale.x;
+	}
+	if (_stream->state & FLIP_Y)
+	{
+		scale.y = -scale.y;
+	}
+	sfSprite_setScale(_stream->sprite, scale);
+}
+
+void AnimationStreamPlay(AnimationStream* _stream, unsigned char _state)
+{
+	_stream->state = (unsigned char)(_state & ~LAZY);
+	_stream->isPlaying = sfTrue;
+	_stream->clock = 0;
+	_stream->currentFrame = 0;
+	if (_stream->state & REVERSED)
+	{
+		_stream->clock = (double)_stream->framesNb / _stream->framerate;
+		_stream->currentFrame = _stream->framesNb - 1;
+	}
+	AnimationStreamSetFlipState(_stream);
+}
+
+void AnimationStreamPause(AnimationStream* _stream)
+{
+	_stream->isPlaying = sfFalse;
+}
+
+void AnimationStreamSeek(AnimationStream* _stream, unsigned int _frame)
+{
+	_stream->currentFrame = _frame < _stream->framesNb ? _frame : _stream->framesNb - 1;
+	_stream->clock = (double)_stream->currentFrame / _stream->framerate;
+}
+
+// Advance the clock and the frame, as the animations of a system do
+static void AnimationStreamAdvance(AnimationStream* _stream, float _dt)
+{
+	if (!_stream->isPlaying)
+	{
+		return;
+	}
+	double duration = (double)_stream->framesNb / _stream->framerate;
+	if (_stream->state & REVERSED)
+	{
+		_stream->clock -= _dt;
+		double nextFrame = floor(_stream->clock * _stream->framerate);
+		if (_stream->clock < 0 && nextFrame < 0)
+		{
+			if (_stream->state & LOOPED)
+			{
+				_stream->clock = duration;
+				_stream->currentFrame = _stream->framesNb - 1;
+			}
+			else
+			{
+				_stream->isPlaying = sfFalse;
+				_stream->currentFrame = 0;
+			}
+		}
+		else
+		{
+			// The clock starts at the end of the clip, in its last frame
+			_stream->currentFrame = nextFrame < (double)_stream->framesNb
+				? (unsigned int)nextFrame
+				: _stream->framesNb - 1;
+		}
+	}
+	else
+	{
+		_stream->clock += _dt;
+		double nextFrame = floor(_stream->clock * _stream->framerate);
+		if (_stream->clock > duration && nextFrame > (double)_stream->framesNb - 1)
+		{
+			if (_stream->state & LOOPED)
+			{
+				_stream->clock = 0;
+				_stream->currentFrame = 0;
+			}
+			else
+			{
+				_stream->isPlaying = sfFalse;
+				_stream->currentFrame = _stream->framesNb - 1;
+			}
+		}
+		else
+		{
+			// The end of the clip is in its last frame
+			_stream->currentFrame = nextFrame < (double)_stream->framesNb
+				? (unsigned int)nextFrame
+				: _stream->framesNb - 1;
+		}
+	}
+}
+
+// Slot holding a page, NULL if it is not resident nor loading
+static AnimationStreamSlot* AnimationStreamFindSlot(AnimationStream* _stream, unsigned int _page)
+{
+	for (unsigned int i = 0; i < _stream->slotsNb; i++)
+	{
+		if (_stream->slots[i].page == _page)
+		{
+			return &_stream->slots[i];
+		}
+	}
+	return NULL;
+}
+
+// Least recently used slot not needed by this pass nor shown, free ones first
+static AnimationStreamSlot* AnimationStreamFindVictim(AnimationStream* _stream)
+{
+	AnimationStreamSlot* victim = NULL;
+	for (unsigned int i = 0; i < _stream->slotsNb; i++)
+	{
+		AnimationStreamSlot* slot = &_stream->slots[i];
+		if (slot->lastUse == _stream->useStamp
+			|| (i == _stream->shownSlot && _stream->shownFrame != ANIMATION_STREAM_NO_PAGE))
+		{
+			continue;
+		}
+		if (slot->page == ANIMATION_STREAM_NO_PAGE)
+		{
+			return slot;
+		}
+		if (victim == NULL || slot->lastUse < victim->lastUse)
+		{
+			victim = slot;
+		}
+	}
+	return victim;
+}
+
+// Make a page resident or loading, sfFalse if no slot can take it
+static sfBool AnimationStreamRequestPage(AnimationStream* _stream, unsigned int _page)
+{
+	AnimationStreamSlot* slot = AnimationStreamFindSlot(_stream, _page);
+	if (slot != NULL)
+	{
+		slot->lastUse = _stream->useStamp;
+		return sfTrue;
+	}
+	slot = AnimationStreamFindVictim(_stream);
+	if (slot == NULL)
+	{
+		return sfFalse;
+	}
+	char path[ANIMATION_STREAM_PATH_LENGTH];
+	snprintf(path, sizeof(path), _stream->pattern, _page);
+	SpriteSheetRequestRelease(slot->request);
+	slot->request = SpriteSheetLoaderRequestImage(path, NULL);
+	slot->page = slot->request != NULL ? _page : ANIMATION_STREAM_NO_PAGE;
+	slot->lastUse = _stream->useStamp;
+	return slot->request != NULL;
+}
+
+// Request the pages from the current frame to the prefetch distance,
+// in the direction of play
+static void AnimationStreamPrefetch(AnimationStream* _stream)
+{
+	_stream->useStamp++;
+	sfBool reversed = (_stream->state & REVERSED) != 0;
+	unsigned int frame = _stream->currentFrame;
+	unsigned int firstPage = frame / _stream->pageFramesNb;
+	unsigned long long distance = 0;
+	for (unsigned int requested = 0; requested < _stream->slotsNb; requested++)
+	{
+		unsigned int page = frame / _stream->pageFramesNb;
+		if ((requested > 0 && page == firstPage) || !AnimationStreamRequestPage(_stream, page))
+		{
+			return;
+		}
+
+		// First frame of the next page in the direction of play
+		unsigned int next = 0;
+		if (reversed)
+		{
+			distance += frame - page * _stream->pageFramesNb + 1;
+			if (page == 0 && !(_stream->state & LOOPED))
+			{
+				return;
+			}
+			next = page > 0 ? page * _stream->pageFramesNb - 1 : _stream->framesNb - 1;
+		}
+		else
+		{
+			next = (page + 1) * _stream->pageFramesNb;
+			distance += next - frame;
+			if (next >= _stream->framesNb)
+			{
+				if (!(_stream->state & LOOPED))
+				{
+					return;
+				}
+				next = 0;
+			}
+		}
+		if (distance > _stream->prefetchFramesNb)
+		{
+			return;
+		}
+		frame = next;
+	}
+}
+
+// Upload the pages decoded so far into their textures
+static void AnimationStreamUpload(AnimationStream* _stream)
+{
+	SpriteSheetLoaderUpload();
+	for (unsigned int i = 0; i < _stream->slotsNb; i++)
+	{
+		AnimationStreamSlot* slot = &_stream->slots[i];
+		if (slot->request == NULL)
+		{
+			continue;
+		}
+		switch (SpriteSheetRequestGetState(slot->request))
+		{
+		case SPRITE_SHEET_READY:
+			ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_LOAD);
+			sfTexture_updateFromImage(slot->texture, SpriteSheetRequestGetImage(slot->request), 0, 0);
+			ANIMATION_PROFILE_END(ANIMATION_PROFILER_LOAD);
+			ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_TEXTURE_LOADS, 1);
+			_stream->pageLoadsNb++;
+			SpriteSheetRequestRelease(slot->request);
+			slot->request = NULL;
+			break;
+		case SPRITE_SHEET_FAILED:
+			printf("Error during cration of the sprite sheet texture !");
+			SpriteSheetRequestRelease(slot->request);
+			slot->request = NULL;
+			slot->page = ANIMATION_STREAM_NO_PAGE;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+// Show the current frame if its page is resident
+static void AnimationStreamShowFrame(AnimationStream* _stream)
+{
+	if (_stream->shownFrame == _stream->currentFrame)
+	{
+		return;
+	}
+	AnimationStreamSlot* slot = AnimationStreamFindSlot(
+		_stream, _stream->currentFrame / _stream->pageFramesNb);
+	if (slot == NULL || slot->request != NULL)
+	{
+		_stream->lateUpdatesNb++;
+		return;
+	}
+	unsigned int slotIndex = (unsigned int)(slot - _stream->slots);
+	if (_stream->shownFrame == ANIMATION_STREAM_NO_PAGE || slotIndex != _stream->shownSlot)
+	{
+		sfSprite_setTexture(_stream->sprite, slot->texture, sfFalse);
+	}
+	sfSprite_setTextureRect(
+		_stream->sprite,
+		FrameTableGetRect(_stream->pageFrames, _stream->currentFrame % _stream->pageFramesNb));
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_TEXTURE_RECTS, 1);
+	_stream->shownFrame = _stream->currentFrame;
+	_stream->shownSlot = slotIndex;
+}
+
+void AnimationStreamUpdate(AnimationStream* _stream, float _dt)
+{
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_UPDATE);
+	AnimationStreamAdvance(_stream, _dt);
+	AnimationStreamPrefetch(_stream);
+	AnimationStreamUpload(_stream);
+	AnimationStreamShowFrame(_stream);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_UPDATES, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_UPDATE);
+}
+
+void AnimationStreamWait(AnimationStream* _stream)
+{
+	AnimationStreamPrefetch(_stream);
+	SpriteSheetLoaderFlush();
+	AnimationStreamUpload(_stream);
+	AnimationStreamShowFrame(_stream);
+}
+
+sfBool AnimationStreamIsFrameReady(const AnimationStream* _stream)
+{
+	return _stream->shownFrame == _stream->currentFrame;
+}
+
+unsigned int AnimationStreamGetCurrentFrame(const AnimationStream* _stream)
+{
+	return _stream->currentFrame;
+}
+
+unsigned int AnimationStreamGetFramesNb(const AnimationStream* _stream)
+{
+	return _stream->framesNb;
+}
+
+sfBool AnimationStreamIsPlaying(const AnimationStream* _stream)
+{
+	return _stream->isPlaying;
+}
+
+unsigned int AnimationStreamGetPageLoadsNb(const AnimationStream* _stream)
+{
+	return _stream->pageLoadsNb;
+}
+
+unsigned int AnimationStreamGetLateUpdatesNb(const AnimationStream* _stream)
+{
+	return _stream->lateUpdatesNb;
+}
+
+const sfTexture* AnimationStreamGetTexture(const AnimationStream* _stream)
+{
+	if (_stream->shownFrame == ANIMATION_STREAM_NO_PAGE)
+	{
+		return NULL;
+	}
+	return _stream->slots[_stream->shownSlot].texture;
+}
+
+sfIntRect AnimationStreamGetTextureRect(const AnimationStream* _stream)
+{
+	return sfSprite_getTextureRect(_stream->sprite);
+}
+
+void AnimationStreamSetPosition(AnimationStream* _stream, sfVector2f _position)
+{
+	sfSprite_setPosition(_stream->sprite, _position);
+}
+
+void AnimationStreamSetRotation(AnimationStream* _stream, float _angle)
+{
+	sfSprite_setRotation(_stream->sprite, _angle);
+}
+
+void AnimationStreamSetScale(AnimationStream* _stream, sfVector2f _scale)
+{
+	_stream->scale = _scale;
+	AnimationStreamSetFlipState(_stream);
+}
+
+void AnimationStreamSetColor(AnimationStream* _stream, sfColor _color)
+{
+	sfSprite_setColor(_stream->sprite, _color);
+}
+
+void AnimationStreamDraw(
+	const sfRenderWindow* _window,
+	const AnimationStream* _stream,
+	const sfRenderStates* _states)
+{
+	if (_stream->shownFrame == ANIMATION_STREAM_NO_PAGE)
+	{
+		return;
+	}
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_DRAW);
+	sfRenderWindow_drawSprite((sfRenderWindow*)_window, _stream->sprite, _states);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_DRAW_CALLS, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_DRAW);
+}
+
+void AnimationStreamDrawRenderTex(
+	const sfRenderTexture* _renderTex,
+	const AnimationStream* _stream,
+	const sfRenderStates* _states)
+{
+	if (_stream->shownFrame == ANIMATION_STREAM_NO_PAGE)
+	{
+		return;
+	}
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_DRAW);
+	sfRenderTexture_drawSprite((sfRenderTexture*)_renderTex, _stream->sprite, _states);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_DRAW_CALLS, 1);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_DRAW);
+}
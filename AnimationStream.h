@@ -0,0 +1,265 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "Animation.h"
+
+// A streamed animation plays clips too long to be loaded at once, up to
+// 4 billion frames, such as cinematics or high resolution animations.
+// Its frames are split in pages, one image file per page numbered from
+// 0, each page holding its frames row after row. Only a fixed number of
+// pages are resident, in textures created once and updated in place :
+// the pages ahead of the playhead are decoded in the background by the
+// sprite sheet loader, through the on-disk cache when it is enabled,
+// and replace the least recently used pages. The memory used does not
+// depend on the length of the clip.
+// When the page of the current frame is late, the last frame shown
+// stays on screen and the clock keeps running.
+
+typedef struct AnimationStream AnimationStream;
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a streamed animation
+///
+/// Nothing is loaded before the first update.
+///
+/// @param _pattern Path of the page files, with a printf conversion of
+///				    the page index, such as "intro/page%03u.png"
+///
+/// @param _frameSize Size of a frame
+///
+/// @param _framesNb Number of frames of the clip
+///
+/// @param _pageColumns Frames per row of a page
+///
+/// @param _pageFramesNb Frames per page, the last page can hold less
+///
+/// @param _residentPagesNb Number of pages kept in textures, at least 2
+///
+/// @param _framerate Frames played per second
+///
+/// @return Streamed animation object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+AnimationStream* AnimationStreamCreate(
+	const char* _pattern,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	unsigned int _pageColumns,
+	unsigned int _pageFramesNb,
+	unsigned int _residentPagesNb,
+	float _framerate);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy a streamed animation and its textures
+///
+/// @param _stream Streamed animation object, NULL is ignored
+//////////////////////////////////////////////////////////////
+void AnimationStreamDestroy(AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set how far ahead of the playhead the pages are loaded
+///
+/// Pages are only loaded ahead as long as there are resident pages
+/// not needed by the frames in between.
+///
+/// @param _stream Streamed animation object
+///
+/// @param _framesNb Frames after the current one, in the direction of
+///				     play, whose pages are loaded. One page by default
+//////////////////////////////////////////////////////////////
+void AnimationStreamSetPrefetchFrames(AnimationStream* _stream, unsigned int _framesNb);
+
+//////////////////////////////////////////////////////////////
+/// @brief Play a streamed animation with the given state from its start
+///
+/// @param _stream Streamed animation object
+///
+/// @param _state Combination of LOOPED, REVERSED, FLIP_X and FLIP_Y
+//////////////////////////////////////////////////////////////
+void AnimationStreamPlay(AnimationStream* _stream, unsigned char _state);
+
+//////////////////////////////////////////////////////////////
+/// @brief Pause a streamed animation
+///
+/// @param _stream Streamed animation object
+//////////////////////////////////////////////////////////////
+void AnimationStreamPause(AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Move the playhead of a streamed animation to a frame
+///
+/// The pages of the frame are loaded by the next update.
+///
+/// @param _stream Streamed animation object
+///
+/// @param _frame Frame index, clamped to the clip
+//////////////////////////////////////////////////////////////
+void AnimationStreamSeek(AnimationStream* _stream, unsigned int _frame);
+
+//////////////////////////////////////////////////////////////
+/// @brief Update a streamed animation
+///
+/// Advances the clock, loads the pages ahead of the playhead, uploads
+/// the pages decoded so far and shows the current frame once its page
+/// is resident. Must be called from the thread owning the OpenGL
+/// context, also while paused for the pages to keep loading.
+///
+/// @param _stream Streamed animation object
+///
+/// @param _dt Delta time
+//////////////////////////////////////////////////////////////
+void AnimationStreamUpdate(AnimationStream* _stream, float _dt);
+
+//////////////////////////////////////////////////////////////
+/// @brief Wait for the pages ahead of the playhead to be loaded
+///
+/// For the start of a clip or after a seek, when showing a late frame
+/// is worse than waiting.
+///
+/// @param _stream Streamed animation object
+//////////////////////////////////////////////////////////////
+void AnimationStreamWait(AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if the current frame of a streamed animation is shown
+///
+/// @param _stream Streamed animation object
+///
+/// @return sfTrue if its page is resident, sfFalse while it is loading
+//////////////////////////////////////////////////////////////
+sfBool AnimationStreamIsFrameReady(const AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the current frame of a streamed animation
+///
+/// @param _stream Streamed animation object
+///
+/// @return Frame index
+//////////////////////////////////////////////////////////////
+unsigned int AnimationStreamGetCurrentFrame(const AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of frames of a streamed animation
+///
+/// @param _stream Streamed animation object
+///
+/// @return Number of frames
+//////////////////////////////////////////////////////////////
+unsigned int AnimationStreamGetFramesNb(const AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if a streamed animation is playing
+///
+/// @param _stream Streamed animation object
+///
+/// @return sfTrue if it is playing, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationStreamIsPlaying(const AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of pages uploaded since a streamed animation
+/// was created
+///
+/// @param _stream Streamed animation object
+///
+/// @return Number of pages uploaded
+//////////////////////////////////////////////////////////////
+unsigned int AnimationStreamGetPageLoadsNb(const AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of updates that could not show the current
+/// frame of a streamed animation because its page was late
+///
+/// @param _stream Streamed animation object
+///
+/// @return Number of late updates
+//////////////////////////////////////////////////////////////
+unsigned int AnimationStreamGetLateUpdatesNb(const AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the texture of the page shown by a streamed animation
+///
+/// The texture is updated in place when its page is replaced.
+///
+/// @param _stream Streamed animation object
+///
+/// @return Texture of the page, NULL until a frame is shown
+//////////////////////////////////////////////////////////////
+const sfTexture* AnimationStreamGetTexture(const AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the texture rect of the frame shown by a streamed animation
+///
+/// @param _stream Streamed animation object
+///
+/// @return Texture rect in its page
+//////////////////////////////////////////////////////////////
+sfIntRect AnimationStreamGetTextureRect(const AnimationStream* _stream);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the position of a streamed animation
+///
+/// @param _stream Streamed animation object
+///
+/// @param _position New position
+//////////////////////////////////////////////////////////////
+void AnimationStreamSetPosition(AnimationStream* _stream, sfVector2f _position);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the orientation of a streamed animation
+///
+/// @param _stream Streamed animation object
+///
+/// @param _angle New rotation, in degrees
+//////////////////////////////////////////////////////////////
+void AnimationStreamSetRotation(AnimationStream* _stream, float _angle);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the scale factors of a streamed animation
+///
+/// @param _stream Streamed animation object
+///
+/// @param _scale New scale factors, flipped by the state
+//////////////////////////////////////////////////////////////
+void AnimationStreamSetScale(AnimationStream* _stream, sfVector2f _scale);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the global color of a streamed animation
+///
+/// @param _stream Streamed animation object
+///
+/// @param _color New color
+//////////////////////////////////////////////////////////////
+void AnimationStreamSetColor(AnimationStream* _stream, sfColor _color);
+
+//////////////////////////////////////////////////////////////
+/// @brief Draw a streamed animation
+///
+/// Nothing is drawn until a frame is shown.
+///
+/// @param _window Render window object
+///
+/// @param _stream Streamed animation object
+///
+/// @param _states Render states to use, NULL to use the default states
+//////////////////////////////////////////////////////////////
+void AnimationStreamDraw(
+	const sfRenderWindow* _window,
+	const AnimationStream* _stream,
+	const sfRenderStates* _states);
+
+//////////////////////////////////////////////////////////////
+/// @brief Draw a streamed animation on a render texture
+///
+/// @param _renderTex Render texture object
+///
+/// @param _stream Streamed animation object
+///
+/// @param _states Render states to use, NULL to use the default states
+//////////////////////////////////////////////////////////////
+void AnimationStreamDrawRenderTex(
+	const sfRenderTexture* _renderTex,
+	const AnimationStream* _stream,
+	const sfRenderStates* _states);
@@ -0,0 +1,319 @@
+#include "AnimationSync.h"
+#include "AnimationHandle.h"
+#include "AnimationInternal.h"
+#include "AnimationProfiler.h"
+
+#include <SFML/Graphics.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Animation of a sync group
+typedef struct AnimationSyncMember
+{
+	AnimationHandle handle;
+	unsigned char frameOffset;
+} AnimationSyncMember;
+
+struct AnimationSyncGroup
+{
+	AnimationSyncMember* members;
+	unsigned int membersNb;
+	unsigned int membersCapacity;
+
+	// Clip of the first member
+	float duration;
+	unsigned char framesNb;
+	/// Frame table of the first member when it has frame durations
+	FrameTable* times;
+
+	// Playback
+	float clock;
+	unsigned char currentFrame;
+	unsigned char state;
+	sfBool isPlaying;
+};
+
+AnimationSyncGroup* AnimationSyncGroupCreate(void)
+{
+	AnimationSyncGroup* group = calloc(1, sizeof(AnimationSyncGroup));
+	if (group == NULL)
+	{
+		printf("Error during cration of the sync group !");
+	}
+	return group;
+}
+
+// Start of a frame relative to the clip, from the frame table when the
+// frames have their own durations
+static double AnimationSyncGroupGetFrameStart(
+	const FrameTable* _times,
+	unsigned int _framesNb,
+	unsigned int _frame)
+{
+	if (_times != NULL && _times->times != NULL)
+	{
+		return _times->times[_frame];
+	}
+	return (double)_frame / (double)_framesNb;
+}
+
+// Clock of the group shifted by the frame offset of a member, at the same
+// place in the frame of the member as the group in its own frame
+static float AnimationSyncGroupGetMemberClock(
+	const AnimationSyncGroup* _group,
+	const AnimationSystem* _system,
+	unsigned int _index,
+	unsigned char _frameOffset)
+{
+	float duration = _system->duration[_index];
+	unsigned int framesNb = _system->framesNb[_index];
+	if (_frameOffset == 0 || framesNb == 0 || _group->framesNb == 0
+		|| duration <= 0 || _group->duration <= 0)
+	{
+		return _group->clock;
+	}
+	unsigned int groupFrame = _group->currentFrame < _group->framesNb
+		? _group->currentFrame
+		: _group->framesNb - 1u;
+	double groupStart = AnimationSyncGroupGetFrameStart(
+		_group->times, _group->framesNb, groupFrame);
+	double groupLength = AnimationSyncGroupGetFrameStart(
+		_group->times, _group->framesNb, groupFrame + 1) - groupStart;
+	double progression = (double)_group->clock / (double)_group->duration - groupStart;
+	double place = groupLength > 0 ? progression / groupLength : 0.0;
+	place = place < 0.0 ? 0.0 : place > 1.0 ? 1.0 : place;
+
+	unsigned int frame = (groupFrame + _frameOffset) % framesNb;
+	const FrameTable* table = _system->frameTable[_index];
+	double start = AnimationSyncGroupGetFrameStart(table, framesNb, frame);
+	double length = AnimationSyncGroupGetFrameStart(table, framesNb, frame + 1) - start;
+	return (float)((start + place * length) * (double)duration);
+}
+
+// Show the frame and clock of the group on a member
+static void AnimationSyncGroupShow(
+	const AnimationSyncGroup* _group,
+	const Animation* _anim,
+	unsigned char _frameOffset)
+{
+	AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	unsigned int framesNb = system->framesNb[i] > 0 ? system->framesNb[i] : 1;
+	system->currentFrame[i] = (unsigned char)(
+		((unsigned int)_group->currentFrame + _frameOffset) % framesNb);
+	system->clock[i] = AnimationSyncGroupGetMemberClock(_group, system, i, _frameOffset);
+	if (system->tickRate > 0)
+	{
+		// The float clock is read from the ticks in tick mode
+		AnimationSystemSchedule(system, i);
+	}
+
+	// Culled members are set once they are seen again
+	if (AnimationSystemIsVisible(system, i))
+	{
+		AnimationSystemFrameUpdate(system, i);
+	}
+	else
+	{
+		system->frameDirty[i] = sfTrue;
+	}
+}
+
+// Give a member back its own playback, at the clock of the group
+static void AnimationSyncGroupRelease(
+	const AnimationSyncGroup* _group,
+	Animation* _anim,
+	unsigned char _frameOffset)
+{
+	AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	system->clock[i] = AnimationSyncGroupGetMemberClock(_group, system, i, _frameOffset);
+	system->state[i] = (unsigned char)((system->state[i] & ~(LOOPED | REVERSED))
+		| (_group->state & (LOOPED | REVERSED)));
+	system->isPlaying[i] = (unsigned char)_group->isPlaying;
+	AnimationSystemSchedule(system, i);
+}
+
+void AnimationSyncGroupDestroy(AnimationSyncGroup* _group)
+{
+	if (_group == NULL)
+	{
+		return;
+	}
+	for (unsigned int m = 0; m < _group->membersNb; m++)
+	{
+		Animation* anim = AnimationHandleGet(_group->members[m].handle);
+		if (anim != NULL)
+		{
+			AnimationSyncGroupRelease(_group, anim, _group->members[m].frameOffset);
+		}
+	}
+	FrameTableRelease(_group->times);
+	free(_group->members);
+	free(_group);
+}
+
+sfBool AnimationSyncGroupJoin(
+	AnimationSyncGroup* _group,
+	Animation* _anim,
+	unsigned char _frameOffset)
+{
+	AnimationSystem* system = _anim->system;
+	unsigned int i = _anim->index;
+	if (system->frameTable[i] == NULL)
+	{
+		printf("Error : set a sprite sheet before joining a sync group !");
+		return sfFalse;
+	}
+	if (_group->membersNb == _group->membersCapacity)
+	{
+		unsigned int capacity = _group->membersCapacity > 0 ? _group->membersCapacity * 2 : 16;
+		AnimationSyncMember* members = realloc(
+			_group->members, capacity * sizeof(AnimationSyncMember));
+		if (members == NULL)
+		{
+			printf("Error during cration of the sync group members !");
+			return sfFalse;
+		}
+		_group->members = members;
+		_group->membersCapacity = capacity;
+	}
+
+	// Resolve the clock of the animation, then stop its own playback
+	AnimationSystemSync(system, i);
+	sfBool playing = AnimationIsPlaying(_anim);
+	AnimationSystemSetState(system, i, system->state[i] & ~LAZY);
+	if (_group->membersNb == 0)
+	{
+		_group->duration = system->duration[i];
+		_group->framesNb = system->framesNb[i];
+		// The table of a previous first member, the group was emptied
+		FrameTableRelease(_group->times);
+		_group->times = system->frameTable[i]->times != NULL
+			? FrameTableRetain(system->frameTable[i])
+			: NULL;
+		_group->clock = system->clock[i];
+		_group->currentFrame = system->currentFrame[i];
+		_group->state = system->state[i] & (LOOPED | REVERSED);
+		_group->isPlaying = playing;
+	}
+	system->isPlaying[i] = sfFalse;
+	AnimationSystemSchedule(system, i);
+
+	_group->members[_group->membersNb].handle = AnimationGetHandle(_anim);
+	_group->members[_group->membersNb].frameOffset = _frameOffset;
+	_group->membersNb++;
+	AnimationSyncGroupShow(_group, _anim, _frameOffset);
+	return sfTrue;
+}
+
+void AnimationSyncGroupLeave(AnimationSyncGroup* _group, Animation* _anim)
+{
+	AnimationHandle handle = AnimationGetHandle(_anim);
+	for (unsigned int m = 0; m < _group->membersNb; m++)
+	{
+		if (_group->members[m].handle.slot == handle.slot
+			&& _group->members[m].handle.generation == handle.generation)
+		{
+			AnimationSyncGroupRelease(_group, _anim, _group->members[m].frameOffset);
+			_group->members[m] = _group->members[--_group->membersNb];
+			return;
+		}
+	}
+}
+
+// Show the frame of the group on every member, dropping the members
+// gone or played on their own
+static void AnimationSyncGroupShowAll(AnimationSyncGroup* _group)
+{
+	unsigned int m = 0;
+	while (m < _group->membersNb)
+	{
+		AnimationSyncMember* member = &_group->members[m];
+		Animation* anim = AnimationHandleGet(member->handle);
+		if (anim == NULL
+			|| anim->system->isPlaying[anim->index]
+			|| anim->system->state[anim->index] & LAZY)
+		{
+			*member = _group->members[--_group->membersNb];
+			continue;
+		}
+		AnimationSyncGroupShow(_group, anim, member->frameOffset);
+		m++;
+	}
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_FRAME_CHANGES, _group->membersNb);
+}
+
+void AnimationSyncGroupPlay(AnimationSyncGroup* _group, unsigned char _state)
+{
+	_group->state = _state & (LOOPED | REVERSED);
+	_group->isPlaying = sfTrue;
+	if (_group->state & REVERSED)
+	{
+		_group->clock = _group->duration;
+	}
+}
+
+void AnimationSyncGroupPause(AnimationSyncGroup* _group)
+{
+	_group->isPlaying = sfFalse;
+}
+
+void AnimationSyncGroupStop(AnimationSyncGroup* _group)
+{
+	_group->isPlaying = sfFalse;
+	_group->clock = 0;
+	_group->currentFrame = 0;
+	if (_group->state & REVERSED)
+	{
+		_group->clock = _group->duration;
+		_group->currentFrame = _group->framesNb > 0 ? _group->framesNb - 1 : 0;
+	}
+	AnimationSyncGroupShowAll(_group);
+}
+
+void AnimationSyncGroupUpdate(AnimationSyncGroup* _group, float _dt)
+{
+	if (!_group->isPlaying || _group->membersNb == 0)
+	{
+		return;
+	}
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_UPDATE);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_UPDATES, 1);
+	unsigned char frame = _group->currentFrame;
+	_group->isPlaying = AnimationStep(
+		&_group->clock,
+		&_group->currentFrame,
+		_group->state,
+		_group->duration,
+		_group->framesNb,
+		_group->times,
+		_dt);
+
+	// The members only change with the frame of the group
+	if (_group->currentFrame != frame)
+	{
+		AnimationSyncGroupShowAll(_group);
+	}
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_UPDATE);
+}
+
+unsigned char AnimationSyncGroupGetCurrentFrame(const AnimationSyncGroup* _group)
+{
+	return _group->currentFrame;
+}
+
+float AnimationSyncGroupGetClock(const AnimationSyncGroup* _group)
+{
+	return _group->clock;
+}
+
+sfBool AnimationSyncGroupIsPlaying(const AnimationSyncGroup* _group)
+{
+	return _group->isPlaying;
+}
+
+unsigned int AnimationSyncGroupGetMembersNb(const AnimationSyncGroup* _group)
+{
+	return _group->membersNb;
+}
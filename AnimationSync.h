@@ -0,0 +1,147 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "Animation.h"
+
+// A sync group plays animations in lockstep, such as crowds, flags or
+// torches : the group has a single clock and finds a single frame, its
+// members only show it, shifted by their frame offset. Members are
+// paused in their animation system, which does not advance them, and
+// the group only touches them when its frame changes, so updating a
+// group of any size costs one clock update most of the time.
+// The clip of the group, its duration, number of frames and frame
+// durations, is the one of its first member. Members keep their own
+// sprite sheet, transform and flip state.
+// The clock of a member, as read by AnimationGetClock or saved in a
+// snapshot, is the one of the group at its last frame change, shifted by
+// its frame offset. It only follows the group at the frame changes.
+// Playing a member on its own takes it out of its group, a member
+// destroyed is removed from its group too.
+
+typedef struct AnimationSyncGroup AnimationSyncGroup;
+
+//////////////////////////////////////////////////////////////
+/// @brief Create an empty sync group
+///
+/// @return Sync group object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+AnimationSyncGroup* AnimationSyncGroupCreate(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy a sync group
+///
+/// Its members leave it as with AnimationSyncGroupLeave.
+///
+/// @param _group Sync group object, NULL is ignored
+//////////////////////////////////////////////////////////////
+void AnimationSyncGroupDestroy(AnimationSyncGroup* _group);
+
+//////////////////////////////////////////////////////////////
+/// @brief Add an animation to a sync group
+///
+/// The first member gives the group its clip, its clock and whether it
+/// is playing. The animation must not be in another group.
+///
+/// @param _group Sync group object
+///
+/// @param _anim Animation object, with a sprite sheet
+///
+/// @param _frameOffset Frames the member is ahead of the group
+///
+/// @return sfTrue if the animation joined the group, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationSyncGroupJoin(
+	AnimationSyncGroup* _group,
+	Animation* _anim,
+	unsigned char _frameOffset);
+
+//////////////////////////////////////////////////////////////
+/// @brief Remove an animation from a sync group
+///
+/// The animation goes on from the clock of the group, shifted by its
+/// frame offset, and plays if the group does.
+///
+/// @param _group Sync group object
+///
+/// @param _anim Animation object, ignored if it is not a member
+//////////////////////////////////////////////////////////////
+void AnimationSyncGroupLeave(AnimationSyncGroup* _group, Animation* _anim);
+
+//////////////////////////////////////////////////////////////
+/// @brief Play a sync group
+///
+/// @param _group Sync group object
+///
+/// @param _state Combination of LOOPED and REVERSED, the flips are the
+///				 ones of each member
+//////////////////////////////////////////////////////////////
+void AnimationSyncGroupPlay(AnimationSyncGroup* _group, unsigned char _state);
+
+//////////////////////////////////////////////////////////////
+/// @brief Pause a sync group
+///
+/// @param _group Sync group object
+//////////////////////////////////////////////////////////////
+void AnimationSyncGroupPause(AnimationSyncGroup* _group);
+
+//////////////////////////////////////////////////////////////
+/// @brief Stop a sync group and show its first frame
+///
+/// @param _group Sync group object
+//////////////////////////////////////////////////////////////
+void AnimationSyncGroupStop(AnimationSyncGroup* _group);
+
+//////////////////////////////////////////////////////////////
+/// @brief Update a sync group
+///
+/// Advances the clock of the group, then sets the frame of its members
+/// only if the frame of the group changed. Members out of the view of a
+/// culled system show their frame once they are seen again.
+///
+/// @param _group Sync group object
+///
+/// @param _dt Delta time
+//////////////////////////////////////////////////////////////
+void AnimationSyncGroupUpdate(AnimationSyncGroup* _group, float _dt);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the current frame of a sync group
+///
+/// @param _group Sync group object
+///
+/// @return Frame of the group, members with an offset show another one
+//////////////////////////////////////////////////////////////
+unsigned char AnimationSyncGroupGetCurrentFrame(const AnimationSyncGroup* _group);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the clock of a sync group
+///
+/// @param _group Sync group object
+///
+/// @return Time elapsed in the clip of the group
+//////////////////////////////////////////////////////////////
+float AnimationSyncGroupGetClock(const AnimationSyncGroup* _group);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if a sync group is playing
+///
+/// @param _group Sync group object
+///
+/// @return sfTrue if it is playing, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationSyncGroupIsPlaying(const AnimationSyncGroup* _group);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of members of a sync group
+///
+/// Members destroyed or played on their own are only counted until the
+/// next frame change of the group.
+///
+/// @param _group Sync group object
+///
+/// @return Number of members
+//////////////////////////////////////////////////////////////
+unsigned int AnimationSyncGroupGetMembersNb(const AnimationSyncGroup* _group);
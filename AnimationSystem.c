@@ -0,0 +1,1579 @@
+#include "AnimationSystem.h"
+#include "AnimationCollision.h"
+#include "AnimationInternal.h"
+#include "AnimationKernel.h"
+#include "AnimationProfiler.h"
+#include "AnimationTrim.h"
+#include "JobPool.h"
+#include "SpatialGrid.h"
+#include "SpriteSheetLoader.h"
+#include "TextureCache.h"
+#include "TimingWheel.h"
+
+#include <SFML/Graphics.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Capacity of a system growing from empty
+#define ANIMATION_SYSTEM_MIN_CAPACITY 16
+
+/// Animations per job of a parallel update, a multiple of the kernel width
+/// large enough for the chunks not to share cache lines
+#define ANIMATION_SYSTEM_CHUNK_SIZE 512
+
+/// Duration of a tick of the timing wheel of an event-driven system
+#define ANIMATION_SYSTEM_EVENT_TICK 0.001
+
+#define ANIMATION_SYSTEM_DEGREES_TO_RADIANS (3.14159265358979323846 / 180.0)
+
+static AnimationSystem* defaultSystem = NULL;
+
+static sfBool AnimationSystemGrowArray(
+	void** _array,
+	size_t _elementSize,
+	unsigned int _capacity)
+{
+	void* array = realloc(*_array, _elementSize * _capacity);
+	if (array == NULL)
+	{
+		return sfFalse;
+	}
+	*_array = array;
+	return sfTrue;
+}
+
+// Grow one array of the system, bail out of the caller on failure
+#define ANIMATION_SYSTEM_GROW(_system, _field, _capacity) \
+	if (!AnimationSystemGrowArray( \
+		(void**)&(_system)->_field, \
+		sizeof(*(_system)->_field), \
+		(_capacity))) \
+	{ \
+		printf("Error during memory allocation !"); \
+		return sfFalse; \
+	}
+
+AnimationSystem* AnimationSystemCreate(unsigned int _capacity)
+{
+	AnimationSystem* system =
+		(AnimationSystem*)calloc(1, sizeof(AnimationSystem));
+	if (system == NULL)
+	{
+		printf("Error during memory allocation !");
+		return NULL;
+	}
+	// Detected on the creating thread, the workers of a job pool only
+	// read the kernel level
+	AnimationKernelGetLevel();
+	if (_capacity > 0 && !AnimationSystemReserve(system, _capacity))
+	{
+		AnimationSystemDestroy(system);
+		return NULL;
+	}
+	return system;
+}
+
+void AnimationSystemDestroy(AnimationSystem* _system)
+{
+	if (_system == NULL)
+	{
+		return;
+	}
+	for (unsigned int i = 0; i < _system->count; i++)
+	{
+		sfSprite_destroy(_system->sprite[i]);
+		TextureCacheRelease(_system->spriteSheet[i]);
+		SpriteSheetRequestRelease(_system->pendingSheet[i]);
+		FrameTableRelease(_system->frameTable[i]);
+		AnimationHandleFree(_system->handles[i]);
+	}
+	for (unsigned int i = 0; i < _system->spareSpritesNb; i++)
+	{
+		sfSprite_destroy(_system->spareSprites[i]);
+	}
+	free(_system->spareSprites);
+	free(_system->clock);
+	free(_system->duration);
+	free(_system->framesNb);
+	free(_system->currentFrame);
+	free(_system->state);
+	free(_system->isPlaying);
+	free(_system->frameDirty);
+	free(_system->frameRect);
+	free(_system->variableTimes);
+	free(_system->clockStamp);
+	free(_system->startTime);
+	free(_system->ticks);
+	free(_system->durationTicks);
+	free(_system->frameChangeTick);
+	free(_system->tickFraction);
+	free(_system->lodTier);
+	free(_system->lodPhase);
+	free(_system->lodTime);
+	free(_system->visibleStamp);
+	free(_system->position);
+	free(_system->rotation);
+	free(_system->scale);
+	free(_system->color);
+	free(_system->sprite);
+	free(_system->spriteSheet);
+	free(_system->pendingSheet);
+	free(_system->frameTable);
+	free(_system->frameSize);
+	free(_system->sheetOrigin);
+	free(_system->layout);
+	free(_system->animationOffset);
+	free(_system->blockLength);
+	free(_system->handles);
+	TimingWheelDestroy(_system->wheel);
+	SpatialGridDestroy(_system->grid);
+	if (_system == defaultSystem)
+	{
+		defaultSystem = NULL;
+	}
+	free(_system);
+}
+
+AnimationSystem* AnimationSystemGetDefault(void)
+{
+	if (defaultSystem == NULL)
+	{
+		defaultSystem = AnimationSystemCreate(0);
+	}
+	return defaultSystem;
+}
+
+void AnimationSystemReleaseDefault(AnimationSystem* _system)
+{
+	if (_system == defaultSystem && _system->count == 0)
+	{
+		AnimationSystemDestroy(_system);
+	}
+}
+
+sfBool AnimationSystemReserve(AnimationSystem* _system, unsigned int _capacity)
+{
+	if (_capacity <= _system->capacity)
+	{
+		return sfTrue;
+	}
+	ANIMATION_SYSTEM_GROW(_system, clock, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, duration, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, framesNb, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, currentFrame, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, state, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, isPlaying, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, frameDirty, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, frameRect, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, variableTimes, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, clockStamp, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, startTime, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, ticks, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, durationTicks, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, frameChangeTick, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, tickFraction, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, lodTier, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, lodPhase, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, lodTime, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, visibleStamp, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, position, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, rotation, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, scale, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, color, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, sprite, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, spriteSheet, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, pendingSheet, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, frameTable, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, frameSize, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, sheetOrigin, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, layout, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, animationOffset, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, blockLength, _capacity);
+	ANIMATION_SYSTEM_GROW(_system, handles, _capacity);
+	if (_system->wheel != NULL && !TimingWheelReserve(_system->wheel, _capacity))
+	{
+		return sfFalse;
+	}
+	if (_system->grid != NULL && !SpatialGridReserve(_system->grid, _capacity))
+	{
+		return sfFalse;
+	}
+	_system->capacity = _capacity;
+	return sfTrue;
+}
+
+// Make room for one more slot, doubling the capacity when full
+static sfBool AnimationSystemGrow(AnimationSystem* _system)
+{
+	if (_system->count < _system->capacity)
+	{
+		return sfTrue;
+	}
+	unsigned int capacity = _system->capacity * 2;
+	if (capacity < ANIMATION_SYSTEM_MIN_CAPACITY)
+	{
+		capacity = ANIMATION_SYSTEM_MIN_CAPACITY;
+	}
+	return AnimationSystemReserve(_system, capacity);
+}
+
+sfBool AnimationSystemAdd(
+	AnimationSystem* _system,
+	Animation* _handle,
+	sfVector2u _frameSize,
+	unsigned char _framesNb)
+{
+	if (!AnimationSystemGrow(_system))
+	{
+		return sfFalse;
+	}
+	unsigned int i = _system->count;
+
+	// creating the sprite
+	_system->sprite[i] = AnimationSystemTakeSprite(_system);
+	if (_system->sprite[i] == NULL)
+	{
+		printf("Error during cration of the sprite !");
+		return sfFalse;
+	}
+	sfSprite_setOrigin(_system->sprite[i],
+		(sfVector2f) {
+		(float)_frameSize.x / 2,
+			(float)_frameSize.y / 2
+	});
+
+	_system->clock[i] = 0;
+	_system->duration[i] = 1;
+	_system->framesNb[i] = _framesNb;
+	_system->currentFrame[i] = 0;
+	_system->state[i] = DEFAULT;
+	_system->isPlaying[i] = sfFalse;
+	_system->frameDirty[i] = sfFalse;
+	_system->frameRect[i] = (sfIntRect){ 0, 0, 0, 0 };
+	_system->variableTimes[i] = sfFalse;
+	_system->clockStamp[i] = _system->eventTime;
+	_system->startTime[i] = 0;
+	_system->ticks[i] = 0;
+	_system->durationTicks[i] = _system->tickRate > 0 ? _system->tickRate : 1;
+	_system->frameChangeTick[i] = 0;
+	_system->tickFraction[i] = 0;
+	_system->lodTier[i] = 0;
+	// Spread the updates of the slots of a tier
+	_system->lodPhase[i] = (unsigned char)i;
+	_system->lodTime[i] = 0;
+	_system->visibleStamp[i] = _system->cullStamp;
+	_system->position[i] = (sfVector2f){ 0, 0 };
+	_system->rotation[i] = 0;
+	_system->scale[i] = (sfVector2f){ 1, 1 };
+	_system->color[i] = sfWhite;
+	_system->spriteSheet[i] = NULL;
+	_system->pendingSheet[i] = NULL;
+	_system->frameTable[i] = NULL;
+	_system->frameSize[i] = _frameSize;
+	_system->sheetOrigin[i] = (sfVector2i){ 0, 0 };
+	_system->layout[i] = ANIMATION_LAYOUT_NONE;
+	_system->animationOffset[i] = (sfVector2u){ 0, 0 };
+	_system->blockLength[i] = (sfVector2u){ 0, 0 };
+	_system->handles[i] = _handle;
+
+	_handle->system = _system;
+	_handle->index = i;
+	_system->count++;
+	AnimationSystemUpdateBounds(_system, i);
+	return sfTrue;
+}
+
+sfBool AnimationSystemDuplicate(
+	AnimationSystem* _system,
+	Animation* _handle,
+	unsigned int _source)
+{
+	if (!AnimationSystemGrow(_system))
+	{
+		return sfFalse;
+	}
+	unsigned int i = _system->count;
+
+	// The copy starts from the clock of the source at the event time
+	AnimationSystemSync(_system, _source);
+	_system->clock[i] = _system->clock[_source];
+	_system->duration[i] = _system->duration[_source];
+	_system->framesNb[i] = _system->framesNb[_source];
+	_system->currentFrame[i] = _system->currentFrame[_source];
+	_system->state[i] = _system->state[_source];
+	_system->isPlaying[i] = _system->isPlaying[_source];
+	_system->frameDirty[i] = _system->frameDirty[_source];
+	_system->frameRect[i] = _system->frameRect[_source];
+	_system->variableTimes[i] = _system->variableTimes[_source];
+	_system->clockStamp[i] = _system->clockStamp[_source];
+	_system->startTime[i] = _system->startTime[_source];
+	_system->ticks[i] = _system->ticks[_source];
+	_system->durationTicks[i] = _system->durationTicks[_source];
+	_system->frameChangeTick[i] = _system->frameChangeTick[_source];
+	_system->tickFraction[i] = _system->tickFraction[_source];
+	_system->lodTier[i] = 0;
+	_system->lodPhase[i] = (unsigned char)i;
+	_system->lodTime[i] = 0;
+	_system->visibleStamp[i] = _system->visibleStamp[_source];
+	_system->position[i] = _system->position[_source];
+	_system->rotation[i] = _system->rotation[_source];
+	_system->scale[i] = _system->scale[_source];
+	_system->color[i] = _system->color[_source];
+	_system->sprite[i] = NULL;
+	_system->spriteSheet[i] = NULL;
+	_system->pendingSheet[i] = _system->pendingSheet[_source] != NULL
+		? SpriteSheetRequestRetain(_system->pendingSheet[_source])
+		: NULL;
+	_system->frameTable[i] = _system->frameTable[_source] != NULL
+		? FrameTableRetain(_system->frameTable[_source])
+		: NULL;
+	_system->frameSize[i] = _system->frameSize[_source];
+	_system->sheetOrigin[i] = _system->sheetOrigin[_source];
+	_system->layout[i] = _system->layout[_source];
+	_system->animationOffset[i] = _system->animationOffset[_source];
+	_system->blockLength[i] = _system->blockLength[_source];
+	_system->handles[i] = _handle;
+
+	_handle->system = _system;
+	_handle->index = i;
+	_system->count++;
+	AnimationSystemSchedule(_system, i);
+	AnimationSystemUpdateBounds(_system, i);
+	return sfTrue;
+}
+
+void AnimationSystemRemove(AnimationSystem* _system, unsigned int _index)
+{
+	if (_system->lodTier[_index] > 0)
+	{
+		_system->lodSlotsNb--;
+	}
+	unsigned int last = --_system->count;
+	if (_system->wheel != NULL)
+	{
+		TimingWheelRemove(_system->wheel, _index);
+		TimingWheelMove(_system->wheel, last, _index);
+	}
+	if (_system->grid != NULL)
+	{
+		SpatialGridRemove(_system->grid, _index);
+		SpatialGridMove(_system->grid, last, _index);
+	}
+	if (_index == last)
+	{
+		return;
+	}
+
+	// Move the last slot into the hole to keep the arrays dense
+	_system->clock[_index] = _system->clock[last];
+	_system->duration[_index] = _system->duration[last];
+	_system->framesNb[_index] = _system->framesNb[last];
+	_system->currentFrame[_index] = _system->currentFrame[last];
+	_system->state[_index] = _system->state[last];
+	_system->isPlaying[_index] = _system->isPlaying[last];
+	_system->frameDirty[_index] = _system->frameDirty[last];
+	_system->frameRect[_index] = _system->frameRect[last];
+	_system->variableTimes[_index] = _system->variableTimes[last];
+	_system->clockStamp[_index] = _system->clockStamp[last];
+	_system->startTime[_index] = _system->startTime[last];
+	_system->ticks[_index] = _system->ticks[last];
+	_system->durationTicks[_index] = _system->durationTicks[last];
+	_system->frameChangeTick[_index] = _system->frameChangeTick[last];
+	_system->tickFraction[_index] = _system->tickFraction[last];
+	_system->lodTier[_index] = _system->lodTier[last];
+	_system->lodPhase[_index] = _system->lodPhase[last];
+	_system->lodTime[_index] = _system->lodTime[last];
+	_system->visibleStamp[_index] = _system->visibleStamp[last];
+	_system->position[_index] = _system->position[last];
+	_system->rotation[_index] = _system->rotation[last];
+	_system->scale[_index] = _system->scale[last];
+	_system->color[_index] = _system->color[last];
+	_system->sprite[_index] = _system->sprite[last];
+	_system->spriteSheet[_index] = _system->spriteSheet[last];
+	_system->pendingSheet[_index] = _system->pendingSheet[last];
+	_system->frameTable[_index] = _system->frameTable[last];
+	_system->frameSize[_index] = _system->frameSize[last];
+	_system->sheetOrigin[_index] = _system->sheetOrigin[last];
+	_system->layout[_index] = _system->layout[last];
+	_system->animationOffset[_index] = _system->animationOffset[last];
+	_system->blockLength[_index] = _system->blockLength[last];
+	_system->handles[_index] = _system->handles[last];
+	_system->handles[_index]->index = _index;
+}
+
+Animation* AnimationSystemCreateAnimation(
+	AnimationSystem* _system,
+	sfVector2u _frameSize,
+	unsigned char _framesNb)
+{
+	Animation* anim = AnimationHandleAlloc();
+	if (anim == NULL)
+	{
+		return NULL;
+	}
+	if (!AnimationSystemAdd(_system, anim, _frameSize, _framesNb))
+	{
+		AnimationHandleFree(anim);
+		return NULL;
+	}
+	return anim;
+}
+
+sfSprite* AnimationSystemTakeSprite(AnimationSystem* _system)
+{
+	if (_system->spareSpritesNb == 0)
+	{
+		return sfSprite_create();
+	}
+	sfSprite* sprite = _system->spareSprites[--_system->spareSpritesNb];
+	sfSprite_setPosition(sprite, (sfVector2f){ 0, 0 });
+	sfSprite_setRotation(sprite, 0);
+	sfSprite_setScale(sprite, (sfVector2f){ 1, 1 });
+	sfSprite_setColor(sprite, sfWhite);
+	sfSprite_setTextureRect(sprite, (sfIntRect){ 0, 0, 0, 0 });
+	return sprite;
+}
+
+void AnimationSystemGiveSprite(AnimationSystem* _system, sfSprite* _sprite)
+{
+	if (_system->spareSpritesNb == _system->spareSpritesCapacity)
+	{
+		unsigned int capacity = _system->spareSpritesCapacity > 0
+			? _system->spareSpritesCapacity * 2
+			: ANIMATION_SYSTEM_MIN_CAPACITY;
+		sfSprite** grown = (sfSprite**)realloc(
+			_system->spareSprites, sizeof(sfSprite*) * capacity);
+		if (grown == NULL)
+		{
+			sfSprite_destroy(_sprite);
+			return;
+		}
+		_system->spareSprites = grown;
+		_system->spareSpritesCapacity = capacity;
+	}
+	_system->spareSprites[_system->spareSpritesNb++] = _sprite;
+}
+
+AnimationSystem* AnimationGetSystem(const Animation* _anim)
+{
+	return _anim->system;
+}
+
+unsigned int AnimationSystemGetCount(const AnimationSystem* _system)
+{
+	return _system->count;
+}
+
+Animation* AnimationSystemGetAnimation(
+	const AnimationSystem* _system,
+	unsigned int _index)
+{
+	return _system->handles[_index];
+}
+
+// Frame played at the clock of a slot, out of range past the ends
+static int AnimationSystemFindFrame(AnimationSystem* _system, unsigned int _index)
+{
+	return AnimationFindFrame(
+		_system->clock[_index],
+		_system->duration[_index],
+		_system->framesNb[_index],
+		_system->frameTable[_index],
+		_system->currentFrame[_index]);
+}
+
+// Progression of the clip at which a frame starts
+static double AnimationSystemGetFrameStart(
+	const AnimationSystem* _system,
+	unsigned int _index,
+	int _frame)
+{
+	if (_system->variableTimes[_index])
+	{
+		return _system->frameTable[_index]->times[_frame];
+	}
+	return (double)_frame / (double)_system->framesNb[_index];
+}
+
+float AnimationSystemGetLazyClock(
+	const AnimationSystem* _system,
+	unsigned int _index,
+	sfBool* _playing)
+{
+	double duration = _system->duration[_index];
+	double elapsed = AnimationGetGlobalClock() - _system->startTime[_index];
+	sfBool playing = sfTrue;
+
+	if (_system->state[_index] & LOOPED)
+	{
+		elapsed = duration > 0 ? fmod(elapsed, duration) : 0;
+		if (elapsed < 0)
+		{
+			elapsed += duration;
+		}
+	}
+	else if (elapsed > duration)
+	{
+		// The clip is over, it stays on its last frame
+		elapsed = duration;
+		playing = sfFalse;
+	}
+	else if (elapsed < 0)
+	{
+		elapsed = 0;
+	}
+	if (_playing != NULL)
+	{
+		*_playing = playing;
+	}
+	return (float)(_system->state[_index] & REVERSED ? duration - elapsed : elapsed);
+}
+
+unsigned int AnimationSystemGetFrame(const AnimationSystem* _system, unsigned int _index)
+{
+	if (!(_system->state[_index] & LAZY))
+	{
+		return _system->currentFrame[_index];
+	}
+	double progression = (double)AnimationSystemGetLazyClock(_system, _index, NULL)
+		/ (double)_system->duration[_index];
+	const FrameTable* table = _system->frameTable[_index];
+	int frame = table != NULL && table->times != NULL
+		? FrameTableFind(table, progression, _system->currentFrame[_index])
+		: (int)floor(progression * (double)_system->framesNb[_index]);
+
+	// The ends of the clip are in its first and last frames
+	if (frame >= (int)_system->framesNb[_index])
+	{
+		frame = (int)_system->framesNb[_index] - 1;
+	}
+	return frame > 0 ? (unsigned int)frame : 0;
+}
+
+void AnimationSystemSetClock(AnimationSystem* _system, unsigned int _index, float _clock)
+{
+	// The time skipped by a lower level of detail is replaced too
+	_system->lodTime[_index] = 0;
+	_system->clock[_index] = _clock;
+	if (_system->state[_index] & LAZY)
+	{
+		double elapsed = _system->state[_index] & REVERSED
+			? (double)_system->duration[_index] - _clock
+			: (double)_clock;
+		_system->startTime[_index] = AnimationGetGlobalClock() - elapsed;
+	}
+}
+
+void AnimationSystemSetFrame(AnimationSystem* _system, unsigned int _index, unsigned char _frame)
+{
+	_system->lodTime[_index] = 0;
+	_system->currentFrame[_index] = _frame;
+	if (_system->state[_index] & LAZY && _frame < _system->framesNb[_index])
+	{
+		AnimationSystemSetClock(
+			_system,
+			_index,
+			(float)(AnimationSystemGetFrameStart(_system, _index, _frame)
+				* _system->duration[_index]));
+	}
+}
+
+void AnimationSystemSetState(
+	AnimationSystem* _system,
+	unsigned int _index,
+	unsigned char _state)
+{
+	if (_system->state[_index] & LAZY)
+	{
+		// Freeze the clip where the global clock is
+		sfBool playing = sfTrue;
+		_system->clock[_index] = AnimationSystemGetLazyClock(_system, _index, &playing);
+		_system->currentFrame[_index] = (unsigned char)AnimationSystemGetFrame(_system, _index);
+		_system->isPlaying[_index] = (unsigned char)playing;
+	}
+	_system->state[_index] = _state;
+	if (_state & LAZY)
+	{
+		// Never advanced, the clock is only read from the global clock
+		_system->isPlaying[_index] = sfFalse;
+		AnimationSystemSetClock(_system, _index, _system->clock[_index]);
+	}
+}
+
+void AnimationSystemAdvance(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end,
+	float _dt)
+{
+	for (unsigned int i = _begin; i < _end; i++)
+	{
+		if (!_system->isPlaying[i])
+		{
+			continue;
+		}
+		if (!AnimationStep(
+			&_system->clock[i],
+			&_system->currentFrame[i],
+			_system->state[i],
+			_system->duration[i],
+			_system->framesNb[i],
+			_system->frameTable[i],
+			_dt))
+		{
+			_system->isPlaying[i] = sfFalse;
+		}
+		_system->frameDirty[i] = sfTrue;
+	}
+}
+
+// Current frame of a slot in its frame table, which it must have
+static unsigned int AnimationSystemGetTableFrame(
+	const AnimationSystem* _system,
+	unsigned int _index)
+{
+	const FrameTable* table = _system->frameTable[_index];
+	unsigned int frame = AnimationSystemGetFrame(_system, _index);
+	return frame < table->framesNb ? frame : table->framesNb - 1;
+}
+
+// Texture rect of the current frame of a slot, which must have a frame table
+static sfIntRect AnimationSystemGetFrameRect(
+	const AnimationSystem* _system,
+	unsigned int _index)
+{
+	const FrameTable* table = _system->frameTable[_index];
+	unsigned int frame = AnimationSystemGetTableFrame(_system, _index);
+	return table->trims != NULL ? table->trims[frame] : table->rects[frame];
+}
+
+// Show the frame rect of a slot, a trimmed frame also moves the origin
+// so that the middle of the untrimmed frame stays at the position
+static void AnimationSystemSetSpriteRect(AnimationSystem* _system, unsigned int _index)
+{
+	sfSprite_setTextureRect(_system->sprite[_index], _system->frameRect[_index]);
+	const FrameTable* table = _system->frameTable[_index];
+	if (table != NULL && table->trims != NULL)
+	{
+		sfSprite_setOrigin(
+			_system->sprite[_index],
+			table->trimOrigins[AnimationSystemGetTableFrame(_system, _index)]);
+	}
+}
+
+// Tick at which a frame starts, frame framesNb starting at the end
+static unsigned int AnimationSystemGetFrameStartTick(
+	const AnimationSystem* _system,
+	unsigned int _index,
+	unsigned int _frame)
+{
+	unsigned long long duration = _system->durationTicks[_index];
+	if (_system->variableTimes[_index])
+	{
+		return (unsigned int)floor(
+			(double)_system->frameTable[_index]->times[_frame] * (double)duration);
+	}
+	// First tick t with t * framesNb / duration == frame
+	unsigned long long framesNb = _system->framesNb[_index];
+	return (unsigned int)((_frame * duration + framesNb - 1) / framesNb);
+}
+
+// Frame played at the tick clock of a slot, integer only for uniform frames
+static unsigned int AnimationSystemFindFrameTicks(
+	const AnimationSystem* _system,
+	unsigned int _index)
+{
+	unsigned int framesNb = _system->framesNb[_index];
+	if (framesNb == 0)
+	{
+		return 0;
+	}
+	unsigned int frame = 0;
+	if (_system->variableTimes[_index])
+	{
+		while (frame + 1 < framesNb
+			&& AnimationSystemGetFrameStartTick(_system, _index, frame + 1) <= _system->ticks[_index])
+		{
+			frame++;
+		}
+	}
+	else
+	{
+		frame = (unsigned int)((unsigned long long)_system->ticks[_index] * framesNb
+			/ _system->durationTicks[_index]);
+	}
+	return frame < framesNb ? frame : framesNb - 1;
+}
+
+// Move the tick clock of a slot out of its frame, to a clock out of the
+// clip when it reaches an end
+static void AnimationSystemChangeFrameTicks(
+	AnimationSystem* _system,
+	unsigned int _index,
+	long long _ticks)
+{
+	long long duration = _system->durationTicks[_index];
+	sfBool reversed = (_system->state[_index] & REVERSED) != 0;
+	_system->frameDirty[_index] = sfTrue;
+
+	// If animation has played his last frame
+	if (reversed ? _ticks < 0 : _ticks >= duration)
+	{
+		if (!(_system->state[_index] & LOOPED))
+		{
+			_system->isPlaying[_index] = sfFalse;
+			_system->ticks[_index] = reversed ? 0 : (unsigned int)duration;
+			_system->currentFrame[_index] = reversed || _system->framesNb[_index] == 0
+				? 0 : _system->framesNb[_index] - 1;
+			return;
+		}
+		// Unlike the float clocks, the ticks past the end are kept
+		_ticks %= duration;
+		if (_ticks < 0)
+		{
+			_ticks += duration;
+		}
+	}
+	_system->ticks[_index] = (unsigned int)_ticks;
+	unsigned int frame = AnimationSystemFindFrameTicks(_system, _index);
+	_system->currentFrame[_index] = (unsigned char)frame;
+	_system->frameChangeTick[_index] = reversed
+		? AnimationSystemGetFrameStartTick(_system, _index, frame)
+		: AnimationSystemGetFrameStartTick(_system, _index, frame + 1);
+}
+
+void AnimationSystemAdvanceTicks(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end,
+	unsigned int _ticks)
+{
+	for (unsigned int i = _begin; i < _end; i++)
+	{
+		if (!_system->isPlaying[i])
+		{
+			continue;
+		}
+		unsigned int ticks = _system->ticks[i];
+		unsigned int change = _system->frameChangeTick[i];
+
+		// Most updates stay in the frame, an add and a compare
+		if (_system->state[i] & REVERSED)
+		{
+			if (ticks >= change && ticks - change >= _ticks)
+			{
+				_system->ticks[i] = ticks - _ticks;
+				continue;
+			}
+			AnimationSystemChangeFrameTicks(_system, i, (long long)ticks - _ticks);
+		}
+		else
+		{
+			if (ticks < change && change - ticks > _ticks)
+			{
+				_system->ticks[i] = ticks + _ticks;
+				continue;
+			}
+			AnimationSystemChangeFrameTicks(_system, i, (long long)ticks + _ticks);
+		}
+	}
+}
+
+void AnimationSystemSetTicks(AnimationSystem* _system, unsigned int _index, unsigned int _ticks)
+{
+	unsigned int duration = _system->durationTicks[_index];
+	_system->lodTime[_index] = 0;
+	_system->ticks[_index] = _ticks < duration ? _ticks : duration;
+	unsigned int frame = AnimationSystemFindFrameTicks(_system, _index);
+	_system->currentFrame[_index] = (unsigned char)frame;
+	_system->frameChangeTick[_index] = _system->state[_index] & REVERSED
+		? AnimationSystemGetFrameStartTick(_system, _index, frame)
+		: AnimationSystemGetFrameStartTick(_system, _index, frame + 1);
+	_system->frameDirty[_index] = sfTrue;
+	AnimationSystemSync(_system, _index);
+}
+
+void AnimationSystemComputeRects(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end)
+{
+	// Playing slots are dirty at each update, only some change of frame
+	unsigned int changes = 0;
+	for (unsigned int i = _begin; i < _end; i++)
+	{
+		// Culled slots stay dirty until they are seen again
+		if (!_system->frameDirty[i] || !AnimationSystemIsVisible(_system, i))
+		{
+			continue;
+		}
+		if (_system->frameTable[i] != NULL)
+		{
+			sfIntRect rect = AnimationSystemGetFrameRect(_system, i);
+			changes += rect.left != _system->frameRect[i].left
+				|| rect.top != _system->frameRect[i].top
+				|| rect.width != _system->frameRect[i].width
+				|| rect.height != _system->frameRect[i].height;
+			_system->frameRect[i] = rect;
+		}
+		else
+		{
+			// No sprite sheet, nothing to show
+			_system->frameDirty[i] = sfFalse;
+		}
+	}
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_FRAME_CHANGES, changes);
+}
+
+void AnimationSystemApply(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end)
+{
+	unsigned int rectsSet = 0;
+	sfBool uploaded = sfFalse;
+	for (unsigned int i = _begin; i < _end; i++)
+	{
+		if (_system->pendingSheet[i] != NULL)
+		{
+			// The decoded sprite sheets are uploaded once for every slot
+			if (!uploaded)
+			{
+				SpriteSheetLoaderUpload();
+				uploaded = sfTrue;
+			}
+			AnimationSystemResolveSpriteSheet(_system, i);
+		}
+		if (_system->frameDirty[i] && AnimationSystemIsVisible(_system, i))
+		{
+			AnimationSystemSetSpriteRect(_system, i);
+			_system->frameDirty[i] = sfFalse;
+			rectsSet++;
+		}
+	}
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_TEXTURE_RECTS, rectsSet);
+}
+
+sfBool AnimationSystemStepLod(AnimationSystem* _system, unsigned int _index, float* _dt)
+{
+	unsigned char mask = (unsigned char)((1u << _system->lodTier[_index]) - 1);
+	if (mask == 0)
+	{
+		return sfTrue;
+	}
+	// Skipped updates keep their time, the slot is advanced by all of it
+	_system->lodTime[_index] += *_dt;
+	if ((++_system->lodPhase[_index] & mask) != 0)
+	{
+		return sfFalse;
+	}
+	*_dt = _system->lodTime[_index];
+	_system->lodTime[_index] = 0;
+	return sfTrue;
+}
+
+void AnimationSystemSetLodTier(AnimationSystem* _system, unsigned int _index, unsigned char _tier)
+{
+	unsigned char tier = _system->lodTier[_index];
+	if (_tier == tier)
+	{
+		return;
+	}
+	AnimationSystemSync(_system, _index);
+	_system->lodSlotsNb += (_tier > 0) - (tier > 0);
+	_system->lodTier[_index] = _tier;
+}
+
+void AnimationSystemSync(AnimationSystem* _system, unsigned int _index)
+{
+	if (_system->lodTime[_index] != 0)
+	{
+		// Catch up with the updates skipped by a lower level of detail
+		float skipped = _system->lodTime[_index];
+		_system->lodTime[_index] = 0;
+		AnimationSystemAdvance(_system, _index, _index + 1, skipped);
+		AnimationSystemComputeRects(_system, _index, _index + 1);
+		AnimationSystemApply(_system, _index, _index + 1);
+	}
+	if (_system->tickRate > 0)
+	{
+		_system->clock[_index] = (float)((double)_system->ticks[_index] / _system->tickRate);
+		return;
+	}
+	if (_system->wheel == NULL)
+	{
+		return;
+	}
+	double elapsed = _system->eventTime - _system->clockStamp[_index];
+	_system->clockStamp[_index] = _system->eventTime;
+	if (_system->isPlaying[_index] && elapsed > 0)
+	{
+		AnimationSystemAdvance(_system, _index, _index + 1, (float)elapsed);
+	}
+	AnimationSystemComputeRects(_system, _index, _index + 1);
+	AnimationSystemApply(_system, _index, _index + 1);
+}
+
+// Time left before the frame of a playing slot changes
+static double AnimationSystemGetFrameDelay(AnimationSystem* _system, unsigned int _index)
+{
+	int frame = AnimationSystemFindFrame(_system, _index);
+	if (frame != (int)_system->currentFrame[_index])
+	{
+		// Out of the clip or behind the clock, to advance right away
+		return 0;
+	}
+	double clock = _system->clock[_index];
+	double duration = _system->duration[_index];
+	double delay = _system->state[_index] & REVERSED
+		? clock - AnimationSystemGetFrameStart(_system, _index, frame) * duration
+		: AnimationSystemGetFrameStart(_system, _index, frame + 1) * duration - clock;
+	return delay > 0 ? delay : 0;
+}
+
+// Tick clock and duration of a slot from its float ones
+static void AnimationSystemLoadTicks(AnimationSystem* _system, unsigned int _index)
+{
+	// Exact products, the same ticks on every platform
+	double rate = _system->tickRate;
+	double duration = floor((double)_system->duration[_index] * rate + 0.5);
+	double clock = floor((double)_system->clock[_index] * rate + 0.5);
+	_system->durationTicks[_index] = duration >= 1 ? (unsigned int)duration : 1;
+	if (clock >= _system->durationTicks[_index]
+		|| _system->clock[_index] >= _system->duration[_index])
+	{
+		_system->ticks[_index] = _system->durationTicks[_index];
+	}
+	else
+	{
+		_system->ticks[_index] = clock > 0 ? (unsigned int)clock : 0;
+	}
+
+	// The next advance finds the frame of the clock, as with float clocks
+	_system->frameChangeTick[_index] = _system->state[_index] & REVERSED ? UINT_MAX : 0;
+	_system->tickFraction[_index] = 0;
+}
+
+void AnimationSystemSchedule(AnimationSystem* _system, unsigned int _index)
+{
+	if (_system->tickRate > 0)
+	{
+		AnimationSystemLoadTicks(_system, _index);
+		return;
+	}
+	if (_system->wheel == NULL)
+	{
+		return;
+	}
+	_system->clockStamp[_index] = _system->eventTime;
+	if (_system->pendingSheet[_index] != NULL)
+	{
+		// Check the loading at the next update
+		TimingWheelInsert(_system->wheel, _index, 0);
+	}
+	else if (_system->isPlaying[_index])
+	{
+		// Woken up in the tick of the change, before it when the update comes
+		// too early the slot is only scheduled again
+		double time = _system->eventTime + AnimationSystemGetFrameDelay(_system, _index);
+		TimingWheelInsert(
+			_system->wheel,
+			_index,
+			(unsigned long long)floor(time / ANIMATION_SYSTEM_EVENT_TICK));
+	}
+	else
+	{
+		TimingWheelRemove(_system->wheel, _index);
+	}
+}
+
+void AnimationSystemSetSpriteSheet(
+	AnimationSystem* _system,
+	unsigned int _index,
+	sfTexture* _texture)
+{
+	TextureCacheRelease(_system->spriteSheet[_index]);
+	_system->spriteSheet[_index] = _texture;
+	SpriteSheetRequestRelease(_system->pendingSheet[_index]);
+	_system->pendingSheet[_index] = NULL;
+	if (_texture != NULL)
+	{
+		sfSprite_setTexture(_system->sprite[_index], _texture, sfTrue);
+		if (AnimationAreCollisionMasksEnabled())
+		{
+			TextureCacheBuildCollisionMask(_texture);
+		}
+		const FrameTable* table = _system->frameTable[_index];
+		if (AnimationIsTrimmingEnabled())
+		{
+			AnimationSystemTrimFrames(_system, _index);
+		}
+		else if (table != NULL && table->trimTexture != NULL && table->trimTexture != _texture)
+		{
+			// Frames trimmed to another sprite sheet are compiled again
+			AnimationSystemBuildFrameTable(_system, _index);
+		}
+	}
+}
+
+void AnimationSystemResolveSpriteSheet(AnimationSystem* _system, unsigned int _index)
+{
+	SpriteSheetRequest* request = _system->pendingSheet[_index];
+	switch (SpriteSheetRequestGetState(request))
+	{
+	case SPRITE_SHEET_READY:
+		AnimationSystemSetSpriteSheet(
+			_system,
+			_index,
+			TextureCacheRetain(SpriteSheetRequestGetTexture(request)));
+		// The clock kept running, show the frame it is at
+		AnimationSystemFrameUpdate(_system, _index);
+		break;
+	case SPRITE_SHEET_FAILED:
+		printf("Error during cration of the sprite sheet texture !");
+		AnimationSystemSetSpriteSheet(_system, _index, NULL);
+		break;
+	default:
+		break;
+	}
+}
+
+void AnimationSystemSetFlipState(AnimationSystem* _system, unsigned int _index)
+{
+	sfVector2f scale = _system->scale[_index];
+
+	// Flip sprite according to the state of the animation
+	if (_system->state[_index] & FLIP_X)
+	{
+		scale.x = -scale.x;
+	}
+	if (_system->state[_index] & FLIP_Y)
+	{
+		scale.y = -scale.y;
+	}
+	sfSprite_setScale(_system->sprite[_index], scale);
+}
+
+void AnimationSystemBuildFrameTable(AnimationSystem* _system, unsigned int _index)
+{
+	FrameTable* previous = _system->frameTable[_index];
+	sfBool keepTimes = previous != NULL && previous->times != NULL
+		&& previous->framesNb == _system->framesNb[_index];
+
+	// Frames start at the corner of the sprite sheet area in the texture,
+	// uniform tables are shared by every slot with the same layout
+	if (keepTimes)
+	{
+		_system->frameTable[_index] = FrameTableCreate(
+			(AnimationLayout)_system->layout[_index],
+			_system->sheetOrigin[_index],
+			_system->frameSize[_index],
+			_system->framesNb[_index],
+			_system->blockLength[_index]);
+	}
+	else
+	{
+		_system->frameTable[_index] = FrameTableAcquire(
+			(AnimationLayout)_system->layout[_index],
+			_system->sheetOrigin[_index],
+			_system->frameSize[_index],
+			_system->framesNb[_index],
+			_system->blockLength[_index]);
+	}
+
+	// Keep the frame timings when the frames are the same
+	if (keepTimes && _system->frameTable[_index] != NULL)
+	{
+		_system->frameTable[_index]->times =
+			(float*)malloc(sizeof(float) * (previous->framesNb + 1));
+		if (_system->frameTable[_index]->times != NULL)
+		{
+			memcpy(
+				_system->frameTable[_index]->times,
+				previous->times,
+				sizeof(float) * (previous->framesNb + 1));
+		}
+	}
+	FrameTableRelease(previous);
+	_system->variableTimes[_index] = _system->frameTable[_index] != NULL
+		&& _system->frameTable[_index]->times != NULL;
+
+	if (AnimationIsTrimmingEnabled())
+	{
+		AnimationSystemTrimFrames(_system, _index);
+	}
+	if (_system->frameTable[_index] == NULL || _system->frameTable[_index]->trims == NULL)
+	{
+		// Untrimmed frames have their origin in the middle
+		sfVector2u frameSize = _system->frameSize[_index];
+		sfSprite_setOrigin(_system->sprite[_index],
+			(sfVector2f) { (float)frameSize.x / 2, (float)frameSize.y / 2 });
+	}
+}
+
+void AnimationSystemTrimFrames(AnimationSystem* _system, unsigned int _index)
+{
+	FrameTable* table = _system->frameTable[_index];
+	sfTexture* texture = _system->spriteSheet[_index];
+	if (table == NULL || texture == NULL || table->trimTexture == texture)
+	{
+		return;
+	}
+	const CollisionMask* mask = TextureCacheBuildVisibleMask(texture);
+	if (mask == NULL)
+	{
+		return;
+	}
+
+	// Uniform tables are shared by the slots reading the same texture,
+	// tables with frame durations stay owned by their slot
+	FrameTable* trimmed = NULL;
+	if (table->times == NULL)
+	{
+		trimmed = FrameTableAcquireTrimmed(
+			(AnimationLayout)_system->layout[_index],
+			_system->sheetOrigin[_index],
+			_system->frameSize[_index],
+			_system->framesNb[_index],
+			_system->blockLength[_index],
+			texture,
+			mask);
+	}
+	else
+	{
+		trimmed = table->refCount > 1 ? FrameTableCopy(table) : FrameTableRetain(table);
+		if (trimmed != NULL && !FrameTableTrim(trimmed, texture, mask))
+		{
+			FrameTableRelease(trimmed);
+			trimmed = NULL;
+		}
+	}
+	if (trimmed == NULL)
+	{
+		return;
+	}
+	FrameTableRelease(table);
+	_system->frameTable[_index] = trimmed;
+	_system->frameDirty[_index] = sfTrue;
+}
+
+void AnimationSystemShowFrame(AnimationSystem* _system, unsigned int _index)
+{
+	if (!(_system->state[_index] & LAZY) || _system->frameTable[_index] == NULL)
+	{
+		return;
+	}
+	sfIntRect rect = AnimationSystemGetFrameRect(_system, _index);
+	if (memcmp(&rect, &_system->frameRect[_index], sizeof(rect)) != 0)
+	{
+		_system->frameRect[_index] = rect;
+		AnimationSystemSetSpriteRect(_system, _index);
+		ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_FRAME_CHANGES, 1);
+		ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_TEXTURE_RECTS, 1);
+	}
+}
+
+void AnimationSystemFrameUpdate(AnimationSystem* _system, unsigned int _index)
+{
+	if (_system->frameTable[_index] == NULL)
+	{
+		return;
+	}
+	_system->frameRect[_index] = AnimationSystemGetFrameRect(_system, _index);
+	AnimationSystemSetSpriteRect(_system, _index);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_TEXTURE_RECTS, 1);
+}
+
+// Advance the event time and the slots reaching their frame change
+static void AnimationSystemUpdateEvents(AnimationSystem* _system, float _dt)
+{
+	_system->eventTime += _dt;
+	const unsigned int* expired = NULL;
+	unsigned int expiredNb = TimingWheelAdvance(
+		_system->wheel,
+		(unsigned long long)floor(_system->eventTime / ANIMATION_SYSTEM_EVENT_TICK),
+		&expired);
+	for (unsigned int i = 0; i < expiredNb; i++)
+	{
+		AnimationSystemSync(_system, expired[i]);
+		AnimationSystemSchedule(_system, expired[i]);
+	}
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_UPDATES, expiredNb);
+}
+
+// Advance the slots of a range at their level of detail
+static void AnimationSystemAdvanceLod(
+	AnimationSystem* _system,
+	unsigned int _begin,
+	unsigned int _end,
+	float _dt)
+{
+	if (_system->lodSlotsNb == 0)
+	{
+		AnimationKernelAdvance(_system, _begin, _end, _dt);
+		ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_UPDATES, _end - _begin);
+		return;
+	}
+	unsigned int advanced = 0;
+	for (unsigned int i = _begin; i < _end; i++)
+	{
+		float dt = _dt;
+		if (_system->isPlaying[i] && AnimationSystemStepLod(_system, i, &dt))
+		{
+			AnimationSystemAdvance(_system, i, i + 1, dt);
+			advanced++;
+		}
+	}
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_UPDATES, advanced);
+}
+
+// Advance every slot of a system in tick mode
+static void AnimationSystemStepTicks(AnimationSystem* _system, unsigned int _ticks)
+{
+	AnimationSystemAdvanceTicks(_system, 0, _system->count, _ticks);
+	AnimationSystemComputeRects(_system, 0, _system->count);
+	AnimationSystemApply(_system, 0, _system->count);
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_UPDATES, _system->count);
+}
+
+void AnimationSystemUpdate(AnimationSystem* _system, float _dt)
+{
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_UPDATE);
+	if (_system->wheel != NULL)
+	{
+		AnimationSystemUpdateEvents(_system, _dt);
+	}
+	else if (_system->tickRate > 0)
+	{
+		// Whole ticks only, the fraction is carried to the next update
+		double ticks = _system->tickRemainder + (double)_dt * _system->tickRate;
+		double whole = ticks > 0 ? floor(ticks) : 0;
+		_system->tickRemainder = ticks - whole;
+		AnimationSystemStepTicks(_system, (unsigned int)whole);
+	}
+	else
+	{
+		AnimationSystemAdvanceLod(_system, 0, _system->count, _dt);
+		AnimationSystemComputeRects(_system, 0, _system->count);
+		AnimationSystemApply(_system, 0, _system->count);
+	}
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_UPDATE);
+}
+
+void AnimationSystemUpdateTicks(AnimationSystem* _system, unsigned int _ticks)
+{
+	if (_system->tickRate == 0)
+	{
+		printf("Error : the animation system is not in tick mode !");
+		return;
+	}
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_UPDATE);
+	AnimationSystemStepTicks(_system, _ticks);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_UPDATE);
+}
+
+sfBool AnimationSystemSetTickRate(AnimationSystem* _system, unsigned int _tickRate)
+{
+	if (_tickRate > 0 && _system->wheel != NULL)
+	{
+		printf("Error : an event-driven animation system cannot be in tick mode !");
+		return sfFalse;
+	}
+	// Float clocks from the ticks of the previous rate
+	for (unsigned int i = 0; i < _system->count; i++)
+	{
+		AnimationSystemSync(_system, i);
+	}
+	_system->tickRate = _tickRate;
+	_system->tickRemainder = 0;
+	for (unsigned int i = 0; i < _system->count; i++)
+	{
+		AnimationSystemSchedule(_system, i);
+	}
+	return sfTrue;
+}
+
+unsigned int AnimationSystemGetTickRate(const AnimationSystem* _system)
+{
+	return _system->tickRate;
+}
+
+/// @brief Parameters shared by the jobs of a parallel update
+typedef struct AnimationSystemJob
+{
+	AnimationSystem* system;
+	float dt;
+} AnimationSystemJob;
+
+// Job of a parallel update, pure data so that any thread can run it
+static void AnimationSystemUpdateChunk(
+	void* _userData,
+	unsigned int _begin,
+	unsigned int _end,
+	unsigned int _worker)
+{
+	(void)_worker;
+	AnimationSystemJob* job = (AnimationSystemJob*)_userData;
+	AnimationSystemAdvanceLod(job->system, _begin, _end, job->dt);
+	AnimationSystemComputeRects(job->system, _begin, _end);
+}
+
+void AnimationSystemUpdateParallel(
+	AnimationSystem* _system,
+	JobPool* _pool,
+	float _dt)
+{
+	if (_pool == NULL || _system->wheel != NULL || _system->tickRate > 0)
+	{
+		AnimationSystemUpdate(_system, _dt);
+		return;
+	}
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_UPDATE);
+	AnimationSystemJob job = { _system, _dt };
+	JobPoolRun(
+		_pool,
+		AnimationSystemUpdateChunk,
+		&job,
+		_system->count,
+		ANIMATION_SYSTEM_CHUNK_SIZE);
+
+	// Every job is done, CSFML is only called from this thread
+	AnimationSystemApply(_system, 0, _system->count);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_UPDATE);
+}
+
+sfBool AnimationSystemSetEventDriven(AnimationSystem* _system, sfBool _eventDriven)
+{
+	if (_eventDriven == (_system->wheel != NULL))
+	{
+		return sfTrue;
+	}
+	if (_eventDriven && _system->tickRate > 0)
+	{
+		printf("Error : an animation system in tick mode cannot be event-driven !");
+		return sfFalse;
+	}
+	if (!_eventDriven)
+	{
+		// Clocks are only up to date at their last event
+		for (unsigned int i = 0; i < _system->count; i++)
+		{
+			AnimationSystemSync(_system, i);
+		}
+		TimingWheelDestroy(_system->wheel);
+		_system->wheel = NULL;
+		return sfTrue;
+	}
+
+	TimingWheel* wheel = TimingWheelCreate();
+	if (wheel == NULL || !TimingWheelReserve(wheel, _system->capacity))
+	{
+		TimingWheelDestroy(wheel);
+		return sfFalse;
+	}
+	_system->wheel = wheel;
+	_system->eventTime = 0;
+	for (unsigned int i = 0; i < _system->count; i++)
+	{
+		AnimationSystemSchedule(_system, i);
+	}
+	return sfTrue;
+}
+
+sfBool AnimationSystemIsEventDriven(const AnimationSystem* _system)
+{
+	return _system->wheel != NULL;
+}
+
+void AnimationSystemDraw(
+	const sfRenderWindow* _window,
+	const AnimationSystem* _system,
+	const sfRenderStates* _states)
+{
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_DRAW);
+	unsigned int drawn = 0;
+	for (unsigned int i = 0; i < _system->count; i++)
+	{
+		if (_system->spriteSheet[i] != NULL)
+		{
+			AnimationSystemShowFrame((AnimationSystem*)_system, i);
+			sfRenderWindow_drawSprite(
+				(sfRenderWindow*)_window, _system->sprite[i], _states);
+			drawn++;
+		}
+	}
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_DRAW_CALLS, drawn);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_DRAW);
+}
+
+sfBool AnimationSystemIsVisible(const AnimationSystem* _system, unsigned int _index)
+{
+	return _system->grid == NULL || _system->visibleStamp[_index] == _system->cullStamp;
+}
+
+sfFloatRect AnimationSystemGetBounds(const AnimationSystem* _system, unsigned int _index)
+{
+	// The origin is in the middle of the frame, flips do not change the bounds
+	double angle = _system->rotation[_index] * ANIMATION_SYSTEM_DEGREES_TO_RADIANS;
+	double cosine = fabs(cos(angle));
+	double sine = fabs(sin(angle));
+	double halfWidth = fabs(_system->scale[_index].x) * _system->frameSize[_index].x / 2.0;
+	double halfHeight = fabs(_system->scale[_index].y) * _system->frameSize[_index].y / 2.0;
+	float extentX = (float)(halfWidth * cosine + halfHeight * sine);
+	float extentY = (float)(halfWidth * sine + halfHeight * cosine);
+	sfVector2f position = _system->position[_index];
+	return (sfFloatRect) {
+		position.x - extentX, position.y - extentY, 2 * extentX, 2 * extentY
+	};
+}
+
+sfFloatRect AnimationSystemGetTrimmedBounds(const AnimationSystem* _system, unsigned int _index)
+{
+	const FrameTable* table = _system->frameTable[_index];
+	if (table == NULL || table->trims == NULL)
+	{
+		return AnimationSystemGetBounds(_system, _index);
+	}
+	unsigned int frame = AnimationSystemGetTableFrame(_system, _index);
+	sfIntRect trim = table->trims[frame];
+	sfVector2f origin = table->trimOrigins[frame];
+	double scaleX = _system->state[_index] & FLIP_X
+		? -_system->scale[_index].x : _system->scale[_index].x;
+	double scaleY = _system->state[_index] & FLIP_Y
+		? -_system->scale[_index].y : _system->scale[_index].y;
+
+	// Middle of the trimmed rect, away from the origin
+	double angle = _system->rotation[_index] * ANIMATION_SYSTEM_DEGREES_TO_RADIANS;
+	double cosine = cos(angle);
+	double sine = sin(angle);
+	double offsetX = (trim.width / 2.0 - origin.x) * scaleX;
+	double offsetY = (trim.height / 2.0 - origin.y) * scaleY;
+	double middleX = _system->position[_index].x + cosine * offsetX - sine * offsetY;
+	double middleY = _system->position[_index].y + sine * offsetX + cosine * offsetY;
+
+	double halfWidth = fabs(scaleX) * trim.width / 2.0;
+	double halfHeight = fabs(scaleY) * trim.height / 2.0;
+	float extentX = (float)(halfWidth * fabs(cosine) + halfHeight * fabs(sine));
+	float extentY = (float)(halfWidth * fabs(sine) + halfHeight * fabs(cosine));
+	return (sfFloatRect) {
+		(float)middleX - extentX, (float)middleY - extentY, 2 * extentX, 2 * extentY
+	};
+}
+
+void AnimationSystemUpdateBounds(AnimationSystem* _system, unsigned int _index)
+{
+	if (_system->grid != NULL)
+	{
+		SpatialGridInsert(_system->grid, _index, AnimationSystemGetBounds(_system, _index));
+	}
+}
+
+sfBool AnimationSystemSetCulling(AnimationSystem* _system, float _cellSize)
+{
+	SpatialGridDestroy(_system->grid);
+	_system->grid = NULL;
+	if (_cellSize <= 0)
+	{
+		return sfTrue;
+	}
+
+	SpatialGrid* grid = SpatialGridCreate(_cellSize);
+	if (grid == NULL || !SpatialGridReserve(grid, _system->capacity))
+	{
+		SpatialGridDestroy(grid);
+		return sfFalse;
+	}
+	_system->grid = grid;
+	_system->cullStamp++;
+	for (unsigned int i = 0; i < _system->count; i++)
+	{
+		// Visible until the first cull
+		_system->visibleStamp[i] = _system->cullStamp;
+		AnimationSystemUpdateBounds(_system, i);
+	}
+	return sfTrue;
+}
+
+// Cull a system with a grid, giving the slots seen
+static unsigned int AnimationSystemCullFound(
+	AnimationSystem* _system,
+	sfFloatRect _area,
+	const unsigned int** _found)
+{
+	unsigned int foundNb = SpatialGridQuery(_system->grid, _area, _found);
+	const unsigned int* found = *_found;
+	_system->cullStamp++;
+	for (unsigned int f = 0; f < foundNb; f++)
+	{
+		unsigned int i = found[f];
+		_system->visibleStamp[i] = _system->cullStamp;
+
+		// Frames changed while culled are shown now
+		if (_system->frameDirty[i] && _system->pendingSheet[i] == NULL)
+		{
+			AnimationSystemFrameUpdate(_system, i);
+			_system->frameDirty[i] = sfFalse;
+		}
+	}
+	return foundNb;
+}
+
+unsigned int AnimationSystemCull(AnimationSystem* _system, sfFloatRect _area)
+{
+	if (_system->grid == NULL)
+	{
+		return _system->count;
+	}
+	const unsigned int* found = NULL;
+	return AnimationSystemCullFound(_system, _area, &found);
+}
+
+// Area seen through a view, grown to hold it when the view is rotated
+static sfFloatRect AnimationSystemGetViewArea(const sfView* _view)
+{
+	sfVector2f center = sfView_getCenter(_view);
+	sfVector2f size = sfView_getSize(_view);
+	double angle = sfView_getRotation(_view) * ANIMATION_SYSTEM_DEGREES_TO_RADIANS;
+	double cosine = fabs(cos(angle));
+	double sine = fabs(sin(angle));
+	float width = (float)(fabs(size.x) * cosine + fabs(size.y) * sine);
+	float height = (float)(fabs(size.x) * sine + fabs(size.y) * cosine);
+	return (sfFloatRect) { center.x - width / 2, center.y - height / 2, width, height };
+}
+
+void AnimationSystemDrawCulled(
+	const sfRenderWindow* _window,
+	AnimationSystem* _system,
+	const sfRenderStates* _states)
+{
+	if (_system->grid == NULL)
+	{
+		AnimationSystemDraw(_window, _system, _states);
+		return;
+	}
+	const unsigned int* found = NULL;
+	unsigned int foundNb = AnimationSystemCullFound(
+		_system, AnimationSystemGetViewArea(sfRenderWindow_getView(_window)), &found);
+
+	// Only the slots seen are drawn, sorted back in the order of the
+	// system so that overlapping animations keep their order
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_DRAW);
+	SpatialGridSortFound(_system->grid, foundNb);
+	unsigned int drawn = 0;
+	for (unsigned int f = 0; f < foundNb; f++)
+	{
+		unsigned int i = found[f];
+		if (_system->spriteSheet[i] != NULL)
+		{
+			AnimationSystemShowFrame(_system, i);
+			sfRenderWindow_drawSprite(
+				(sfRenderWindow*)_window, _system->sprite[i], _states);
+			drawn++;
+		}
+	}
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_DRAW_CALLS, drawn);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_DRAW);
+}
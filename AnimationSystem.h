@@ -0,0 +1,269 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "Animation.h"
+#include "JobPool.h"
+
+typedef struct AnimationSystem AnimationSystem;
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a new animation system
+///
+/// An animation system owns its animations in contiguous
+/// structure-of-arrays storage, so that all of them can be
+/// advanced with a single call to AnimationSystemUpdate.
+///
+/// @param _capacity Number of animations to reserve room for
+///
+/// @return Animation system object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+AnimationSystem* AnimationSystemCreate(unsigned int _capacity);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy an existing animation system
+///
+/// Animations still owned by the system are destroyed.
+///
+/// @param _system Animation system object
+//////////////////////////////////////////////////////////////
+void AnimationSystemDestroy(AnimationSystem* _system);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the default animation system
+///
+/// This is the system used by AnimationCreate. It is created on
+/// first use and freed when its last animation is destroyed.
+///
+/// @return Default animation system, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+AnimationSystem* AnimationSystemGetDefault(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Reserve storage for a number of animations
+///
+/// @param _system Animation system object
+///
+/// @param _capacity Number of animations to reserve room for
+///
+/// @return sfTrue if the storage is big enough, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationSystemReserve(AnimationSystem* _system, unsigned int _capacity);
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a new animation inside an animation system
+///
+/// @param _system Animation system object
+///
+/// @param _frameSize Size of a animation
+///
+/// @param _framesNb Number of frames
+///
+/// @return Animation object, or NULL if the animation cannot be create
+//////////////////////////////////////////////////////////////
+Animation* AnimationSystemCreateAnimation(
+	AnimationSystem* _system,
+	sfVector2u _frameSize,
+	unsigned char _framesNb);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the animation system owning an animation
+///
+/// @param _anim Animation object
+///
+/// @return Animation system of the animation
+//////////////////////////////////////////////////////////////
+AnimationSystem* AnimationGetSystem(const Animation* _anim);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of animations of an animation system
+///
+/// @param _system Animation system object
+///
+/// @return Number of animations
+//////////////////////////////////////////////////////////////
+unsigned int AnimationSystemGetCount(const AnimationSystem* _system);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get an animation of an animation system
+///
+/// Indices are dense and may change when an animation is destroyed.
+///
+/// @param _system Animation system object
+///
+/// @param _index Index of the animation, lower than the count
+///
+/// @return Animation object
+//////////////////////////////////////////////////////////////
+Animation* AnimationSystemGetAnimation(
+	const AnimationSystem* _system,
+	unsigned int _index);
+
+//////////////////////////////////////////////////////////////
+/// @brief Update all the animations of an animation system
+///
+/// Equivalent to calling AnimationUpdate on each animation.
+///
+/// @param _system Animation system object
+///
+/// @param _dt Delta time
+//////////////////////////////////////////////////////////////
+void AnimationSystemUpdate(AnimationSystem* _system, float _dt);
+
+//////////////////////////////////////////////////////////////
+/// @brief Update all the animations of an animation system on the
+/// workers of a job pool
+///
+/// Clocks, frames and texture rects are computed by the workers in
+/// chunks, then the sprites are set on the calling thread once every
+/// chunk is done, so drawing afterwards sees a consistent state.
+/// The result is the same as AnimationSystemUpdate.
+/// Event-driven systems and systems in tick mode are updated on the
+/// calling thread.
+///
+/// @param _system Animation system object
+///
+/// @param _pool Job pool object, NULL to update on the calling thread
+///
+/// @param _dt Delta time
+//////////////////////////////////////////////////////////////
+void AnimationSystemUpdateParallel(
+	AnimationSystem* _system,
+	JobPool* _pool,
+	float _dt);
+
+//////////////////////////////////////////////////////////////
+/// @brief Update only the animations whose frame changes
+///
+/// In event-driven mode each playing animation is scheduled in a timing
+/// wheel at the time of its next frame change, an update only touches
+/// the animations reaching it, so its cost follows the number of frame
+/// changes instead of the number of animations. Frames change at the
+/// same updates as in the default mode, clocks of the other animations
+/// are brought up to date when they are read or set.
+///
+/// @param _system Animation system object
+///
+/// @param _eventDriven sfTrue to enable the event-driven mode,
+///					   sfFalse to advance every animation at each update
+///
+/// @return sfTrue if the mode is set, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationSystemSetEventDriven(AnimationSystem* _system, sfBool _eventDriven);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if an animation system is event-driven
+///
+/// @param _system Animation system object
+///
+/// @return sfTrue if the system is event-driven, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationSystemIsEventDriven(const AnimationSystem* _system);
+
+//////////////////////////////////////////////////////////////
+/// @brief Count the clocks of an animation system in integer ticks
+///
+/// In tick mode the clocks and durations are whole numbers of ticks and
+/// frames are found by integer division, so the same ticks give the
+/// same frames on every platform, for lockstep and rollback. Durations
+/// and clocks set in seconds are rounded to the nearest tick, ticks
+/// past the end of a looped clip are carried to the next loop.
+/// An update only compares the clock with the tick of the next frame
+/// change, sprites are only touched when the frame changes.
+/// A system cannot be in tick mode and event-driven.
+///
+/// @param _system Animation system object
+///
+/// @param _tickRate Ticks per second, up to 1000000, 0 to go back to
+///					float clocks
+///
+/// @return sfTrue if the mode is set, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationSystemSetTickRate(AnimationSystem* _system, unsigned int _tickRate);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the tick rate of an animation system
+///
+/// @param _system Animation system object
+///
+/// @return Ticks per second, 0 when the clocks are floats
+//////////////////////////////////////////////////////////////
+unsigned int AnimationSystemGetTickRate(const AnimationSystem* _system);
+
+//////////////////////////////////////////////////////////////
+/// @brief Update all the animations of a system in tick mode
+///
+/// AnimationSystemUpdate also works in tick mode: the delta time is
+/// converted to whole ticks and the fraction is kept for the next
+/// update, which is not deterministic.
+///
+/// @param _system Animation system object, in tick mode
+///
+/// @param _ticks Ticks elapsed
+//////////////////////////////////////////////////////////////
+void AnimationSystemUpdateTicks(AnimationSystem* _system, unsigned int _ticks);
+
+//////////////////////////////////////////////////////////////
+/// @brief Index the animations by their global bounds to cull them
+///
+/// With culling, the animations out of the last culled area keep
+/// advancing their clocks but their texture rects are only set once
+/// they are seen again. Bounds are kept up to date by the transform
+/// setters, until the first cull every animation is visible.
+///
+/// @param _system Animation system object
+///
+/// @param _cellSize Size of a cell of the spatial grid, about the size
+///					of an animation works best, 0 to disable culling
+///
+/// @return sfTrue if culling is set, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationSystemSetCulling(AnimationSystem* _system, float _cellSize);
+
+//////////////////////////////////////////////////////////////
+/// @brief Mark the animations intersecting an area as visible
+///
+/// The frames the visible animations reached while culled are set.
+///
+/// @param _system Animation system object
+///
+/// @param _area Visible area, in world coordinates
+///
+/// @return Number of visible animations, all of them when culling is off
+//////////////////////////////////////////////////////////////
+unsigned int AnimationSystemCull(AnimationSystem* _system, sfFloatRect _area);
+
+//////////////////////////////////////////////////////////////
+/// @brief Draw the animations of an animation system seen by the
+/// view of a window
+///
+/// Culls the system with the area of the current view of the window,
+/// then draws the visible animations only. Draws every animation when
+/// culling is off.
+///
+/// @param _window Render window object
+///
+/// @param _system Animation system object
+///
+/// @param _states Render states to use, NULL to use the default states
+//////////////////////////////////////////////////////////////
+void AnimationSystemDrawCulled(
+	const sfRenderWindow* _window,
+	AnimationSystem* _system,
+	const sfRenderStates* _states);
+
+//////////////////////////////////////////////////////////////
+/// @brief Draw all the animations of an animation system
+///
+/// @param _window Render window object
+///
+/// @param _system Animation system object
+///
+/// @param _states Render states to use, NULL to use the default states
+//////////////////////////////////////////////////////////////
+void AnimationSystemDraw(
+	const sfRenderWindow* _window,
+	const AnimationSystem* _system,
+	const sfRenderStates* _states);
@@ -0,0 +1,32 @@
+#include "AnimationTrim.h"
+#include "AnimationInternal.h"
+
+static sfBool trimmingEnabled = sfFalse;
+
+void AnimationSetTrimmingEnabled(sfBool _enabled)
+{
+	trimmingEnabled = _enabled;
+}
+
+sfBool AnimationIsTrimmingEnabled(void)
+{
+	return trimmingEnabled;
+}
+
+sfBool AnimationTrimFrames(Animation* _anim)
+{
+	AnimationSystemTrimFrames(_anim->system, _anim->index);
+	AnimationSystemFrameUpdate(_anim->system, _anim->index);
+	return AnimationIsTrimmed(_anim);
+}
+
+sfBool AnimationIsTrimmed(const Animation* _anim)
+{
+	const FrameTable* table = _anim->system->frameTable[_anim->index];
+	return table != NULL && table->trims != NULL;
+}
+
+sfFloatRect AnimationGetTrimmedBounds(const Animation* _anim)
+{
+	return AnimationSystemGetTrimmedBounds(_anim->system, _anim->index);
+}
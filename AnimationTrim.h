@@ -0,0 +1,66 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "Animation.h"
+
+// Most frames of a character sprite sheet are transparent padding.
+// Trimmed frames are drawn as the tight bounding box of their pixels
+// that are not fully transparent, moved so that the middle of the
+// untrimmed frame stays at the position of the animation, which saves
+// the fill rate of the padding. The boxes are computed once per sprite
+// sheet and layout, from a 1-bit mask of the alpha kept with the
+// texture, and shared by the animations reading the sprite sheet the
+// same way. Culling and picking keep the untrimmed frames, the sprite
+// bounds (AnimationGetLocalBounds, AnimationGetGlobalBounds) follow the
+// trimmed ones.
+
+//////////////////////////////////////////////////////////////
+/// @brief Trim the frames of the sprite sheets when they are set
+///
+/// Off by default. Turning it off does not untrim the frames trimmed
+/// before, only the sprite sheets set from now on.
+///
+/// @param _enabled sfTrue to trim the frames, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+void AnimationSetTrimmingEnabled(sfBool _enabled);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if the frames of the sprite sheets are trimmed
+///
+/// @return sfTrue if the frames are trimmed, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationIsTrimmingEnabled(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Trim the frames of an animation
+///
+/// For sprite sheets set while trimming was disabled.
+///
+/// @param _anim Animation object
+///
+/// @return sfTrue if the frames are trimmed, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationTrimFrames(Animation* _anim);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if the frames of an animation are trimmed
+///
+/// @param _anim Animation object
+///
+/// @return sfTrue if the frames are trimmed, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool AnimationIsTrimmed(const Animation* _anim);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the global bounds of the visible pixels of the current
+/// frame of an animation
+///
+/// @param _anim Animation object
+///
+/// @return Bounds of the trimmed frame in world coordinates, the bounds
+///		 of the whole frame if it is not trimmed
+//////////////////////////////////////////////////////////////
+sfFloatRect AnimationGetTrimmedBounds(const Animation* _anim);
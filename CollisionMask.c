@@ -0,0 +1,113 @@
+#include "CollisionMask.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+struct CollisionMask
+{
+	sfVector2u size;
+	/// Words of a row, the bits past the width are clear
+	unsigned int wordsPerRow;
+	unsigned long long* bits;
+};
+
+CollisionMask* CollisionMaskCreateFromTexture(const sfTexture* _texture, sfUint8 _threshold)
+{
+	sfImage* image = sfTexture_copyToImage(_texture);
+	if (image == NULL)
+	{
+		printf("Error during cration of the collision mask image !");
+		return NULL;
+	}
+	CollisionMask* mask = (CollisionMask*)malloc(sizeof(CollisionMask));
+	if (mask == NULL)
+	{
+		printf("Error during memory allocation !");
+		sfImage_destroy(image);
+		return NULL;
+	}
+	mask->size = sfImage_getSize(image);
+	mask->wordsPerRow = (mask->size.x + 63) / 64;
+	mask->bits = (unsigned long long*)calloc(
+		(size_t)mask->wordsPerRow * mask->size.y, sizeof(unsigned long long));
+	if (mask->bits == NULL && mask->wordsPerRow * mask->size.y > 0)
+	{
+		printf("Error during memory allocation !");
+		free(mask);
+		sfImage_destroy(image);
+		return NULL;
+	}
+
+	const sfUint8* pixels = sfImage_getPixelsPtr(image);
+	for (unsigned int y = 0; y < mask->size.y; y++)
+	{
+		unsigned long long* row = &mask->bits[(size_t)y * mask->wordsPerRow];
+		const sfUint8* alpha = &pixels[(size_t)y * mask->size.x * 4 + 3];
+		for (unsigned int x = 0; x < mask->size.x; x++)
+		{
+			if (alpha[x * 4] >= _threshold)
+			{
+				row[x / 64] |= 1ull << (x % 64);
+			}
+		}
+	}
+	sfImage_destroy(image);
+	return mask;
+}
+
+void CollisionMaskDestroy(CollisionMask* _mask)
+{
+	if (_mask == NULL)
+	{
+		return;
+	}
+	free(_mask->bits);
+	free(_mask);
+}
+
+sfVector2u CollisionMaskGetSize(const CollisionMask* _mask)
+{
+	return _mask->size;
+}
+
+sfBool CollisionMaskGetPixel(const CollisionMask* _mask, int _x, int _y)
+{
+	if (_x < 0 || _y < 0 || (unsigned int)_x >= _mask->size.x || (unsigned int)_y >= _mask->size.y)
+	{
+		return sfFalse;
+	}
+	unsigned long long word = _mask->bits[(size_t)_y * _mask->wordsPerRow + _x / 64];
+	return (word >> (_x % 64)) & 1;
+}
+
+// Word of a row, empty out of the mask
+static unsigned long long CollisionMaskGetWord(
+	const CollisionMask* _mask,
+	const unsigned long long* _row,
+	long long _word)
+{
+	if (_word < 0 || _word >= (long long)_mask->wordsPerRow)
+	{
+		return 0;
+	}
+	return _row[_word];
+}
+
+unsigned long long CollisionMaskGetBits(const CollisionMask* _mask, int _x, int _y)
+{
+	if (_y < 0 || (unsigned int)_y >= _mask->size.y)
+	{
+		return 0;
+	}
+	const unsigned long long* row = &_mask->bits[(size_t)_y * _mask->wordsPerRow];
+
+	// The 64 pixels straddle two words unless they are aligned
+	long long first = _x >= 0 ? _x / 64 : -((63 - (long long)_x) / 64);
+	unsigned int shift = (unsigned int)(_x - first * 64);
+	unsigned long long low = CollisionMaskGetWord(_mask, row, first);
+	if (shift == 0)
+	{
+		return low;
+	}
+	return low >> shift | CollisionMaskGetWord(_mask, row, first + 1) << (64 - shift);
+}
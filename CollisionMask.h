@@ -0,0 +1,70 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+
+/// @brief 1-bit alpha mask of an image, for pixel perfect collisions
+///
+/// Rows are packed in 64-bit words, bit k of a word being the pixel k
+/// of the 64 it holds, so that masks are compared 64 pixels at a time.
+typedef struct CollisionMask CollisionMask;
+
+/// @brief Alpha from which a pixel is solid
+#define COLLISION_MASK_ALPHA_THRESHOLD 128
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a new collision mask from the alpha of a texture
+///
+/// @param _texture Texture to copy the pixels of
+///
+/// @param _threshold Alpha from which a pixel is solid
+///
+/// @return Collision mask object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+CollisionMask* CollisionMaskCreateFromTexture(const sfTexture* _texture, sfUint8 _threshold);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy an existing collision mask
+///
+/// @param _mask Collision mask object
+//////////////////////////////////////////////////////////////
+void CollisionMaskDestroy(CollisionMask* _mask);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the size of a collision mask
+///
+/// @param _mask Collision mask object
+///
+/// @return Size of the image of the mask
+//////////////////////////////////////////////////////////////
+sfVector2u CollisionMaskGetSize(const CollisionMask* _mask);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if a pixel of a collision mask is solid
+///
+/// @param _mask Collision mask object
+///
+/// @param _x Column of the pixel
+///
+/// @param _y Row of the pixel
+///
+/// @return sfTrue if the pixel is solid, sfFalse if it is not or it
+///			is out of the mask
+//////////////////////////////////////////////////////////////
+sfBool CollisionMaskGetPixel(const CollisionMask* _mask, int _x, int _y);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get 64 pixels of a row of a collision mask
+///
+/// @param _mask Collision mask object
+///
+/// @param _x Column of the first pixel, any value
+///
+/// @param _y Row of the pixels
+///
+/// @return Bit k is set when the pixel (_x + k, _y) is solid, pixels
+///			out of the mask are not
+//////////////////////////////////////////////////////////////
+unsigned long long CollisionMaskGetBits(const CollisionMask* _mask, int _x, int _y);
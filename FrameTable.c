@@ -0,0 +1,511 @@
+#include "FrameTable.h"
+#include "AnimationInternal.h"
+
+#include <SFML/Graphics.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+AnimationLayout AnimationLayoutFromString(const char* _structure)
+{
+	if (_structure == NULL)
+	{
+		return ANIMATION_LAYOUT_NONE;
+	}
+	if (strcmp(_structure, "horizontal") == 0)
+	{
+		return ANIMATION_LAYOUT_HORIZONTAL;
+	}
+	if (strcmp(_structure, "vertical") == 0)
+	{
+		return ANIMATION_LAYOUT_VERTICAL;
+	}
+	if (strcmp(_structure, "block") == 0)
+	{
+		return ANIMATION_LAYOUT_BLOCK;
+	}
+	return ANIMATION_LAYOUT_NONE;
+}
+
+sfIntRect AnimationLayoutGetArea(
+	AnimationLayout _layout,
+	sfVector2u _offset,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	sfVector2u _blockLength)
+{
+	sfIntRect area = { (int)_offset.x, (int)_offset.y, 0, 0 };
+
+	/// Calculate surface area according to the sprite sheet structure
+	switch (_layout)
+	{
+	case ANIMATION_LAYOUT_HORIZONTAL:
+		area.width = (int)(_frameSize.x * _framesNb);
+		area.height = (int)_frameSize.y;
+		break;
+	case ANIMATION_LAYOUT_VERTICAL:
+		area.width = (int)_frameSize.x;
+		area.height = (int)(_frameSize.y * _framesNb);
+		break;
+	case ANIMATION_LAYOUT_BLOCK:
+		area.width = (int)(_blockLength.x * _frameSize.x);
+		area.height = (int)(_blockLength.y * _frameSize.y);
+		break;
+	default:
+		break;
+	}
+	return area;
+}
+
+FrameTable* FrameTableCreate(
+	AnimationLayout _layout,
+	sfVector2i _origin,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	sfVector2u _blockLength)
+{
+	if (_layout == ANIMATION_LAYOUT_NONE || _framesNb == 0)
+	{
+		return NULL;
+	}
+	FrameTable* table = (FrameTable*)malloc(sizeof(FrameTable));
+	if (table == NULL)
+	{
+		printf("Error during memory allocation !");
+		return NULL;
+	}
+	table->rects = (sfIntRect*)malloc(sizeof(sfIntRect) * _framesNb);
+	if (table->rects == NULL)
+	{
+		printf("Error during memory allocation !");
+		free(table);
+		return NULL;
+	}
+	table->refCount = 1;
+	table->framesNb = _framesNb;
+	table->times = NULL;
+	table->trims = NULL;
+	table->trimOrigins = NULL;
+	table->trimTexture = NULL;
+
+	unsigned int columns = _blockLength.x > 0 ? _blockLength.x : 1;
+	for (unsigned int frame = 0; frame < _framesNb; frame++)
+	{
+		// Cell of the frame in the sprite sheet
+		sfVector2u cell = { 0, 0 };
+		switch (_layout)
+		{
+		case ANIMATION_LAYOUT_HORIZONTAL:
+			cell.x = frame;
+			break;
+		case ANIMATION_LAYOUT_VERTICAL:
+			cell.y = frame;
+			break;
+		default:
+			cell.x = frame % columns;
+			cell.y = frame / columns;
+			break;
+		}
+		table->rects[frame] = (sfIntRect){
+			_origin.x + (int)(cell.x * _frameSize.x),
+			_origin.y + (int)(cell.y * _frameSize.y),
+			(int)_frameSize.x,
+			(int)_frameSize.y
+		};
+	}
+	return table;
+}
+
+/// @brief Layout a cached frame table was compiled from
+typedef struct FrameTableCacheEntry
+{
+	AnimationLayout layout;
+	sfVector2i origin;
+	sfVector2u frameSize;
+	unsigned int framesNb;
+	sfVector2u blockLength;
+	/// Texture the table is trimmed to, NULL when it is not trimmed
+	const sfTexture* texture;
+	/// Table holding a reference of the cache
+	FrameTable* table;
+} FrameTableCacheEntry;
+
+static FrameTableCacheEntry* cacheEntries = NULL;
+static unsigned int cacheEntriesNb = 0;
+static unsigned int cacheEntriesCapacity = 0;
+
+// Find a cached table, trimmed to a texture or not, or compile it
+static FrameTable* FrameTableAcquireCached(
+	AnimationLayout _layout,
+	sfVector2i _origin,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	sfVector2u _blockLength,
+	const sfTexture* _texture,
+	const CollisionMask* _mask)
+{
+	for (unsigned int i = 0; i < cacheEntriesNb; i++)
+	{
+		FrameTableCacheEntry* entry = &cacheEntries[i];
+		if (entry->layout == _layout
+			&& entry->framesNb == _framesNb
+			&& entry->origin.x == _origin.x && entry->origin.y == _origin.y
+			&& entry->frameSize.x == _frameSize.x && entry->frameSize.y == _frameSize.y
+			&& entry->blockLength.x == _blockLength.x
+			&& entry->blockLength.y == _blockLength.y
+			&& entry->texture == _texture)
+		{
+			return FrameTableRetain(entry->table);
+		}
+	}
+
+	FrameTable* table = FrameTableCreate(_layout, _origin, _frameSize, _framesNb, _blockLength);
+	if (table == NULL)
+	{
+		return NULL;
+	}
+	if (_texture != NULL && !FrameTableTrim(table, _texture, _mask))
+	{
+		FrameTableRelease(table);
+		return NULL;
+	}
+	if (cacheEntriesNb == cacheEntriesCapacity)
+	{
+		unsigned int capacity = cacheEntriesCapacity > 0 ? cacheEntriesCapacity * 2 : 16;
+		FrameTableCacheEntry* grown = (FrameTableCacheEntry*)realloc(
+			cacheEntries, sizeof(FrameTableCacheEntry) * capacity);
+		if (grown == NULL)
+		{
+			// Still usable, only not shared
+			return table;
+		}
+		cacheEntries = grown;
+		cacheEntriesCapacity = capacity;
+	}
+	cacheEntries[cacheEntriesNb++] = (FrameTableCacheEntry){
+		_layout, _origin, _frameSize, _framesNb, _blockLength, _texture, table
+	};
+	return FrameTableRetain(table);
+}
+
+FrameTable* FrameTableAcquire(
+	AnimationLayout _layout,
+	sfVector2i _origin,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	sfVector2u _blockLength)
+{
+	return FrameTableAcquireCached(
+		_layout, _origin, _frameSize, _framesNb, _blockLength, NULL, NULL);
+}
+
+FrameTable* FrameTableAcquireTrimmed(
+	AnimationLayout _layout,
+	sfVector2i _origin,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	sfVector2u _blockLength,
+	const sfTexture* _texture,
+	const CollisionMask* _mask)
+{
+	return FrameTableAcquireCached(
+		_layout, _origin, _frameSize, _framesNb, _blockLength, _texture, _mask);
+}
+
+void FrameTableForgetTexture(const sfTexture* _texture)
+{
+	// The tables stay alive for the animations still holding them
+	for (unsigned int i = cacheEntriesNb; i-- > 0;)
+	{
+		if (cacheEntries[i].texture == _texture)
+		{
+			FrameTableRelease(cacheEntries[i].table);
+			cacheEntries[i] = cacheEntries[--cacheEntriesNb];
+		}
+	}
+}
+
+// Index of the lowest and the highest bit set of a word which is not 0
+static int FrameTableGetLowestBit(unsigned long long _bits)
+{
+	int bit = 0;
+	while (!(_bits & 1))
+	{
+		_bits >>= 1;
+		bit++;
+	}
+	return bit;
+}
+
+static int FrameTableGetHighestBit(unsigned long long _bits)
+{
+	int bit = 63;
+	while (!(_bits >> 63))
+	{
+		_bits <<= 1;
+		bit--;
+	}
+	return bit;
+}
+
+// Tight bounding box of the visible pixels of a rect, empty if there is none
+static sfIntRect FrameTableGetVisibleRect(const CollisionMask* _mask, sfIntRect _rect)
+{
+	int firstRow = -1;
+	int lastRow = -1;
+	int firstColumn = _rect.width;
+	int lastColumn = -1;
+	for (int y = 0; y < _rect.height; y++)
+	{
+		sfBool visible = sfFalse;
+		for (int x = 0; x < _rect.width; x += 64)
+		{
+			// 64 pixels at a time, the columns past the rect are masked out
+			unsigned long long bits = CollisionMaskGetBits(_mask, _rect.left + x, _rect.top + y);
+			if (_rect.width - x < 64)
+			{
+				bits &= (1ull << (_rect.width - x)) - 1;
+			}
+			if (bits == 0)
+			{
+				continue;
+			}
+			visible = sfTrue;
+			int first = x + FrameTableGetLowestBit(bits);
+			int last = x + FrameTableGetHighestBit(bits);
+			firstColumn = first < firstColumn ? first : firstColumn;
+			lastColumn = last > lastColumn ? last : lastColumn;
+		}
+		if (visible)
+		{
+			firstRow = firstRow < 0 ? y : firstRow;
+			lastRow = y;
+		}
+	}
+	if (firstRow < 0)
+	{
+		return (sfIntRect) { _rect.left, _rect.top, 0, 0 };
+	}
+	return (sfIntRect) {
+		_rect.left + firstColumn,
+		_rect.top + firstRow,
+		lastColumn - firstColumn + 1,
+		lastRow - firstRow + 1
+	};
+}
+
+sfBool FrameTableTrim(FrameTable* _table, const sfTexture* _texture, const CollisionMask* _mask)
+{
+	if (_table->trims == NULL)
+	{
+		_table->trims = (sfIntRect*)malloc(sizeof(sfIntRect) * _table->framesNb);
+		_table->trimOrigins = (sfVector2f*)malloc(sizeof(sfVector2f) * _table->framesNb);
+		if (_table->trims == NULL || _table->trimOrigins == NULL)
+		{
+			printf("Error during memory allocation !");
+			free(_table->trims);
+			free(_table->trimOrigins);
+			_table->trims = NULL;
+			_table->trimOrigins = NULL;
+			return sfFalse;
+		}
+	}
+	for (unsigned int frame = 0; frame < _table->framesNb; frame++)
+	{
+		sfIntRect rect = _table->rects[frame];
+		sfIntRect trim = FrameTableGetVisibleRect(_mask, rect);
+		_table->trims[frame] = trim;
+		_table->trimOrigins[frame] = (sfVector2f){
+			(float)rect.width / 2 - (float)(trim.left - rect.left),
+			(float)rect.height / 2 - (float)(trim.top - rect.top)
+		};
+	}
+	_table->trimTexture = _texture;
+	return sfTrue;
+}
+
+void FrameTableTrimCache(void)
+{
+	for (unsigned int i = cacheEntriesNb; i-- > 0;)
+	{
+		if (cacheEntries[i].table->refCount == 1)
+		{
+			FrameTableRelease(cacheEntries[i].table);
+			cacheEntries[i] = cacheEntries[--cacheEntriesNb];
+		}
+	}
+	if (cacheEntriesNb == 0)
+	{
+		free(cacheEntries);
+		cacheEntries = NULL;
+		cacheEntriesCapacity = 0;
+	}
+}
+
+FrameTable* FrameTableCopy(const FrameTable* _table)
+{
+	FrameTable* table = (FrameTable*)malloc(sizeof(FrameTable));
+	if (table == NULL)
+	{
+		printf("Error during copying frame table !");
+		return NULL;
+	}
+	table->refCount = 1;
+	table->framesNb = _table->framesNb;
+	table->times = NULL;
+	table->trims = NULL;
+	table->trimOrigins = NULL;
+	table->trimTexture = _table->trimTexture;
+	table->rects = (sfIntRect*)malloc(sizeof(sfIntRect) * _table->framesNb);
+	if (_table->times != NULL)
+	{
+		table->times = (float*)malloc(sizeof(float) * (_table->framesNb + 1));
+	}
+	if (_table->trims != NULL)
+	{
+		table->trims = (sfIntRect*)malloc(sizeof(sfIntRect) * _table->framesNb);
+		table->trimOrigins = (sfVector2f*)malloc(sizeof(sfVector2f) * _table->framesNb);
+	}
+	if (table->rects == NULL || (_table->times != NULL && table->times == NULL)
+		|| (_table->trims != NULL && (table->trims == NULL || table->trimOrigins == NULL)))
+	{
+		printf("Error during copying frame table !");
+		FrameTableRelease(table);
+		return NULL;
+	}
+	memcpy(table->rects, _table->rects, sizeof(sfIntRect) * _table->framesNb);
+	if (_table->times != NULL)
+	{
+		memcpy(
+			table->times,
+			_table->times,
+			sizeof(float) * (_table->framesNb + 1));
+	}
+	if (_table->trims != NULL)
+	{
+		memcpy(table->trims, _table->trims, sizeof(sfIntRect) * _table->framesNb);
+		memcpy(table->trimOrigins, _table->trimOrigins, sizeof(sfVector2f) * _table->framesNb);
+	}
+	return table;
+}
+
+FrameTable* FrameTableRetain(FrameTable* _table)
+{
+	_table->refCount++;
+	return _table;
+}
+
+void FrameTableRelease(FrameTable* _table)
+{
+	if (_table == NULL || --_table->refCount > 0)
+	{
+		return;
+	}
+	free(_table->rects);
+	free(_table->times);
+	free(_table->trims);
+	free(_table->trimOrigins);
+	free(_table);
+}
+
+float FrameTableSetDurations(FrameTable* _table, const float* _durations)
+{
+	if (_durations == NULL)
+	{
+		free(_table->times);
+		_table->times = NULL;
+		return 0;
+	}
+
+	double total = 0;
+	for (unsigned int frame = 0; frame < _table->framesNb; frame++)
+	{
+		if (_durations[frame] <= 0)
+		{
+			printf("Error : frame durations must be positive !");
+			return 0;
+		}
+		total += _durations[frame];
+	}
+
+	if (_table->times == NULL)
+	{
+		_table->times = (float*)malloc(sizeof(float) * (_table->framesNb + 1));
+		if (_table->times == NULL)
+		{
+			printf("Error during memory allocation !");
+			return 0;
+		}
+	}
+
+	// Prefix sums relative to the whole clip, the last one is exactly 1
+	double sum = 0;
+	for (unsigned int frame = 0; frame < _table->framesNb; frame++)
+	{
+		_table->times[frame] = (float)(sum / total);
+		sum += _durations[frame];
+	}
+	_table->times[_table->framesNb] = 1;
+	return (float)total;
+}
+
+unsigned int FrameTableGetFramesNb(const FrameTable* _table)
+{
+	return _table->framesNb;
+}
+
+sfIntRect FrameTableGetRect(const FrameTable* _table, unsigned int _frame)
+{
+	return _table->rects[_frame];
+}
+
+int FrameTableFind(
+	const FrameTable* _table,
+	double _progression,
+	unsigned int _hint)
+{
+	int framesNb = (int)_table->framesNb;
+	if (_table->times == NULL)
+	{
+		return (int)(floor(_progression * (double)framesNb));
+	}
+	if (_progression < 0)
+	{
+		return -1;
+	}
+	if (_progression >= 1)
+	{
+		return framesNb;
+	}
+
+	const float* times = _table->times;
+
+	// Clocks move by less than a frame most of the time
+	int hint = (int)_hint < framesNb ? (int)_hint : framesNb - 1;
+	for (int frame = hint - 1; frame <= hint + 1; frame++)
+	{
+		if (frame >= 0 && frame < framesNb
+			&& times[frame] <= _progression && _progression < times[frame + 1])
+		{
+			return frame;
+		}
+	}
+
+	// Last frame starting before the progression
+	int low = 0;
+	int high = framesNb - 1;
+	while (low < high)
+	{
+		int middle = (low + high + 1) / 2;
+		if (times[middle] <= _progression)
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle - 1;
+		}
+	}
+	return low;
+}
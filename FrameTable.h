@@ -0,0 +1,246 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "CollisionMask.h"
+
+/// @brief Layouts of the frames inside a sprite sheet
+/// (NONE, HORIZONTAL, VERTICAL, BLOCK)
+typedef enum AnimationLayout
+{
+	/// @brief No sprite sheet
+	ANIMATION_LAYOUT_NONE = 0,
+	/// @brief Frames are on a single row
+	ANIMATION_LAYOUT_HORIZONTAL,
+	/// @brief Frames are on a single column
+	ANIMATION_LAYOUT_VERTICAL,
+	/// @brief Frames fill a block row after row
+	ANIMATION_LAYOUT_BLOCK
+} AnimationLayout;
+
+/// @brief Precompiled texture rects and timings of the frames of a clip
+///
+/// Frame tables are reference counted so that copies of an animation
+/// can share them.
+typedef struct FrameTable FrameTable;
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the layout matching a sprite sheet structure name
+///
+/// @param _structure Structure of the sprite sheet (horizontal, vertical, block)
+///
+/// @return Layout, ANIMATION_LAYOUT_NONE if the name is unknown
+//////////////////////////////////////////////////////////////
+AnimationLayout AnimationLayoutFromString(const char* _structure);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the surface area used by the frames of a layout
+///
+/// @param _layout Layout of the sprite sheet
+///
+/// @param _offset Offset of the sprite sheet in the file
+///
+/// @param _frameSize Size of a frame
+///
+/// @param _framesNb Number of frames
+///
+/// @param _blockLength Width and height of the block, in frames
+///
+/// @return Surface area in the file
+//////////////////////////////////////////////////////////////
+sfIntRect AnimationLayoutGetArea(
+	AnimationLayout _layout,
+	sfVector2u _offset,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	sfVector2u _blockLength);
+
+//////////////////////////////////////////////////////////////
+/// @brief Compile the texture rects of a layout
+///
+/// @param _layout Layout of the sprite sheet
+///
+/// @param _origin Position of the first frame in the texture
+///
+/// @param _frameSize Size of a frame
+///
+/// @param _framesNb Number of frames
+///
+/// @param _blockLength Width and height of the block, in frames
+///
+/// @return Frame table with uniform timings, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+FrameTable* FrameTableCreate(
+	AnimationLayout _layout,
+	sfVector2i _origin,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	sfVector2u _blockLength);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get a shared frame table with uniform timings for a layout
+///
+/// Tables are compiled once per layout and kept by a cache, so that
+/// animations reading a sprite sheet the same way share their table
+/// and a new animation allocates nothing. Shared tables are copied
+/// before their durations are set.
+///
+/// @param _layout Layout of the sprite sheet
+///
+/// @param _origin Position of the first frame in the texture
+///
+/// @param _frameSize Size of a frame
+///
+/// @param _framesNb Number of frames
+///
+/// @param _blockLength Width and height of the block, in frames
+///
+/// @return Frame table with a new reference, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+FrameTable* FrameTableAcquire(
+	AnimationLayout _layout,
+	sfVector2i _origin,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	sfVector2u _blockLength);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get a shared frame table with uniform timings for a layout,
+/// trimmed to the visible pixels of a texture
+///
+/// @param _layout Layout of the sprite sheet
+///
+/// @param _origin Position of the first frame in the texture
+///
+/// @param _frameSize Size of a frame
+///
+/// @param _framesNb Number of frames
+///
+/// @param _blockLength Width and height of the block, in frames
+///
+/// @param _texture Texture the frames are read from
+///
+/// @param _mask Mask of the visible pixels of the texture
+///
+/// @return Frame table with a new reference, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+FrameTable* FrameTableAcquireTrimmed(
+	AnimationLayout _layout,
+	sfVector2i _origin,
+	sfVector2u _frameSize,
+	unsigned int _framesNb,
+	sfVector2u _blockLength,
+	const sfTexture* _texture,
+	const CollisionMask* _mask);
+
+//////////////////////////////////////////////////////////////
+/// @brief Remove the tables trimmed to a texture from the cache, before
+/// the texture is destroyed
+///
+/// @param _texture Texture object
+//////////////////////////////////////////////////////////////
+void FrameTableForgetTexture(const sfTexture* _texture);
+
+//////////////////////////////////////////////////////////////
+/// @brief Trim the frames of a table to the visible pixels of a texture
+///
+/// Each frame keeps the tight bounding box of its pixels that are not
+/// fully transparent, and where the middle of the untrimmed frame is
+/// in it. A frame with no visible pixel is trimmed to an empty rect.
+///
+/// @param _table Frame table object, not shared
+///
+/// @param _texture Texture the frames are read from
+///
+/// @param _mask Mask of the visible pixels of the texture
+///
+/// @return sfTrue if the table is trimmed, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool FrameTableTrim(FrameTable* _table, const sfTexture* _texture, const CollisionMask* _mask);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy the cached frame tables no animation uses
+//////////////////////////////////////////////////////////////
+void FrameTableTrimCache(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Copy a frame table
+///
+/// @param _table Frame table to copy
+///
+/// @return Copied table with a single reference, NULL if the copy fail
+//////////////////////////////////////////////////////////////
+FrameTable* FrameTableCopy(const FrameTable* _table);
+
+//////////////////////////////////////////////////////////////
+/// @brief Add a reference to a frame table
+///
+/// @param _table Frame table object
+///
+/// @return The same frame table
+//////////////////////////////////////////////////////////////
+FrameTable* FrameTableRetain(FrameTable* _table);
+
+//////////////////////////////////////////////////////////////
+/// @brief Remove a reference to a frame table, destroying it
+/// with the last reference
+///
+/// @param _table Frame table object, NULL is ignored
+//////////////////////////////////////////////////////////////
+void FrameTableRelease(FrameTable* _table);
+
+//////////////////////////////////////////////////////////////
+/// @brief Set the durations of the frames of a table
+///
+/// Durations are stored as prefix sums relative to the whole clip,
+/// so the clip can still be stretched with its total duration.
+///
+/// @param _table Frame table object
+///
+/// @param _durations Duration of each frame, NULL for uniform timings
+///
+/// @return Sum of the durations, or 0 if the durations are invalid
+//////////////////////////////////////////////////////////////
+float FrameTableSetDurations(FrameTable* _table, const float* _durations);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of frames of a table
+///
+/// @param _table Frame table object
+///
+/// @return Number of frames
+//////////////////////////////////////////////////////////////
+unsigned int FrameTableGetFramesNb(const FrameTable* _table);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the texture rect of a frame
+///
+/// @param _table Frame table object
+///
+/// @param _frame Frame, lower than the frames number
+///
+/// @return Texture rect of the frame
+//////////////////////////////////////////////////////////////
+sfIntRect FrameTableGetRect(const FrameTable* _table, unsigned int _frame);
+
+//////////////////////////////////////////////////////////////
+/// @brief Find the frame played at a progression of the clip
+///
+/// Uniform tables are resolved in O(1). Tables with durations first
+/// check the hint and its neighbours, then binary search the prefix sums.
+///
+/// @param _table Frame table object
+///
+/// @param _progression Clock divided by the duration of the clip
+///
+/// @param _hint Frame played before, used as a starting point
+///
+/// @return Frame index, below 0 or above the last frame when the
+///		   progression is outside of the clip
+//////////////////////////////////////////////////////////////
+int FrameTableFind(
+	const FrameTable* _table,
+	double _progression,
+	unsigned int _hint);
@@ -2,19 +2,41 @@
 #include <SFML/Graphics.h>
 #include "Game.h"
 #include "Animation.h"
+#include "AnimationLoader.h"
 
 Animation* anim;
 static sfEvent event;
 
 void GameLoad()
 {
-	anim = AnimationCreate((sfVector2u) { 96, 125 }, 4);
-	AnimationSetSpriteSheet(
-		anim,
-		"Assets/Images/SpriteSheet.png",
-		"horizontal",
-		NULL,
-		NULL);
+	// Every sprite sheet of the game is decoded in parallel
+	AnimationLoadEntry manifest[] = {
+		{ "Assets/Images/SpriteSheet.png", "horizontal", { 96, 125 }, 4, NULL, NULL, NULL, 0.f, 0.f, sfFalse },
+	};
+	unsigned int entriesNb = sizeof(manifest) / sizeof(manifest[0]);
+	AnimationLoadManifest(manifest, entriesNb, NULL, NULL, NULL);
+	sfBool loaded = sfTrue;
+	for (unsigned int i = 0; i < entriesNb; i++)
+	{
+		if (!manifest[i].loaded)
+		{
+			printf("Error during loading of %s !", manifest[i].filename);
+			loaded = sfFalse;
+		}
+	}
+	if (!loaded)
+	{
+		// The game runs without its animations
+		for (unsigned int i = 0; i < entriesNb; i++)
+		{
+			if (manifest[i].anim != NULL)
+			{
+				AnimationDestroy(manifest[i].anim);
+			}
+		}
+		return;
+	}
+	anim = manifest[0].anim;
 	AnimationPlay(anim, DEFAULT | LOOPED);
 	AnimationSetFramerate(anim, 8);
 	AnimationMove(anim, (sfVector2f) { 256 / 2, 256 / 2 });
@@ -29,6 +51,11 @@ static void GameEvents(sfRenderWindow* _window)
 		{
 		// key pressed
 		case sfEvtKeyPressed:
+			// Nothing to control when the game failed to load
+			if (anim == NULL)
+			{
+				break;
+			}
 			switch (event.key.code)
 			{
 			case sfKeyEnter:
@@ -92,13 +119,22 @@ static void GameEvents(sfRenderWindow* _window)
 void GameUpdate(float _dt, sfRenderWindow* _window)
 {
 	GameEvents(_window);
-	AnimationUpdate(anim, _dt);
+	if (anim != NULL)
+	{
+		AnimationUpdate(anim, _dt);
+	}
 }
 void GameDraw(sfRenderWindow* _window)
 {
-	AnimationDraw(_window, anim, NULL);
+	if (anim != NULL)
+	{
+		AnimationDraw(_window, anim, NULL);
+	}
 }
 void GameDestroy()
 {
-	AnimationDestroy(anim);
+	if (anim != NULL)
+	{
+		AnimationDestroy(anim);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,362 @@
+#include "JobPool.h"
+
+#include <SFML/System.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// CSFML has no condition variable, the parked workers wait on the ones
+// of the system
+#if defined(_WIN32)
+typedef SRWLOCK JobLock;
+typedef CONDITION_VARIABLE JobCondition;
+#define JOB_LOCK_INIT(_lock) (InitializeSRWLock(_lock), sfTrue)
+#define JOB_LOCK_DESTROY(_lock) ((void)(_lock))
+#define JOB_LOCK(_lock) AcquireSRWLockExclusive(_lock)
+#define JOB_UNLOCK(_lock) ReleaseSRWLockExclusive(_lock)
+#define JOB_CONDITION_INIT(_condition) (InitializeConditionVariable(_condition), sfTrue)
+#define JOB_CONDITION_DESTROY(_condition) ((void)(_condition))
+#define JOB_WAIT(_condition, _lock) SleepConditionVariableSRW(_condition, _lock, INFINITE, 0)
+#define JOB_BROADCAST(_condition) WakeAllConditionVariable(_condition)
+#define JOB_SIGNAL(_condition) WakeConditionVariable(_condition)
+#else
+typedef pthread_mutex_t JobLock;
+typedef pthread_cond_t JobCondition;
+#define JOB_LOCK_INIT(_lock) (pthread_mutex_init(_lock, NULL) == 0)
+#define JOB_LOCK_DESTROY(_lock) pthread_mutex_destroy(_lock)
+#define JOB_LOCK(_lock) pthread_mutex_lock(_lock)
+#define JOB_UNLOCK(_lock) pthread_mutex_unlock(_lock)
+#define JOB_CONDITION_INIT(_condition) (pthread_cond_init(_condition, NULL) == 0)
+#define JOB_CONDITION_DESTROY(_condition) pthread_cond_destroy(_condition)
+#define JOB_WAIT(_condition, _lock) pthread_cond_wait(_condition, _lock)
+#define JOB_BROADCAST(_condition) pthread_cond_broadcast(_condition)
+#define JOB_SIGNAL(_condition) pthread_cond_signal(_condition)
+#endif
+
+/// @brief Chunks left to a worker, [head, tail)
+///
+/// The owner pops from the head, thieves take from the tail.
+typedef struct JobQueue
+{
+	sfMutex* mutex;
+	unsigned int head;
+	unsigned int tail;
+} JobQueue;
+
+typedef struct JobWorker
+{
+	JobPool* pool;
+	unsigned int index;
+	JobQueue queue;
+	sfThread* thread;
+} JobWorker;
+
+struct JobPool
+{
+	unsigned int workersNb;
+	JobWorker* workers;
+
+	// Parked workers
+	JobLock lock;
+	/// Wakes the workers up for a run or to quit
+	JobCondition wake;
+	/// Wakes the caller up once the workers are done
+	JobCondition done;
+	/// Incremented by each run, a worker works once per run
+	unsigned int run;
+	/// Workers still working on the current run
+	unsigned int busyNb;
+	sfBool quit;
+	/// sfTrue once the lock and conditions are created
+	sfBool parking;
+
+	// Job being run
+	JobFunction function;
+	void* userData;
+	unsigned int itemsNb;
+	unsigned int chunkSize;
+};
+
+unsigned int JobPoolGetHardwareConcurrency(void)
+{
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#else
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	return cores > 0 ? (unsigned int)cores : 1;
+#endif
+}
+
+static sfBool JobQueuePop(JobQueue* _queue, unsigned int* _chunk)
+{
+	sfBool found = sfFalse;
+	sfMutex_lock(_queue->mutex);
+	if (_queue->head < _queue->tail)
+	{
+		*_chunk = _queue->head++;
+		found = sfTrue;
+	}
+	sfMutex_unlock(_queue->mutex);
+	return found;
+}
+
+// Take half of the chunks of another worker, run the first one right away
+static sfBool JobPoolSteal(JobPool* _pool, JobWorker* _thief, unsigned int* _chunk)
+{
+	for (unsigned int i = 1; i < _pool->workersNb; i++)
+	{
+		JobQueue* victim = &_pool->workers[(_thief->index + i) % _pool->workersNb].queue;
+		unsigned int begin = 0;
+		unsigned int end = 0;
+
+		sfMutex_lock(victim->mutex);
+		if (victim->head < victim->tail)
+		{
+			unsigned int stolen = (victim->tail - victim->head + 1) / 2;
+			end = victim->tail;
+			begin = end - stolen;
+			victim->tail = begin;
+		}
+		sfMutex_unlock(victim->mutex);
+
+		if (begin < end)
+		{
+			sfMutex_lock(_thief->queue.mutex);
+			_thief->queue.head = begin + 1;
+			_thief->queue.tail = end;
+			sfMutex_unlock(_thief->queue.mutex);
+			*_chunk = begin;
+			return sfTrue;
+		}
+	}
+	return sfFalse;
+}
+
+static void JobPoolWork(JobWorker* _worker)
+{
+	JobPool* pool = _worker->pool;
+	unsigned int chunk;
+
+	// No chunk is added during a run: when nothing can be stolen, the job is done
+	while (JobQueuePop(&_worker->queue, &chunk)
+		|| JobPoolSteal(pool, _worker, &chunk))
+	{
+		unsigned int begin = chunk * pool->chunkSize;
+		unsigned int end = begin + pool->chunkSize;
+		if (end > pool->itemsNb)
+		{
+			end = pool->itemsNb;
+		}
+		pool->function(pool->userData, begin, end, _worker->index);
+	}
+}
+
+// Worker threads live as long as the pool, parked between the runs
+static void JobPoolThreadEntry(void* _worker)
+{
+	JobWorker* worker = (JobWorker*)_worker;
+	JobPool* pool = worker->pool;
+	unsigned int run = 0;
+	for (;;)
+	{
+		JOB_LOCK(&pool->lock);
+		while (pool->run == run && !pool->quit)
+		{
+			JOB_WAIT(&pool->wake, &pool->lock);
+		}
+		if (pool->quit)
+		{
+			JOB_UNLOCK(&pool->lock);
+			return;
+		}
+		run = pool->run;
+		JOB_UNLOCK(&pool->lock);
+
+		JobPoolWork(worker);
+
+		JOB_LOCK(&pool->lock);
+		if (--pool->busyNb == 0)
+		{
+			JOB_SIGNAL(&pool->done);
+		}
+		JOB_UNLOCK(&pool->lock);
+	}
+}
+
+JobPool* JobPoolCreate(unsigned int _workersNb)
+{
+	JobPool* pool = (JobPool*)calloc(1, sizeof(JobPool));
+	if (pool == NULL)
+	{
+		printf("Error during memory allocation !");
+		return NULL;
+	}
+	pool->workersNb =
+		_workersNb > 0 ? _workersNb : JobPoolGetHardwareConcurrency();
+	pool->workers = (JobWorker*)calloc(pool->workersNb, sizeof(JobWorker));
+	if (pool->workers == NULL)
+	{
+		printf("Error during memory allocation !");
+		free(pool);
+		return NULL;
+	}
+	if (!JOB_LOCK_INIT(&pool->lock))
+	{
+		printf("Error during cration of the job pool workers !");
+		free(pool->workers);
+		free(pool);
+		return NULL;
+	}
+	if (!JOB_CONDITION_INIT(&pool->wake))
+	{
+		printf("Error during cration of the job pool workers !");
+		JOB_LOCK_DESTROY(&pool->lock);
+		free(pool->workers);
+		free(pool);
+		return NULL;
+	}
+	if (!JOB_CONDITION_INIT(&pool->done))
+	{
+		printf("Error during cration of the job pool workers !");
+		JOB_CONDITION_DESTROY(&pool->wake);
+		JOB_LOCK_DESTROY(&pool->lock);
+		free(pool->workers);
+		free(pool);
+		return NULL;
+	}
+	pool->parking = sfTrue;
+
+	for (unsigned int i = 0; i < pool->workersNb; i++)
+	{
+		JobWorker* worker = &pool->workers[i];
+		worker->pool = pool;
+		worker->index = i;
+		worker->queue.mutex = sfMutex_create();
+		// The caller is the worker 0, it needs no thread
+		worker->thread = i > 0
+			? sfThread_create(JobPoolThreadEntry, worker)
+			: NULL;
+		if (worker->queue.mutex == NULL || (i > 0 && worker->thread == NULL))
+		{
+			printf("Error during cration of the job pool workers !");
+			pool->workersNb = i + 1;
+			JobPoolDestroy(pool);
+			return NULL;
+		}
+	}
+
+	// Started once, the workers wait for the runs
+	for (unsigned int i = 1; i < pool->workersNb; i++)
+	{
+		sfThread_launch(pool->workers[i].thread);
+	}
+	return pool;
+}
+
+void JobPoolDestroy(JobPool* _pool)
+{
+	if (_pool == NULL)
+	{
+		return;
+	}
+	if (_pool->parking)
+	{
+		JOB_LOCK(&_pool->lock);
+		_pool->quit = sfTrue;
+		JOB_BROADCAST(&_pool->wake);
+		JOB_UNLOCK(&_pool->lock);
+	}
+	for (unsigned int i = 0; i < _pool->workersNb; i++)
+	{
+		if (_pool->workers[i].thread != NULL)
+		{
+			sfThread_destroy(_pool->workers[i].thread);
+		}
+		if (_pool->workers[i].queue.mutex != NULL)
+		{
+			sfMutex_destroy(_pool->workers[i].queue.mutex);
+		}
+	}
+	if (_pool->parking)
+	{
+		JOB_CONDITION_DESTROY(&_pool->done);
+		JOB_CONDITION_DESTROY(&_pool->wake);
+		JOB_LOCK_DESTROY(&_pool->lock);
+	}
+	free(_pool->workers);
+	free(_pool);
+}
+
+unsigned int JobPoolGetWorkersNb(const JobPool* _pool)
+{
+	return _pool->workersNb;
+}
+
+void JobPoolRun(
+	JobPool* _pool,
+	JobFunction _function,
+	void* _userData,
+	unsigned int _itemsNb,
+	unsigned int _chunkSize)
+{
+	if (_itemsNb == 0)
+	{
+		return;
+	}
+	if (_chunkSize == 0)
+	{
+		_chunkSize = 1;
+	}
+	unsigned int chunksNb = (_itemsNb + _chunkSize - 1) / _chunkSize;
+
+	// Not worth waking up threads
+	if (_pool->workersNb == 1 || chunksNb == 1)
+	{
+		_function(_userData, 0, _itemsNb, 0);
+		return;
+	}
+
+	_pool->function = _function;
+	_pool->userData = _userData;
+	_pool->itemsNb = _itemsNb;
+	_pool->chunkSize = _chunkSize;
+
+	// Deal the chunks evenly, stealing balances the rest
+	unsigned int workersNb =
+		chunksNb < _pool->workersNb ? chunksNb : _pool->workersNb;
+	for (unsigned int i = 0; i < _pool->workersNb; i++)
+	{
+		JobQueue* queue = &_pool->workers[i].queue;
+		queue->head = i < workersNb
+			? (unsigned int)((unsigned long long)chunksNb * i / workersNb)
+			: 0;
+		queue->tail = i < workersNb
+			? (unsigned int)((unsigned long long)chunksNb * (i + 1) / workersNb)
+			: 0;
+	}
+
+	// Wake the parked workers up, those without chunks steal some
+	JOB_LOCK(&_pool->lock);
+	_pool->busyNb = _pool->workersNb - 1;
+	_pool->run++;
+	JOB_BROADCAST(&_pool->wake);
+	JOB_UNLOCK(&_pool->lock);
+
+	JobPoolWork(&_pool->workers[0]);
+
+	// Barrier: every chunk is done once all the workers are back
+	JOB_LOCK(&_pool->lock);
+	while (_pool->busyNb > 0)
+	{
+		JOB_WAIT(&_pool->done, &_pool->lock);
+	}
+	JOB_UNLOCK(&_pool->lock);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/System.h>
+
+/// @brief Pool of worker threads running a job split into chunks
+///
+/// Chunks are dealt evenly between the workers, a worker running out of
+/// chunks steals half of the chunks left to another one. The threads are
+/// started with the pool and parked between the runs.
+typedef struct JobPool JobPool;
+
+//////////////////////////////////////////////////////////////
+/// @brief Function running a chunk of a job
+///
+/// @param _userData User data given to JobPoolRun
+///
+/// @param _begin First item of the chunk
+///
+/// @param _end Item after the last one of the chunk
+///
+/// @param _worker Index of the worker running the chunk, 0 is the caller
+//////////////////////////////////////////////////////////////
+typedef void (*JobFunction)(
+	void* _userData,
+	unsigned int _begin,
+	unsigned int _end,
+	unsigned int _worker);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of cores of the computer
+///
+/// @return Number of logical cores, at least 1
+//////////////////////////////////////////////////////////////
+unsigned int JobPoolGetHardwareConcurrency(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a new job pool
+///
+/// @param _workersNb Number of workers including the calling thread,
+///					 0 to use one worker per core
+///
+/// @return Job pool object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+JobPool* JobPoolCreate(unsigned int _workersNb);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy an existing job pool
+///
+/// @param _pool Job pool object
+//////////////////////////////////////////////////////////////
+void JobPoolDestroy(JobPool* _pool);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of workers of a job pool
+///
+/// @param _pool Job pool object
+///
+/// @return Number of workers including the calling thread
+//////////////////////////////////////////////////////////////
+unsigned int JobPoolGetWorkersNb(const JobPool* _pool);
+
+//////////////////////////////////////////////////////////////
+/// @brief Run a job on all the workers of a pool
+///
+/// The calling thread works too, and the function returns once every
+/// chunk is done, so it acts as a barrier.
+///
+/// @param _pool Job pool object
+///
+/// @param _function Function running a chunk
+///
+/// @param _userData User data given to the function
+///
+/// @param _itemsNb Number of items of the job
+///
+/// @param _chunkSize Number of items per chunk
+//////////////////////////////////////////////////////////////
+void JobPoolRun(
+	JobPool* _pool,
+	JobFunction _function,
+	void* _userData,
+	unsigned int _itemsNb,
+	unsigned int _chunkSize);
@@ -4,7 +4,10 @@
 #include <SFML/Window.h>
 #include <stdio.h>
 #include <time.h>
+
+#if defined(_WIN32)
 #include <Windows.h>
+#endif
 
 
 
@@ -23,6 +26,7 @@ static sfRenderWindow* createRenderWindow(
 int main(int argc, char* argv[], char* envp[])
 {
 	// check if the version is debug or release
+#if defined(_WIN32)
 #ifdef NDEBUG
 	// hide console on release
 	HWND hwnd = GetConsoleWindow();
@@ -31,6 +35,7 @@ int main(int argc, char* argv[], char* envp[])
 	// activate console on debug
 	HWND hwnd = GetConsoleWindow();
 	ShowWindow(hwnd, SW_SHOW);
+#endif
 #endif
 
 	// seed random
@@ -0,0 +1,313 @@
+#include "SpatialGrid.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// Number of buckets the cells are hashed into, a power of two
+#define SPATIAL_GRID_BUCKETS 4096u
+#define SPATIAL_GRID_MASK (SPATIAL_GRID_BUCKETS - 1)
+/// Value of an id that ends a bucket
+#define SPATIAL_GRID_NONE 0xFFFFFFFFu
+
+/// @brief Place of an id in the grid
+typedef struct SpatialGridNode
+{
+	sfFloatRect bounds;
+	unsigned int next;
+	unsigned int prev;
+	/// Bucket of the node, SPATIAL_GRID_NONE when it is not in the grid
+	unsigned int bucket;
+	/// Last query that found the node, a bucket can be seen twice
+	unsigned int queryStamp;
+} SpatialGridNode;
+
+struct SpatialGrid
+{
+	float cellSize;
+	unsigned int capacity;
+	/// Number of ids in the grid
+	unsigned int count;
+	unsigned int queryStamp;
+	/// Largest half size of the bounds inserted, never shrinks
+	sfVector2f maxExtent;
+	/// First id of each bucket, ids of a bucket are a doubly linked list
+	unsigned int heads[SPATIAL_GRID_BUCKETS];
+
+	SpatialGridNode* nodes;
+
+	/// Ids found by the last query, as large as the capacity
+	unsigned int* found;
+};
+
+SpatialGrid* SpatialGridCreate(float _cellSize)
+{
+	if (_cellSize <= 0)
+	{
+		printf("Error : the cell size of a spatial grid must be positive !");
+		return NULL;
+	}
+	SpatialGrid* grid = (SpatialGrid*)calloc(1, sizeof(SpatialGrid));
+	if (grid == NULL)
+	{
+		printf("Error during memory allocation !");
+		return NULL;
+	}
+	grid->cellSize = _cellSize;
+	for (unsigned int i = 0; i < SPATIAL_GRID_BUCKETS; i++)
+	{
+		grid->heads[i] = SPATIAL_GRID_NONE;
+	}
+	return grid;
+}
+
+void SpatialGridDestroy(SpatialGrid* _grid)
+{
+	if (_grid == NULL)
+	{
+		return;
+	}
+	free(_grid->nodes);
+	free(_grid->found);
+	free(_grid);
+}
+
+static sfBool SpatialGridGrowArray(void** _array, size_t _elementSize, unsigned int _capacity)
+{
+	void* array = realloc(*_array, _elementSize * _capacity);
+	if (array == NULL)
+	{
+		printf("Error during memory allocation !");
+		return sfFalse;
+	}
+	*_array = array;
+	return sfTrue;
+}
+
+sfBool SpatialGridReserve(SpatialGrid* _grid, unsigned int _capacity)
+{
+	if (_capacity <= _grid->capacity)
+	{
+		return sfTrue;
+	}
+	if (!SpatialGridGrowArray((void**)&_grid->nodes, sizeof(SpatialGridNode), _capacity)
+		|| !SpatialGridGrowArray((void**)&_grid->found, sizeof(unsigned int), _capacity))
+	{
+		return sfFalse;
+	}
+	for (unsigned int i = _grid->capacity; i < _capacity; i++)
+	{
+		_grid->nodes[i].bucket = SPATIAL_GRID_NONE;
+		_grid->nodes[i].queryStamp = 0;
+	}
+	_grid->capacity = _capacity;
+	return sfTrue;
+}
+
+float SpatialGridGetCellSize(const SpatialGrid* _grid)
+{
+	return _grid->cellSize;
+}
+
+unsigned int SpatialGridGetCount(const SpatialGrid* _grid)
+{
+	return _grid->count;
+}
+
+// Cell holding a coordinate
+static int SpatialGridGetCell(const SpatialGrid* _grid, float _coordinate)
+{
+	return (int)floorf(_coordinate / _grid->cellSize);
+}
+
+static unsigned int SpatialGridHash(int _cellX, int _cellY)
+{
+	return ((unsigned int)_cellX * 73856093u ^ (unsigned int)_cellY * 19349663u)
+		& SPATIAL_GRID_MASK;
+}
+
+// Bucket of the cell holding the center of some bounds
+static unsigned int SpatialGridGetBucket(const SpatialGrid* _grid, sfFloatRect _bounds)
+{
+	return SpatialGridHash(
+		SpatialGridGetCell(_grid, _bounds.left + _bounds.width / 2),
+		SpatialGridGetCell(_grid, _bounds.top + _bounds.height / 2));
+}
+
+static void SpatialGridLink(SpatialGrid* _grid, unsigned int _id, unsigned int _bucket)
+{
+	unsigned int head = _grid->heads[_bucket];
+	_grid->nodes[_id].next = head;
+	_grid->nodes[_id].prev = SPATIAL_GRID_NONE;
+	if (head != SPATIAL_GRID_NONE)
+	{
+		_grid->nodes[head].prev = _id;
+	}
+	_grid->heads[_bucket] = _id;
+	_grid->nodes[_id].bucket = _bucket;
+	_grid->count++;
+}
+
+static void SpatialGridUnlink(SpatialGrid* _grid, unsigned int _id)
+{
+	unsigned int next = _grid->nodes[_id].next;
+	unsigned int prev = _grid->nodes[_id].prev;
+	if (prev != SPATIAL_GRID_NONE)
+	{
+		_grid->nodes[prev].next = next;
+	}
+	else
+	{
+		_grid->heads[_grid->nodes[_id].bucket] = next;
+	}
+	if (next != SPATIAL_GRID_NONE)
+	{
+		_grid->nodes[next].prev = prev;
+	}
+	_grid->nodes[_id].bucket = SPATIAL_GRID_NONE;
+	_grid->count--;
+}
+
+void SpatialGridInsert(SpatialGrid* _grid, unsigned int _id, sfFloatRect _bounds)
+{
+	SpatialGridNode* node = &_grid->nodes[_id];
+	node->bounds = _bounds;
+	if (_bounds.width / 2 > _grid->maxExtent.x)
+	{
+		_grid->maxExtent.x = _bounds.width / 2;
+	}
+	if (_bounds.height / 2 > _grid->maxExtent.y)
+	{
+		_grid->maxExtent.y = _bounds.height / 2;
+	}
+
+	// Most moves stay in the same cell
+	unsigned int bucket = SpatialGridGetBucket(_grid, _bounds);
+	if (node->bucket == bucket)
+	{
+		return;
+	}
+	if (node->bucket != SPATIAL_GRID_NONE)
+	{
+		SpatialGridUnlink(_grid, _id);
+	}
+	SpatialGridLink(_grid, _id, bucket);
+}
+
+void SpatialGridRemove(SpatialGrid* _grid, unsigned int _id)
+{
+	if (_grid->nodes[_id].bucket != SPATIAL_GRID_NONE)
+	{
+		SpatialGridUnlink(_grid, _id);
+	}
+}
+
+void SpatialGridMove(SpatialGrid* _grid, unsigned int _from, unsigned int _to)
+{
+	unsigned int bucket = _grid->nodes[_from].bucket;
+	if (bucket == SPATIAL_GRID_NONE)
+	{
+		return;
+	}
+	_grid->nodes[_to] = _grid->nodes[_from];
+	unsigned int next = _grid->nodes[_to].next;
+	unsigned int prev = _grid->nodes[_to].prev;
+	if (prev != SPATIAL_GRID_NONE)
+	{
+		_grid->nodes[prev].next = _to;
+	}
+	else
+	{
+		_grid->heads[bucket] = _to;
+	}
+	if (next != SPATIAL_GRID_NONE)
+	{
+		_grid->nodes[next].prev = _to;
+	}
+	_grid->nodes[_from].bucket = SPATIAL_GRID_NONE;
+}
+
+// Add the ids of a bucket intersecting an area to the found ones
+static unsigned int SpatialGridQueryBucket(
+	SpatialGrid* _grid,
+	unsigned int _bucket,
+	sfFloatRect _area,
+	unsigned int _foundNb)
+{
+	for (unsigned int id = _grid->heads[_bucket]; id != SPATIAL_GRID_NONE;
+		id = _grid->nodes[id].next)
+	{
+		SpatialGridNode* node = &_grid->nodes[id];
+		if (node->queryStamp == _grid->queryStamp)
+		{
+			continue;
+		}
+		node->queryStamp = _grid->queryStamp;
+		if (node->bounds.left <= _area.left + _area.width
+			&& _area.left <= node->bounds.left + node->bounds.width
+			&& node->bounds.top <= _area.top + _area.height
+			&& _area.top <= node->bounds.top + node->bounds.height)
+		{
+			_grid->found[_foundNb++] = id;
+		}
+	}
+	return _foundNb;
+}
+
+unsigned int SpatialGridQuery(
+	SpatialGrid* _grid,
+	sfFloatRect _area,
+	const unsigned int** _found)
+{
+	unsigned int foundNb = 0;
+	*_found = _grid->found;
+	if (++_grid->queryStamp == 0)
+	{
+		// The stamps wrapped, forget the old ones
+		for (unsigned int i = 0; i < _grid->capacity; i++)
+		{
+			_grid->nodes[i].queryStamp = 0;
+		}
+		_grid->queryStamp = 1;
+	}
+
+	// Centers of the bounds touching the area are this far from it at most
+	float left = _area.left - _grid->maxExtent.x;
+	float top = _area.top - _grid->maxExtent.y;
+	float right = _area.left + _area.width + _grid->maxExtent.x;
+	float bottom = _area.top + _area.height + _grid->maxExtent.y;
+	double cellsX = floor(right / _grid->cellSize) - floor(left / _grid->cellSize) + 1;
+	double cellsY = floor(bottom / _grid->cellSize) - floor(top / _grid->cellSize) + 1;
+
+	// A wide area sees every bucket anyway
+	if (cellsX * cellsY >= SPATIAL_GRID_BUCKETS)
+	{
+		for (unsigned int bucket = 0; bucket < SPATIAL_GRID_BUCKETS; bucket++)
+		{
+			foundNb = SpatialGridQueryBucket(_grid, bucket, _area, foundNb);
+		}
+		return foundNb;
+	}
+	int lastX = SpatialGridGetCell(_grid, right);
+	int lastY = SpatialGridGetCell(_grid, bottom);
+	for (int y = SpatialGridGetCell(_grid, top); y <= lastY; y++)
+	{
+		for (int x = SpatialGridGetCell(_grid, left); x <= lastX; x++)
+		{
+			foundNb = SpatialGridQueryBucket(_grid, SpatialGridHash(x, y), _area, foundNb);
+		}
+	}
+	return foundNb;
+}
+
+static int SpatialGridCompareIds(const void* _a, const void* _b)
+{
+	unsigned int a = *(const unsigned int*)_a;
+	unsigned int b = *(const unsigned int*)_b;
+	return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+void SpatialGridSortFound(SpatialGrid* _grid, unsigned int _foundNb)
+{
+	qsort(_grid->found, _foundNb, sizeof(unsigned int), SpatialGridCompareIds);
+}
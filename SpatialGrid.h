@@ -0,0 +1,123 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+
+/// @brief Loose uniform grid of integer ids with rectangular bounds
+///
+/// Each id lives in the cell holding the center of its bounds, cells are
+/// hashed into a fixed number of buckets so the grid has no limits.
+/// Moving an id is O(1), a query looks at the cells of the area grown by
+/// the largest half size of the bounds met so far.
+typedef struct SpatialGrid SpatialGrid;
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a new spatial grid
+///
+/// @param _cellSize Width and height of a cell, about the size of the
+///					largest bounds works best
+///
+/// @return Spatial grid object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+SpatialGrid* SpatialGridCreate(float _cellSize);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy an existing spatial grid
+///
+/// @param _grid Spatial grid object
+//////////////////////////////////////////////////////////////
+void SpatialGridDestroy(SpatialGrid* _grid);
+
+//////////////////////////////////////////////////////////////
+/// @brief Make room for the ids below a capacity
+///
+/// @param _grid Spatial grid object
+///
+/// @param _capacity Number of ids, new ids are not in the grid
+///
+/// @return sfTrue if the ids fit, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool SpatialGridReserve(SpatialGrid* _grid, unsigned int _capacity);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the size of a cell of a spatial grid
+///
+/// @param _grid Spatial grid object
+///
+/// @return Width and height of a cell
+//////////////////////////////////////////////////////////////
+float SpatialGridGetCellSize(const SpatialGrid* _grid);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of ids in a spatial grid
+///
+/// @param _grid Spatial grid object
+///
+/// @return Number of ids inserted and not removed
+//////////////////////////////////////////////////////////////
+unsigned int SpatialGridGetCount(const SpatialGrid* _grid);
+
+//////////////////////////////////////////////////////////////
+/// @brief Put an id in a spatial grid
+///
+/// An id already in the grid is moved to its new bounds.
+///
+/// @param _grid Spatial grid object
+///
+/// @param _id Id below the capacity
+///
+/// @param _bounds Bounds of the id
+//////////////////////////////////////////////////////////////
+void SpatialGridInsert(SpatialGrid* _grid, unsigned int _id, sfFloatRect _bounds);
+
+//////////////////////////////////////////////////////////////
+/// @brief Remove an id from a spatial grid
+///
+/// @param _grid Spatial grid object
+///
+/// @param _id Id below the capacity, ignored if it is not in the grid
+//////////////////////////////////////////////////////////////
+void SpatialGridRemove(SpatialGrid* _grid, unsigned int _id);
+
+//////////////////////////////////////////////////////////////
+/// @brief Give the place of an id to another id
+///
+/// Used when the owner of an id is moved, the source id is removed.
+///
+/// @param _grid Spatial grid object
+///
+/// @param _from Id to move, ignored if it is not in the grid
+///
+/// @param _to Id taking its place, not in the grid
+//////////////////////////////////////////////////////////////
+void SpatialGridMove(SpatialGrid* _grid, unsigned int _from, unsigned int _to);
+
+//////////////////////////////////////////////////////////////
+/// @brief Find the ids whose bounds intersect an area
+///
+/// The list stays valid until the next query, ids come in no
+/// particular order.
+///
+/// @param _grid Spatial grid object
+///
+/// @param _area Area to look in
+///
+/// @param _found Filled with the ids found
+///
+/// @return Number of ids found
+//////////////////////////////////////////////////////////////
+unsigned int SpatialGridQuery(
+	SpatialGrid* _grid,
+	sfFloatRect _area,
+	const unsigned int** _found);
+
+//////////////////////////////////////////////////////////////
+/// @brief Sort the ids found by the last query in increasing order
+///
+/// @param _grid Spatial grid object
+///
+/// @param _foundNb Number of ids found by the last query
+//////////////////////////////////////////////////////////////
+void SpatialGridSortFound(SpatialGrid* _grid, unsigned int _foundNb);
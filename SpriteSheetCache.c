@@ -0,0 +1,393 @@
+#include "SpriteSheetCache.h"
+
+#include <SFML/Graphics.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/// Version of the cache files, to change with their layout
+#define SPRITE_SHEET_CACHE_VERSION 2
+
+/// Length of the path of a cache file
+#define SPRITE_SHEET_CACHE_PATH_LENGTH 1024
+
+/// @brief Start of a cache file, followed by the name of the image file
+/// and the RGBA pixels
+typedef struct SpriteSheetCacheHeader
+{
+	char magic[4];
+	unsigned int version;
+	/// FNV-1a hash of the bytes and size of the image file when it was
+	/// decoded
+	unsigned long long contentHash;
+	long long fileSize;
+	/// Area asked for, and size of the pixels once cropped
+	sfIntRect area;
+	unsigned int width;
+	unsigned int height;
+	unsigned int filenameLength;
+} SpriteSheetCacheHeader;
+
+/// @brief Cache file mapped in memory
+typedef struct SpriteSheetCacheMapping
+{
+	const unsigned char* data;
+	size_t size;
+} SpriteSheetCacheMapping;
+
+static char* cacheDirectory = NULL;
+
+void SpriteSheetCacheSetDirectory(const char* _directory)
+{
+	free(cacheDirectory);
+	cacheDirectory = NULL;
+	if (_directory == NULL)
+	{
+		return;
+	}
+	cacheDirectory = (char*)malloc(strlen(_directory) + 1);
+	if (cacheDirectory == NULL)
+	{
+		printf("Error during memory allocation !");
+		return;
+	}
+	strcpy(cacheDirectory, _directory);
+}
+
+const char* SpriteSheetCacheGetDirectory(void)
+{
+	return cacheDirectory;
+}
+
+// Cache file of an image area, named after the FNV-1a hash of the key
+static void SpriteSheetCacheGetPath(
+	const char* _filename,
+	sfIntRect _area,
+	char* _path,
+	size_t _size)
+{
+	unsigned long long hash = 14695981039346656037ull;
+	for (const char* c = _filename; *c != '\0'; c++)
+	{
+		hash = (hash ^ (unsigned char)*c) * 1099511628211ull;
+	}
+	const unsigned char* bytes = (const unsigned char*)&_area;
+	for (size_t i = 0; i < sizeof(_area); i++)
+	{
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+	}
+	snprintf(_path, _size, "%s/%016llx.rgba", cacheDirectory, hash);
+}
+
+static sfBool SpriteSheetCacheMap(const char* _path, SpriteSheetCacheMapping* _mapping)
+{
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(_path, GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return sfFalse;
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return sfFalse;
+	}
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (mapping == NULL)
+	{
+		return sfFalse;
+	}
+	// The view keeps the mapping alive
+	_mapping->data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (_mapping->data == NULL)
+	{
+		return sfFalse;
+	}
+	_mapping->size = (size_t)size.QuadPart;
+#else
+	int file = open(_path, O_RDONLY);
+	if (file < 0)
+	{
+		return sfFalse;
+	}
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size == 0)
+	{
+		close(file);
+		return sfFalse;
+	}
+	void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED)
+	{
+		return sfFalse;
+	}
+	_mapping->data = (const unsigned char*)data;
+	_mapping->size = (size_t)info.st_size;
+#endif
+	return sfTrue;
+}
+
+static void SpriteSheetCacheUnmap(SpriteSheetCacheMapping* _mapping)
+{
+#if defined(_WIN32)
+	UnmapViewOfFile(_mapping->data);
+#else
+	munmap((void*)_mapping->data, _mapping->size);
+#endif
+	_mapping->data = NULL;
+}
+
+// Hash the bytes of an image file, so that an entry is stale as soon as
+// the file changes, even within the resolution of its modification time
+static sfBool SpriteSheetCacheHashFile(
+	const char* _filename,
+	unsigned long long* _hash,
+	long long* _size)
+{
+	SpriteSheetCacheMapping mapping;
+	if (!SpriteSheetCacheMap(_filename, &mapping))
+	{
+		return sfFalse;
+	}
+	unsigned long long hash = 14695981039346656037ull;
+	for (size_t i = 0; i < mapping.size; i++)
+	{
+		hash = (hash ^ mapping.data[i]) * 1099511628211ull;
+	}
+	*_hash = hash;
+	*_size = (long long)mapping.size;
+	SpriteSheetCacheUnmap(&mapping);
+	return sfTrue;
+}
+
+// Map the cache file of an image area, sfFalse if it is missing or stale
+static sfBool SpriteSheetCacheOpen(
+	const char* _path,
+	const char* _filename,
+	sfIntRect _area,
+	const SpriteSheetCacheHeader* _expected,
+	SpriteSheetCacheMapping* _mapping,
+	const SpriteSheetCacheHeader** _header)
+{
+	if (!SpriteSheetCacheMap(_path, _mapping))
+	{
+		return sfFalse;
+	}
+	const SpriteSheetCacheHeader* header = (const SpriteSheetCacheHeader*)_mapping->data;
+	size_t filenameLength = strlen(_filename);
+	sfBool valid = _mapping->size >= sizeof(SpriteSheetCacheHeader)
+		&& memcmp(header->magic, _expected->magic, sizeof(header->magic)) == 0
+		&& header->version == SPRITE_SHEET_CACHE_VERSION
+		&& header->contentHash == _expected->contentHash
+		&& header->fileSize == _expected->fileSize
+		&& memcmp(&header->area, &_area, sizeof(_area)) == 0
+		&& header->filenameLength == filenameLength
+		&& _mapping->size == sizeof(SpriteSheetCacheHeader) + filenameLength
+			+ (size_t)header->width * header->height * 4
+		&& memcmp(_mapping->data + sizeof(SpriteSheetCacheHeader), _filename, filenameLength) == 0;
+	if (!valid)
+	{
+		SpriteSheetCacheUnmap(_mapping);
+		return sfFalse;
+	}
+	*_header = header;
+	return sfTrue;
+}
+
+static const unsigned char* SpriteSheetCacheGetPixels(const SpriteSheetCacheHeader* _header)
+{
+	return (const unsigned char*)(_header + 1) + _header->filenameLength;
+}
+
+// Decode an image and crop it like sfTexture_createFromFile does
+static sfImage* SpriteSheetCacheDecode(const char* _filename, sfIntRect _area)
+{
+	sfImage* image = sfImage_createFromFile(_filename);
+	if (image == NULL)
+	{
+		return NULL;
+	}
+	sfVector2u size = sfImage_getSize(image);
+	if (_area.width == 0 || _area.height == 0
+		|| (_area.left <= 0 && _area.top <= 0
+			&& _area.width >= (int)size.x && _area.height >= (int)size.y))
+	{
+		return image;
+	}
+
+	sfIntRect rect = _area;
+	if (rect.left < 0)
+	{
+		rect.left = 0;
+	}
+	if (rect.top < 0)
+	{
+		rect.top = 0;
+	}
+	if (rect.left + rect.width > (int)size.x)
+	{
+		rect.width = (int)size.x - rect.left;
+	}
+	if (rect.top + rect.height > (int)size.y)
+	{
+		rect.height = (int)size.y - rect.top;
+	}
+	sfImage* cropped = rect.width > 0 && rect.height > 0
+		? sfImage_createFromColor((unsigned int)rect.width, (unsigned int)rect.height, sfTransparent)
+		: NULL;
+	if (cropped != NULL)
+	{
+		sfImage_copyImage(cropped, image, 0, 0, rect, sfFalse);
+	}
+	sfImage_destroy(image);
+	return cropped;
+}
+
+// Write the pixels of an image area, through a temporary file so that
+// a reader never maps a file being written
+static void SpriteSheetCacheWrite(
+	const char* _path,
+	const char* _filename,
+	SpriteSheetCacheHeader _header,
+	const sfImage* _image)
+{
+	// Named after the process and the image, unique between the loader
+	// threads of every process sharing the directory
+#if defined(_WIN32)
+	unsigned long processId = (unsigned long)GetCurrentProcessId();
+#else
+	unsigned long processId = (unsigned long)getpid();
+#endif
+	char temporaryPath[SPRITE_SHEET_CACHE_PATH_LENGTH + 64];
+	snprintf(temporaryPath, sizeof(temporaryPath), "%s.%lu.%p.tmp",
+		_path, processId, (const void*)_image);
+
+	sfVector2u size = sfImage_getSize(_image);
+	_header.width = size.x;
+	_header.height = size.y;
+	_header.filenameLength = (unsigned int)strlen(_filename);
+
+	FILE* file = fopen(temporaryPath, "wb");
+	if (file == NULL)
+	{
+		printf("Error during writing of the sprite sheet cache !");
+		return;
+	}
+	size_t pixelsSize = (size_t)size.x * size.y * 4;
+	sfBool written = fwrite(&_header, sizeof(_header), 1, file) == 1
+		&& fwrite(_filename, 1, _header.filenameLength, file) == _header.filenameLength
+		&& fwrite(sfImage_getPixelsPtr(_image), 1, pixelsSize, file) == pixelsSize;
+	written = fclose(file) == 0 && written;
+
+#if defined(_WIN32)
+	// rename does not replace an existing file on Windows
+	remove(_path);
+#endif
+	if (!written || rename(temporaryPath, _path) != 0)
+	{
+		printf("Error during writing of the sprite sheet cache !");
+		remove(temporaryPath);
+	}
+}
+
+// Key of an image area in the cache, sfFalse if the cache cannot be used
+static sfBool SpriteSheetCacheGetKey(
+	const char* _filename,
+	sfIntRect _area,
+	char* _path,
+	SpriteSheetCacheHeader* _header)
+{
+	if (cacheDirectory == NULL)
+	{
+		return sfFalse;
+	}
+	memset(_header, 0, sizeof(*_header));
+	memcpy(_header->magic, "ASSC", sizeof(_header->magic));
+	_header->version = SPRITE_SHEET_CACHE_VERSION;
+	_header->area = _area;
+	if (!SpriteSheetCacheHashFile(_filename, &_header->contentHash, &_header->fileSize))
+	{
+		return sfFalse;
+	}
+	SpriteSheetCacheGetPath(_filename, _area, _path, SPRITE_SHEET_CACHE_PATH_LENGTH);
+	return sfTrue;
+}
+
+sfImage* SpriteSheetCacheLoadImage(const char* _filename, const sfIntRect* _area)
+{
+	sfIntRect area = _area != NULL ? *_area : (sfIntRect){ 0, 0, 0, 0 };
+	char path[SPRITE_SHEET_CACHE_PATH_LENGTH];
+	SpriteSheetCacheHeader key;
+	if (!SpriteSheetCacheGetKey(_filename, area, path, &key))
+	{
+		return SpriteSheetCacheDecode(_filename, area);
+	}
+
+	SpriteSheetCacheMapping mapping;
+	const SpriteSheetCacheHeader* header;
+	if (SpriteSheetCacheOpen(path, _filename, area, &key, &mapping, &header))
+	{
+		sfImage* image = sfImage_createFromPixels(
+			header->width, header->height, SpriteSheetCacheGetPixels(header));
+		SpriteSheetCacheUnmap(&mapping);
+		return image;
+	}
+
+	// Missing or stale, decode the image once more
+	sfImage* image = SpriteSheetCacheDecode(_filename, area);
+	if (image != NULL)
+	{
+		SpriteSheetCacheWrite(path, _filename, key, image);
+	}
+	return image;
+}
+
+sfTexture* SpriteSheetCacheLoadTexture(const char* _filename, const sfIntRect* _area)
+{
+	sfIntRect area = _area != NULL ? *_area : (sfIntRect){ 0, 0, 0, 0 };
+	char path[SPRITE_SHEET_CACHE_PATH_LENGTH];
+	SpriteSheetCacheHeader key;
+	if (!SpriteSheetCacheGetKey(_filename, area, path, &key))
+	{
+		return sfTexture_createFromFile(_filename, _area);
+	}
+
+	// Upload straight from the mapped file, without an image copy
+	SpriteSheetCacheMapping mapping;
+	const SpriteSheetCacheHeader* header;
+	if (SpriteSheetCacheOpen(path, _filename, area, &key, &mapping, &header))
+	{
+		sfTexture* texture = sfTexture_create(header->width, header->height);
+		if (texture != NULL)
+		{
+			sfTexture_updateFromPixels(texture, SpriteSheetCacheGetPixels(header),
+				header->width, header->height, 0, 0);
+		}
+		SpriteSheetCacheUnmap(&mapping);
+		return texture;
+	}
+
+	sfImage* image = SpriteSheetCacheDecode(_filename, area);
+	if (image == NULL)
+	{
+		return NULL;
+	}
+	SpriteSheetCacheWrite(path, _filename, key, image);
+	sfTexture* texture = sfTexture_createFromImage(image, NULL);
+	sfImage_destroy(image);
+	return texture;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+
+//////////////////////////////////////////////////////////////
+/// @brief Enable the on-disk cache of decoded sprite sheets
+///
+/// Each file and area loaded is stored once decoded and cropped as raw
+/// RGBA pixels, later loads map the file and upload the pixels without
+/// decoding the image. An entry is stale, and written again, when the
+/// bytes of the image file change: they are hashed on each load, which
+/// reads the file but costs far less than decoding it.
+/// Must not be called while sprite sheets are loading in the background.
+///
+/// @param _directory Existing directory holding the cache files,
+///					 NULL to disable the cache (default)
+//////////////////////////////////////////////////////////////
+void SpriteSheetCacheSetDirectory(const char* _directory);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the directory of the on-disk cache
+///
+/// @return Cache directory, NULL when the cache is disabled
+//////////////////////////////////////////////////////////////
+const char* SpriteSheetCacheGetDirectory(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Load an area of an image file into a texture
+///
+/// Same as sfTexture_createFromFile, through the cache when enabled.
+///
+/// @param _filename Path of the image file
+///
+/// @param _area Area of the image to load, NULL for the entire image
+///
+/// @return Texture object, or NULL if it cannot be load
+//////////////////////////////////////////////////////////////
+sfTexture* SpriteSheetCacheLoadTexture(const char* _filename, const sfIntRect* _area);
+
+//////////////////////////////////////////////////////////////
+/// @brief Load an area of an image file into an image
+///
+/// Through the cache when enabled, can be called from any thread.
+///
+/// @param _filename Path of the image file
+///
+/// @param _area Area of the image to load, NULL for the entire image
+///
+/// @return Image cropped to the area, or NULL if it cannot be load
+//////////////////////////////////////////////////////////////
+sfImage* SpriteSheetCacheLoadImage(const char* _filename, const sfIntRect* _area);
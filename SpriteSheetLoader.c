@@ -0,0 +1,343 @@
+#include "SpriteSheetLoader.h"
+#include "AnimationProfiler.h"
+#include "SpriteSheetCache.h"
+#include "TextureCache.h"
+
+#include <SFML/Graphics.h>
+#include <SFML/System.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct SpriteSheetRequest
+{
+	// Only touched by the main thread
+	unsigned int refCount;
+	SpriteSheetRequestState state;
+	/// Reference to the texture in the cache once ready
+	sfTexture* texture;
+
+	// Read by the loader thread, never modified after the request
+	char* filename;
+	sfIntRect area;
+	/// Stops at the decoded image, no texture is created
+	sfBool imageOnly;
+
+	// Shared with the loader thread, under the loader mutex
+	sfBool decoded;
+	/// Image already cropped to the area, kept by the image requests
+	sfImage* image;
+	SpriteSheetRequest* next;
+};
+
+/// Requests not uploaded yet, each one holds a reference
+static SpriteSheetRequest** pending = NULL;
+static unsigned int pendingNb = 0;
+static unsigned int pendingCapacity = 0;
+
+// Loader thread, started when a request is queued and stopped when the
+// queue is empty, so that it never waits for work
+static sfThread* loaderThread = NULL;
+static sfMutex* loaderMutex = NULL;
+static sfBool loaderRunning = sfFalse;
+static SpriteSheetRequest* queueHead = NULL;
+static SpriteSheetRequest* queueTail = NULL;
+
+static void SpriteSheetLoaderRun(void* _userData)
+{
+	(void)_userData;
+	for (;;)
+	{
+		sfMutex_lock(loaderMutex);
+		SpriteSheetRequest* request = queueHead;
+		if (request == NULL)
+		{
+			loaderRunning = sfFalse;
+			sfMutex_unlock(loaderMutex);
+			return;
+		}
+		queueHead = request->next;
+		if (queueHead == NULL)
+		{
+			queueTail = NULL;
+		}
+		sfMutex_unlock(loaderMutex);
+
+		// Disk access, decompression and cropping, the slow part
+		sfImage* image = NULL;
+		ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_LOAD);
+		image = SpriteSheetCacheLoadImage(request->filename, &request->area);
+		ANIMATION_PROFILE_END(ANIMATION_PROFILER_LOAD);
+
+		sfMutex_lock(loaderMutex);
+		request->image = image;
+		request->decoded = sfTrue;
+		sfMutex_unlock(loaderMutex);
+	}
+}
+
+static sfBool SpriteSheetLoaderStart(void)
+{
+	if (loaderMutex == NULL)
+	{
+		loaderMutex = sfMutex_create();
+	}
+	if (loaderThread == NULL && loaderMutex != NULL)
+	{
+		loaderThread = sfThread_create(SpriteSheetLoaderRun, NULL);
+	}
+	if (loaderMutex == NULL || loaderThread == NULL)
+	{
+		printf("Error during cration of the sprite sheet loader !");
+		return sfFalse;
+	}
+	return sfTrue;
+}
+
+// Free the thread once nothing is pending anymore
+static void SpriteSheetLoaderStop(void)
+{
+	if (loaderThread != NULL)
+	{
+		sfThread_wait(loaderThread);
+		sfThread_destroy(loaderThread);
+		loaderThread = NULL;
+	}
+	if (loaderMutex != NULL)
+	{
+		sfMutex_destroy(loaderMutex);
+		loaderMutex = NULL;
+	}
+	free(pending);
+	pending = NULL;
+	pendingCapacity = 0;
+}
+
+static SpriteSheetRequest* SpriteSheetLoaderFind(
+	const char* _filename,
+	sfIntRect _area,
+	sfBool _imageOnly)
+{
+	for (unsigned int i = 0; i < pendingNb; i++)
+	{
+		if (pending[i]->imageOnly == _imageOnly
+			&& memcmp(&pending[i]->area, &_area, sizeof(_area)) == 0
+			&& strcmp(pending[i]->filename, _filename) == 0)
+		{
+			return pending[i];
+		}
+	}
+	return NULL;
+}
+
+// Queue a request for the loader thread
+static SpriteSheetRequest* SpriteSheetLoaderQueue(
+	const char* _filename,
+	const sfIntRect* _area,
+	sfBool _imageOnly)
+{
+	sfIntRect area = _area != NULL ? *_area : (sfIntRect){ 0, 0, 0, 0 };
+	SpriteSheetRequest* request = SpriteSheetLoaderFind(_filename, area, _imageOnly);
+	if (request != NULL)
+	{
+		return SpriteSheetRequestRetain(request);
+	}
+
+	if (!SpriteSheetLoaderStart())
+	{
+		return NULL;
+	}
+	if (pendingNb == pendingCapacity)
+	{
+		unsigned int capacity = pendingCapacity > 0 ? pendingCapacity * 2 : 16;
+		SpriteSheetRequest** grown = (SpriteSheetRequest**)realloc(
+			pending, sizeof(SpriteSheetRequest*) * capacity);
+		if (grown == NULL)
+		{
+			printf("Error during memory allocation !");
+			return NULL;
+		}
+		pending = grown;
+		pendingCapacity = capacity;
+	}
+
+	request = (SpriteSheetRequest*)calloc(1, sizeof(SpriteSheetRequest));
+	if (request == NULL)
+	{
+		printf("Error during memory allocation !");
+		return NULL;
+	}
+	request->filename = (char*)malloc(strlen(_filename) + 1);
+	if (request->filename == NULL)
+	{
+		printf("Error during memory allocation !");
+		free(request);
+		return NULL;
+	}
+	strcpy(request->filename, _filename);
+	request->area = area;
+	request->imageOnly = _imageOnly;
+	request->state = SPRITE_SHEET_PENDING;
+	// One reference for the caller, one for the loader until the upload
+	request->refCount = 2;
+	pending[pendingNb++] = request;
+
+	sfMutex_lock(loaderMutex);
+	if (queueTail != NULL)
+	{
+		queueTail->next = request;
+	}
+	else
+	{
+		queueHead = request;
+	}
+	queueTail = request;
+	sfBool launch = !loaderRunning;
+	loaderRunning = sfTrue;
+	sfMutex_unlock(loaderMutex);
+
+	if (launch)
+	{
+		// The previous run may still be returning
+		sfThread_wait(loaderThread);
+		sfThread_launch(loaderThread);
+	}
+	return request;
+}
+
+SpriteSheetRequest* SpriteSheetLoaderRequest(
+	const char* _filename,
+	const sfIntRect* _area)
+{
+	return SpriteSheetLoaderQueue(_filename, _area, sfFalse);
+}
+
+SpriteSheetRequest* SpriteSheetLoaderRequestImage(
+	const char* _filename,
+	const sfIntRect* _area)
+{
+	return SpriteSheetLoaderQueue(_filename, _area, sfTrue);
+}
+
+// Create the texture of a decoded request
+static void SpriteSheetLoaderFinish(SpriteSheetRequest* _request)
+{
+	// Nobody but the loader wants it anymore
+	if (_request->refCount == 1 || _request->image == NULL)
+	{
+		_request->state = SPRITE_SHEET_FAILED;
+	}
+	else if (_request->imageOnly)
+	{
+		// The caller uploads the image itself
+		_request->state = SPRITE_SHEET_READY;
+		return;
+	}
+	else
+	{
+		// Loaded meanwhile by TextureCacheAcquire
+		_request->texture = TextureCacheLookup(_request->filename, &_request->area);
+		if (_request->texture == NULL)
+		{
+			sfTexture* texture = NULL;
+			ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_LOAD);
+			texture = sfTexture_createFromImage(_request->image, NULL);
+			ANIMATION_PROFILE_END(ANIMATION_PROFILER_LOAD);
+			ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_TEXTURE_LOADS, texture != NULL);
+			_request->texture = texture != NULL
+				? TextureCacheInsert(_request->filename, &_request->area, texture)
+				: NULL;
+			if (_request->texture == NULL && texture != NULL)
+			{
+				sfTexture_destroy(texture);
+			}
+		}
+		_request->state = _request->texture != NULL
+			? SPRITE_SHEET_READY
+			: SPRITE_SHEET_FAILED;
+	}
+	if (_request->image != NULL)
+	{
+		sfImage_destroy(_request->image);
+		_request->image = NULL;
+	}
+}
+
+void SpriteSheetLoaderUpload(void)
+{
+	if (pendingNb == 0)
+	{
+		return;
+	}
+	unsigned int i = 0;
+	while (i < pendingNb)
+	{
+		SpriteSheetRequest* request = pending[i];
+		sfMutex_lock(loaderMutex);
+		sfBool decoded = request->decoded;
+		sfMutex_unlock(loaderMutex);
+		if (!decoded)
+		{
+			i++;
+			continue;
+		}
+		SpriteSheetLoaderFinish(request);
+		pending[i] = pending[--pendingNb];
+		SpriteSheetRequestRelease(request);
+	}
+	if (pendingNb == 0)
+	{
+		SpriteSheetLoaderStop();
+	}
+}
+
+void SpriteSheetLoaderFlush(void)
+{
+	if (loaderThread != NULL)
+	{
+		// The loader returns once the queue is empty
+		sfThread_wait(loaderThread);
+	}
+	SpriteSheetLoaderUpload();
+}
+
+unsigned int SpriteSheetLoaderGetPendingNb(void)
+{
+	return pendingNb;
+}
+
+SpriteSheetRequest* SpriteSheetRequestRetain(SpriteSheetRequest* _request)
+{
+	_request->refCount++;
+	return _request;
+}
+
+void SpriteSheetRequestRelease(SpriteSheetRequest* _request)
+{
+	if (_request == NULL || --_request->refCount > 0)
+	{
+		return;
+	}
+	TextureCacheRelease(_request->texture);
+	if (_request->image != NULL)
+	{
+		sfImage_destroy(_request->image);
+	}
+	free(_request->filename);
+	free(_request);
+}
+
+SpriteSheetRequestState SpriteSheetRequestGetState(const SpriteSheetRequest* _request)
+{
+	return _request->state;
+}
+
+sfTexture* SpriteSheetRequestGetTexture(const SpriteSheetRequest* _request)
+{
+	return _request->texture;
+}
+
+const sfImage* SpriteSheetRequestGetImage(const SpriteSheetRequest* _request)
+{
+	return _request->state == SPRITE_SHEET_READY ? _request->image : NULL;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+
+/// @brief Sprite sheet being loaded in the background
+typedef struct SpriteSheetRequest SpriteSheetRequest;
+
+/// @brief Progress of a sprite sheet request
+typedef enum SpriteSheetRequestState
+{
+	/// @brief Waiting for its image to be decoded or uploaded
+	SPRITE_SHEET_PENDING = 0,
+	/// @brief The texture can be used
+	SPRITE_SHEET_READY,
+	/// @brief The file cannot be loaded
+	SPRITE_SHEET_FAILED
+} SpriteSheetRequestState;
+
+//////////////////////////////////////////////////////////////
+/// @brief Ask for an area of a file to be loaded in the background
+///
+/// The image is decoded on a loader thread, the texture is created by
+/// SpriteSheetLoaderUpload on the calling thread. Asking twice for the
+/// same file and area while it is pending gives the same request.
+///
+/// @param _filename Path of the image file
+///
+/// @param _area Area of the image to load, NULL for the whole image
+///
+/// @return Request object, to release with SpriteSheetRequestRelease,
+///		 or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+SpriteSheetRequest* SpriteSheetLoaderRequest(
+	const char* _filename,
+	const sfIntRect* _area);
+
+//////////////////////////////////////////////////////////////
+/// @brief Ask for an area of a file to be decoded in the background,
+/// without creating a texture
+///
+/// For the callers updating their own textures. The request is ready
+/// once SpriteSheetLoaderUpload has seen it decoded, its image is kept
+/// until it is released.
+///
+/// @param _filename Path of the image file
+///
+/// @param _area Area of the image to load, NULL for the whole image
+///
+/// @return Request object, to release with SpriteSheetRequestRelease,
+///		 or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+SpriteSheetRequest* SpriteSheetLoaderRequestImage(
+	const char* _filename,
+	const sfIntRect* _area);
+
+//////////////////////////////////////////////////////////////
+/// @brief Create the textures of the images decoded so far
+///
+/// Must be called from the thread owning the OpenGL context, at a point
+/// where no texture is being drawn. Animation updates call it while one
+/// of their sprite sheets is pending.
+//////////////////////////////////////////////////////////////
+void SpriteSheetLoaderUpload(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Wait for every request to be decoded, then upload them
+//////////////////////////////////////////////////////////////
+void SpriteSheetLoaderFlush(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of requests not uploaded yet
+///
+/// @return Number of pending requests
+//////////////////////////////////////////////////////////////
+unsigned int SpriteSheetLoaderGetPendingNb(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Add a reference to a request
+///
+/// @param _request Request object
+///
+/// @return The request
+//////////////////////////////////////////////////////////////
+SpriteSheetRequest* SpriteSheetRequestRetain(SpriteSheetRequest* _request);
+
+//////////////////////////////////////////////////////////////
+/// @brief Remove a reference to a request, freeing it with the last one
+///
+/// @param _request Request object, can be NULL
+//////////////////////////////////////////////////////////////
+void SpriteSheetRequestRelease(SpriteSheetRequest* _request);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the progress of a request
+///
+/// @param _request Request object
+///
+/// @return State of the request
+//////////////////////////////////////////////////////////////
+SpriteSheetRequestState SpriteSheetRequestGetState(const SpriteSheetRequest* _request);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the texture of a ready request
+///
+/// The texture is in the texture cache, retain it to keep it after
+/// the request is released.
+///
+/// @param _request Request object
+///
+/// @return Texture, or NULL if the request is not ready
+//////////////////////////////////////////////////////////////
+sfTexture* SpriteSheetRequestGetTexture(const SpriteSheetRequest* _request);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the image of a ready request made with
+/// SpriteSheetLoaderRequestImage
+///
+/// @param _request Request object
+///
+/// @return Image cropped to the area, or NULL if the request is not
+///		 ready or has a texture
+//////////////////////////////////////////////////////////////
+const sfImage* SpriteSheetRequestGetImage(const SpriteSheetRequest* _request);
@@ -0,0 +1,206 @@
+#include "../Animation.h"
+#include "../AnimationBatch.h"
+#include "../AnimationInternal.h"
+#include "../AnimationSystem.h"
+#include "../FrameTable.h"
+
+#include <SFML/Graphics.h>
+#include <math.h>
+#include <stdio.h>
+
+// Checks the quads of AnimationBatchBuild against known frames, flips,
+// transforms and colors, without loading a texture nor opening a window.
+// Returns 0 when every vertex matches.
+
+/// Size of a frame of the test sprite sheet
+#define BATCH_TEST_FRAME_WIDTH 32
+#define BATCH_TEST_FRAME_HEIGHT 16
+/// Frames of the test clips, side by side from the corner of the sheet
+#define BATCH_TEST_FRAMES_NB 4
+/// Largest distance accepted between a vertex and the expected one
+#define BATCH_TEST_EPSILON 0.001
+
+/// @brief Animation of the test and the quad it must give
+typedef struct BatchTestCase
+{
+	const char* name;
+	unsigned char frame;
+	unsigned char state;
+	sfVector2f position;
+	float rotation;
+	sfVector2f scale;
+	sfColor color;
+} BatchTestCase;
+
+static const BatchTestCase batchTestCases[] = {
+	{ "plain", 2, 0, { 100.f, 50.f }, 0.f, { 1.f, 1.f }, { 255, 255, 255, 255 } },
+	{ "flip x", 1, FLIP_X, { 10.f, 20.f }, 0.f, { 1.f, 1.f }, { 255, 0, 0, 255 } },
+	{ "flip y", 3, FLIP_Y, { -40.f, 5.f }, 0.f, { 2.f, 1.f }, { 0, 255, 0, 128 } },
+	{ "flip both", 0, FLIP_X | FLIP_Y, { 0.f, 0.f }, 0.f, { 1.f, 3.f }, { 0, 0, 255, 255 } },
+	{ "rotated", 2, 0, { 300.f, 200.f }, 90.f, { 2.f, 2.f }, { 10, 20, 30, 40 } },
+	{ "rotated flipped", 1, FLIP_X, { -8.f, 64.f }, 33.f, { 0.5f, 1.5f }, { 255, 255, 255, 255 } },
+};
+#define BATCH_TEST_CASES_NB (sizeof(batchTestCases) / sizeof(batchTestCases[0]))
+
+// Vertex expected for a corner of the frame, transformed like an sfSprite
+// with its origin in the middle of the frame
+static sfVertex BatchTestExpectVertex(const BatchTestCase* _case, sfVector2f _corner)
+{
+	double scaleX = _case->state & FLIP_X ? -_case->scale.x : _case->scale.x;
+	double scaleY = _case->state & FLIP_Y ? -_case->scale.y : _case->scale.y;
+	double x = (_corner.x - BATCH_TEST_FRAME_WIDTH / 2.0) * scaleX;
+	double y = (_corner.y - BATCH_TEST_FRAME_HEIGHT / 2.0) * scaleY;
+	double angle = _case->rotation * 3.14159265358979 / 180.0;
+
+	sfVertex vertex;
+	vertex.position.x = (float)(x * cos(angle) - y * sin(angle) + _case->position.x);
+	vertex.position.y = (float)(x * sin(angle) + y * cos(angle) + _case->position.y);
+	vertex.texCoords.x = (float)(_case->frame * BATCH_TEST_FRAME_WIDTH) + _corner.x;
+	vertex.texCoords.y = _corner.y;
+	vertex.color = _case->color;
+	return vertex;
+}
+
+static int BatchTestSameVertex(const sfVertex* _vertex, const sfVertex* _expected)
+{
+	return fabs(_vertex->position.x - _expected->position.x) < BATCH_TEST_EPSILON
+		&& fabs(_vertex->position.y - _expected->position.y) < BATCH_TEST_EPSILON
+		&& _vertex->texCoords.x == _expected->texCoords.x
+		&& _vertex->texCoords.y == _expected->texCoords.y
+		&& _vertex->color.r == _expected->color.r
+		&& _vertex->color.g == _expected->color.g
+		&& _vertex->color.b == _expected->color.b
+		&& _vertex->color.a == _expected->color.a;
+}
+
+// Give a slot the frames of the test sprite sheet, read from a texture
+// the batch only compares
+static sfBool BatchTestSetFrames(
+	AnimationSystem* _system,
+	Animation* _anim,
+	sfTexture* _spriteSheet)
+{
+	FrameTable* table = FrameTableCreate(
+		AnimationLayoutFromString("horizontal"),
+		(sfVector2i) { 0, 0 },
+		(sfVector2u) { BATCH_TEST_FRAME_WIDTH, BATCH_TEST_FRAME_HEIGHT },
+		BATCH_TEST_FRAMES_NB,
+		(sfVector2u) { 0, 0 });
+	if (table == NULL)
+	{
+		return sfFalse;
+	}
+	unsigned int i = _anim->index;
+	FrameTableRelease(_system->frameTable[i]);
+	_system->frameTable[i] = table;
+	_system->spriteSheet[i] = _spriteSheet;
+	return sfTrue;
+}
+
+// Compare the quads of a batch with the test cases, return the number of
+// wrong quads
+static unsigned int BatchTestCheckQuads(const AnimationBatch* _batch, unsigned int _quadsNb)
+{
+	static const sfVector2f corners[4] = {
+		{ 0.f, 0.f },
+		{ BATCH_TEST_FRAME_WIDTH, 0.f },
+		{ BATCH_TEST_FRAME_WIDTH, BATCH_TEST_FRAME_HEIGHT },
+		{ 0.f, BATCH_TEST_FRAME_HEIGHT }
+	};
+	sfVertexArray* vertices = (sfVertexArray*)AnimationBatchGetVertexArray(_batch);
+	unsigned int wrongNb = 0;
+	for (unsigned int q = 0; q < _quadsNb && q < BATCH_TEST_CASES_NB; q++)
+	{
+		for (unsigned int c = 0; c < 4; c++)
+		{
+			sfVertex expected = BatchTestExpectVertex(&batchTestCases[q], corners[c]);
+			const sfVertex* vertex = sfVertexArray_getVertex(vertices, (size_t)q * 4 + c);
+			if (!BatchTestSameVertex(vertex, &expected))
+			{
+				printf("%s: corner %u at (%g, %g) uv (%g, %g), expected (%g, %g) uv (%g, %g)\n",
+					batchTestCases[q].name, c,
+					vertex->position.x, vertex->position.y,
+					vertex->texCoords.x, vertex->texCoords.y,
+					expected.position.x, expected.position.y,
+					expected.texCoords.x, expected.texCoords.y);
+				wrongNb++;
+				break;
+			}
+		}
+	}
+	return wrongNb;
+}
+
+int main(void)
+{
+	AnimationSystem* system = AnimationSystemCreate(BATCH_TEST_CASES_NB + 1);
+	if (system == NULL)
+	{
+		printf("Error during cration of the test system !\n");
+		return 1;
+	}
+	// Never read, the batch only tells the sprite sheets apart
+	static char spriteSheetTag;
+	static char otherSheetTag;
+	sfTexture* spriteSheet = (sfTexture*)&spriteSheetTag;
+	sfTexture* otherSheet = (sfTexture*)&otherSheetTag;
+
+	int failed = 0;
+	Animation* anims[BATCH_TEST_CASES_NB + 1];
+	for (unsigned int n = 0; n < BATCH_TEST_CASES_NB + 1; n++)
+	{
+		anims[n] = AnimationSystemCreateAnimation(
+			system,
+			(sfVector2u) { BATCH_TEST_FRAME_WIDTH, BATCH_TEST_FRAME_HEIGHT },
+			BATCH_TEST_FRAMES_NB);
+		if (anims[n] == NULL
+			|| !BatchTestSetFrames(system, anims[n], n < BATCH_TEST_CASES_NB ? spriteSheet : otherSheet))
+		{
+			printf("Error during cration of the test animations !\n");
+			failed = 1;
+			break;
+		}
+	}
+
+	AnimationBatch* batch = failed ? NULL : AnimationBatchCreate();
+	if (batch != NULL)
+	{
+		for (unsigned int n = 0; n < BATCH_TEST_CASES_NB; n++)
+		{
+			const BatchTestCase* testCase = &batchTestCases[n];
+			AnimationSetState(anims[n], testCase->state);
+			AnimationSetFrame(anims[n], testCase->frame);
+			AnimationSetPosition(anims[n], testCase->position);
+			AnimationSetRotation(anims[n], testCase->rotation);
+			AnimationSetScale(anims[n], testCase->scale);
+			AnimationSetColor(anims[n], testCase->color);
+		}
+
+		// The animation of the other sprite sheet is left out
+		unsigned int quadsNb = AnimationBatchBuild(batch, system, spriteSheet);
+		unsigned int wrongNb = BatchTestCheckQuads(batch, quadsNb);
+		printf("%u quads of %u, %u wrong\n", quadsNb, (unsigned int)BATCH_TEST_CASES_NB, wrongNb);
+		failed = quadsNb != BATCH_TEST_CASES_NB || wrongNb > 0
+			|| sfVertexArray_getVertexCount(AnimationBatchGetVertexArray(batch)) != (size_t)quadsNb * 4;
+
+		// Culled animations are left out too
+		AnimationSystemSetCulling(system, 64.f);
+		unsigned int seenNb = AnimationSystemCull(system, (sfFloatRect) { 50.f, 0.f, 100.f, 100.f });
+		quadsNb = AnimationBatchBuild(batch, system, spriteSheet);
+		printf("%u quads once culled, %u expected\n", quadsNb, seenNb);
+		failed |= quadsNb != 1 || seenNb != 1;
+		AnimationBatchDestroy(batch);
+	}
+	else
+	{
+		failed = 1;
+	}
+
+	// The sprite sheets are not textures, the system must not release them
+	for (unsigned int i = 0; i < system->count; i++)
+	{
+		system->spriteSheet[i] = NULL;
+	}
+	AnimationSystemDestroy(system);
+	return failed;
+}
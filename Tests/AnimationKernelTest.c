@@ -0,0 +1,201 @@
+#include "../Animation.h"
+#include "../AnimationInternal.h"
+#include "../AnimationKernel.h"
+#include "../AnimationSystem.h"
+#include "../FrameTable.h"
+
+#include <SFML/Graphics.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Checks that every kernel level supported by the CPU gives, bit for bit,
+// the clocks, frames, playing flags and dirty flags of the scalar update
+// AnimationSystemAdvance, over random LOOPED, REVERSED and stopped
+// animations. Returns 0 when they match.
+
+/// Animations of the system, not a multiple of the vector width
+#define KERNEL_TEST_ANIMATIONS_NB 1003
+/// Updates compared per level
+#define KERNEL_TEST_UPDATES_NB 500
+
+/// @brief Arrays written by an advance
+typedef struct KernelTestState
+{
+	float clock[KERNEL_TEST_ANIMATIONS_NB];
+	unsigned char currentFrame[KERNEL_TEST_ANIMATIONS_NB];
+	unsigned char isPlaying[KERNEL_TEST_ANIMATIONS_NB];
+	unsigned char frameDirty[KERNEL_TEST_ANIMATIONS_NB];
+} KernelTestState;
+
+static unsigned int kernelTestSeed = 12345;
+
+// Same numbers on every platform, unlike rand
+static unsigned int KernelTestRandom(void)
+{
+	kernelTestSeed ^= kernelTestSeed << 13;
+	kernelTestSeed ^= kernelTestSeed >> 17;
+	kernelTestSeed ^= kernelTestSeed << 5;
+	return kernelTestSeed;
+}
+
+static float KernelTestRandomFloat(float _max)
+{
+	return (float)(KernelTestRandom() % 100000) / 100000.f * _max;
+}
+
+static void KernelTestSave(const AnimationSystem* _system, KernelTestState* _state)
+{
+	unsigned int count = _system->count;
+	memcpy(_state->clock, _system->clock, count * sizeof(float));
+	memcpy(_state->currentFrame, _system->currentFrame, count);
+	memcpy(_state->isPlaying, _system->isPlaying, count);
+	memcpy(_state->frameDirty, _system->frameDirty, count);
+}
+
+static void KernelTestLoad(AnimationSystem* _system, const KernelTestState* _state)
+{
+	unsigned int count = _system->count;
+	memcpy(_system->clock, _state->clock, count * sizeof(float));
+	memcpy(_system->currentFrame, _state->currentFrame, count);
+	memcpy(_system->isPlaying, _state->isPlaying, count);
+	memcpy(_system->frameDirty, _state->frameDirty, count);
+}
+
+// Fill a system with random animations
+static AnimationSystem* KernelTestCreateSystem(void)
+{
+	AnimationSystem* system = AnimationSystemCreate(KERNEL_TEST_ANIMATIONS_NB);
+	if (system == NULL)
+	{
+		return NULL;
+	}
+	static const unsigned char states[] = {
+		0, LOOPED, REVERSED, LOOPED | REVERSED, LOOPED | FLIP_X, REVERSED | FLIP_Y };
+	for (unsigned int i = 0; i < KERNEL_TEST_ANIMATIONS_NB; i++)
+	{
+		unsigned char framesNb = (unsigned char)(1 + KernelTestRandom() % 24);
+		Animation* anim = AnimationSystemCreateAnimation(
+			system, (sfVector2u) { 32, 32 }, framesNb);
+		if (anim == NULL)
+		{
+			AnimationSystemDestroy(system);
+			return NULL;
+		}
+
+		// Some clips have per-frame durations, their groups take the
+		// scalar path of the kernel
+		if (KernelTestRandom() % 16 == 0)
+		{
+			FrameTable* table = FrameTableCreate(
+				AnimationLayoutFromString("horizontal"),
+				(sfVector2i) { 0, 0 },
+				(sfVector2u) { 32, 32 },
+				framesNb,
+				(sfVector2u) { 0, 0 });
+			float durations[256];
+			for (unsigned int f = 0; f < framesNb; f++)
+			{
+				durations[f] = 0.01f + KernelTestRandomFloat(0.2f);
+			}
+			if (table != NULL)
+			{
+				system->duration[i] = FrameTableSetDurations(table, durations);
+				FrameTableRelease(system->frameTable[i]);
+				system->frameTable[i] = table;
+				system->variableTimes[i] = sfTrue;
+			}
+		}
+		else
+		{
+			AnimationSetDuration(anim, 0.05f + KernelTestRandomFloat(2.f));
+		}
+
+		AnimationPlay(anim, states[KernelTestRandom() % (sizeof(states) / sizeof(states[0]))]);
+		AnimationSetClock(anim, KernelTestRandomFloat(system->duration[i]));
+		system->currentFrame[i] = (unsigned char)(KernelTestRandom() % framesNb);
+		if (KernelTestRandom() % 8 == 0)
+		{
+			AnimationPause(anim);
+		}
+		system->frameDirty[i] = (unsigned char)(KernelTestRandom() % 2);
+	}
+	return system;
+}
+
+// Compare a level with the scalar update, return the number of mismatches
+static unsigned int KernelTestLevel(
+	AnimationSystem* _system,
+	AnimationKernelLevel _level,
+	const KernelTestState* _start,
+	const float* _dts)
+{
+	static KernelTestState expected;
+	static KernelTestState result;
+	unsigned int count = _system->count;
+	unsigned int mismatchesNb = 0;
+
+	AnimationKernelSetLevel(_level);
+	for (unsigned int update = 0; update < KERNEL_TEST_UPDATES_NB; update++)
+	{
+		// Ranges starting and ending out of the vector width
+		unsigned int begin = update % 3;
+		unsigned int end = count - update % 5;
+
+		KernelTestLoad(_system, update == 0 ? _start : &result);
+		AnimationSystemAdvance(_system, begin, end, _dts[update]);
+		KernelTestSave(_system, &expected);
+
+		KernelTestLoad(_system, update == 0 ? _start : &result);
+		AnimationKernelAdvance(_system, begin, end, _dts[update]);
+		KernelTestSave(_system, &result);
+
+		if (memcmp(expected.clock, result.clock, count * sizeof(float)) != 0
+			|| memcmp(expected.currentFrame, result.currentFrame, count) != 0
+			|| memcmp(expected.isPlaying, result.isPlaying, count) != 0
+			|| memcmp(expected.frameDirty, result.frameDirty, count) != 0)
+		{
+			mismatchesNb++;
+			// Go on from the expected state
+			result = expected;
+		}
+	}
+	return mismatchesNb;
+}
+
+int main(void)
+{
+	static const char* levelNames[] = { "scalar", "sse2", "avx2" };
+	AnimationSystem* system = KernelTestCreateSystem();
+	if (system == NULL)
+	{
+		printf("Error during cration of the test system !\n");
+		return 1;
+	}
+	static KernelTestState start;
+	KernelTestSave(system, &start);
+
+	// Small steps, steps over several frames and clips, and no step
+	float dts[KERNEL_TEST_UPDATES_NB];
+	for (unsigned int i = 0; i < KERNEL_TEST_UPDATES_NB; i++)
+	{
+		unsigned int kind = KernelTestRandom() % 8;
+		dts[i] = kind == 0 ? 0.f
+			: kind == 1 ? KernelTestRandomFloat(5.f)
+			: KernelTestRandomFloat(0.05f);
+	}
+
+	int failed = 0;
+	AnimationKernelLevel supported = AnimationKernelGetSupportedLevel();
+	for (int level = ANIMATION_KERNEL_SCALAR; level <= (int)supported; level++)
+	{
+		unsigned int mismatchesNb = KernelTestLevel(
+			system, (AnimationKernelLevel)level, &start, dts);
+		printf("%s: %u of %u updates differ\n",
+			levelNames[level], mismatchesNb, KERNEL_TEST_UPDATES_NB);
+		failed |= mismatchesNb > 0;
+	}
+	AnimationKernelSetLevel(supported);
+	AnimationSystemDestroy(system);
+	return failed;
+}
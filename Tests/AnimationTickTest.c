@@ -0,0 +1,203 @@
+#include "../Animation.h"
+#include "../AnimationInternal.h"
+#include "../AnimationSystem.h"
+#include "../FrameTable.h"
+
+#include <SFML/Graphics.h>
+#include <stdio.h>
+#include <string.h>
+
+// Checks that systems in tick mode give, bit for bit, the same clocks,
+// frames and playing flags whatever the steps the ticks come in: one
+// tick per update, random numbers of ticks per update, and float delta
+// times carrying fractions of ticks from one update to the next.
+// Returns 0 when they match at every checkpoint.
+
+/// Animations of each system
+#define TICK_TEST_ANIMATIONS_NB 500
+/// Ticks per second, a power of two so that the delta times are exact
+#define TICK_TEST_RATE 1024
+/// Checkpoints where the systems are compared
+#define TICK_TEST_CHECKPOINTS_NB 200
+
+/// @brief Animation created the same way in each system
+typedef struct TickTestClip
+{
+	unsigned char framesNb;
+	unsigned char state;
+	float duration;
+	float clock;
+	/// Frame durations, when the first one is not 0
+	float durations[16];
+} TickTestClip;
+
+/// @brief State read back from a system
+typedef struct TickTestState
+{
+	float clock[TICK_TEST_ANIMATIONS_NB];
+	unsigned char currentFrame[TICK_TEST_ANIMATIONS_NB];
+	unsigned char isPlaying[TICK_TEST_ANIMATIONS_NB];
+} TickTestState;
+
+static unsigned int tickTestSeed = 2024;
+
+// Same numbers on every platform, unlike rand
+static unsigned int TickTestRandom(void)
+{
+	tickTestSeed ^= tickTestSeed << 13;
+	tickTestSeed ^= tickTestSeed >> 17;
+	tickTestSeed ^= tickTestSeed << 5;
+	return tickTestSeed;
+}
+
+static float TickTestRandomFloat(float _max)
+{
+	return (float)(TickTestRandom() % 100000) / 100000.f * _max;
+}
+
+static void TickTestCreateClips(TickTestClip* _clips)
+{
+	static const unsigned char states[] = { 0, LOOPED, REVERSED, LOOPED | REVERSED };
+	for (unsigned int i = 0; i < TICK_TEST_ANIMATIONS_NB; i++)
+	{
+		TickTestClip* clip = &_clips[i];
+		memset(clip, 0, sizeof(*clip));
+		clip->framesNb = (unsigned char)(1 + TickTestRandom() % 16);
+		clip->state = states[TickTestRandom() % (sizeof(states) / sizeof(states[0]))];
+		clip->duration = 0.05f + TickTestRandomFloat(3.f);
+		if (TickTestRandom() % 8 == 0)
+		{
+			for (unsigned int f = 0; f < clip->framesNb; f++)
+			{
+				clip->durations[f] = 0.01f + TickTestRandomFloat(0.3f);
+			}
+		}
+		clip->clock = TickTestRandomFloat(clip->duration);
+	}
+}
+
+// Fill a system in tick mode with the clips
+static AnimationSystem* TickTestCreateSystem(const TickTestClip* _clips)
+{
+	AnimationSystem* system = AnimationSystemCreate(TICK_TEST_ANIMATIONS_NB);
+	if (system == NULL || !AnimationSystemSetTickRate(system, TICK_TEST_RATE))
+	{
+		AnimationSystemDestroy(system);
+		return NULL;
+	}
+	for (unsigned int i = 0; i < TICK_TEST_ANIMATIONS_NB; i++)
+	{
+		const TickTestClip* clip = &_clips[i];
+		Animation* anim = AnimationSystemCreateAnimation(
+			system, (sfVector2u) { 32, 32 }, clip->framesNb);
+		if (anim == NULL)
+		{
+			AnimationSystemDestroy(system);
+			return NULL;
+		}
+		AnimationSetDuration(anim, clip->duration);
+		if (clip->durations[0] > 0)
+		{
+			// Frame durations need the frames of a sprite sheet
+			FrameTable* table = FrameTableCreate(
+				AnimationLayoutFromString("horizontal"),
+				(sfVector2i) { 0, 0 },
+				(sfVector2u) { 32, 32 },
+				clip->framesNb,
+				(sfVector2u) { 0, 0 });
+			if (table != NULL)
+			{
+				FrameTableRelease(system->frameTable[anim->index]);
+				system->frameTable[anim->index] = table;
+				AnimationSetFrameDurations(anim, clip->durations);
+			}
+		}
+		AnimationPlay(anim, clip->state);
+		AnimationSetClock(anim, clip->clock);
+	}
+	return system;
+}
+
+static void TickTestSave(const AnimationSystem* _system, TickTestState* _state)
+{
+	for (unsigned int i = 0; i < TICK_TEST_ANIMATIONS_NB; i++)
+	{
+		Animation* anim = AnimationSystemGetAnimation(_system, i);
+		_state->clock[i] = AnimationGetClock(anim);
+		_state->currentFrame[i] = AnimationGetCurrentFrame(anim);
+		_state->isPlaying[i] = (unsigned char)AnimationIsPlaying(anim);
+	}
+}
+
+static int TickTestSameState(const TickTestState* _a, const TickTestState* _b)
+{
+	return memcmp(_a->clock, _b->clock, sizeof(_a->clock)) == 0
+		&& memcmp(_a->currentFrame, _b->currentFrame, sizeof(_a->currentFrame)) == 0
+		&& memcmp(_a->isPlaying, _b->isPlaying, sizeof(_a->isPlaying)) == 0;
+}
+
+int main(void)
+{
+	static TickTestClip clips[TICK_TEST_ANIMATIONS_NB];
+	TickTestCreateClips(clips);
+	AnimationSystem* single = TickTestCreateSystem(clips);
+	AnimationSystem* split = TickTestCreateSystem(clips);
+	AnimationSystem* timed = TickTestCreateSystem(clips);
+	if (single == NULL || split == NULL || timed == NULL)
+	{
+		printf("Error during cration of the test systems !\n");
+		AnimationSystemDestroy(single);
+		AnimationSystemDestroy(split);
+		AnimationSystemDestroy(timed);
+		return 1;
+	}
+
+	static TickTestState singleState;
+	static TickTestState splitState;
+	static TickTestState timedState;
+	unsigned int splitMismatchesNb = 0;
+	unsigned int timedMismatchesNb = 0;
+	for (unsigned int checkpoint = 0; checkpoint < TICK_TEST_CHECKPOINTS_NB; checkpoint++)
+	{
+		unsigned int ticks = 1 + TickTestRandom() % 300;
+
+		// One tick per update
+		for (unsigned int t = 0; t < ticks; t++)
+		{
+			AnimationSystemUpdateTicks(single, 1);
+		}
+
+		// Random numbers of ticks per update, some of them empty
+		unsigned int left = ticks;
+		while (left > 0)
+		{
+			unsigned int step = TickTestRandom() % 40;
+			step = step < left ? step : left;
+			AnimationSystemUpdateTicks(split, step);
+			left -= step;
+		}
+
+		// Delta times in half ticks, the fractions carried between updates
+		unsigned int halfTicks = 2 * ticks;
+		while (halfTicks > 0)
+		{
+			unsigned int step = 1 + TickTestRandom() % 25;
+			step = step < halfTicks ? step : halfTicks;
+			AnimationSystemUpdate(timed, (float)step / (2.f * TICK_TEST_RATE));
+			halfTicks -= step;
+		}
+
+		TickTestSave(single, &singleState);
+		TickTestSave(split, &splitState);
+		TickTestSave(timed, &timedState);
+		splitMismatchesNb += !TickTestSameState(&singleState, &splitState);
+		timedMismatchesNb += !TickTestSameState(&singleState, &timedState);
+	}
+	printf("ticks split: %u of %u checkpoints differ\n", splitMismatchesNb, TICK_TEST_CHECKPOINTS_NB);
+	printf("delta times: %u of %u checkpoints differ\n", timedMismatchesNb, TICK_TEST_CHECKPOINTS_NB);
+
+	AnimationSystemDestroy(single);
+	AnimationSystemDestroy(split);
+	AnimationSystemDestroy(timed);
+	return splitMismatchesNb > 0 || timedMismatchesNb > 0;
+}
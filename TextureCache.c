@@ -0,0 +1,258 @@
+#include "TextureCache.h"
+#include "AnimationProfiler.h"
+#include "CollisionMask.h"
+#include "FrameTable.h"
+#include "SpriteSheetCache.h"
+
+#include <SFML/Graphics.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Texture shared by every user of the same file and area
+typedef struct TextureCacheEntry
+{
+	/// Hash of the key, 0 for adopted textures
+	unsigned int hash;
+	char* filename;
+	sfIntRect area;
+	sfTexture* texture;
+	/// Alpha mask of the texture, NULL until it is asked for
+	CollisionMask* mask;
+	/// Pixels that are not fully transparent, NULL until frames are trimmed
+	CollisionMask* visibleMask;
+	unsigned int refCount;
+} TextureCacheEntry;
+
+static TextureCacheEntry* entries = NULL;
+static unsigned int entriesNb = 0;
+static unsigned int entriesCapacity = 0;
+
+// FNV-1a hash of the file name and area
+static unsigned int TextureCacheHash(const char* _filename, sfIntRect _area)
+{
+	unsigned int hash = 2166136261u;
+	for (const char* c = _filename; *c != '\0'; c++)
+	{
+		hash = (hash ^ (unsigned char)*c) * 16777619u;
+	}
+	const unsigned char* bytes = (const unsigned char*)&_area;
+	for (size_t i = 0; i < sizeof(_area); i++)
+	{
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+	// 0 is kept for adopted textures
+	return hash != 0 ? hash : 1;
+}
+
+static TextureCacheEntry* TextureCacheFind(const sfTexture* _texture)
+{
+	for (unsigned int i = 0; i < entriesNb; i++)
+	{
+		if (entries[i].texture == _texture)
+		{
+			return &entries[i];
+		}
+	}
+	return NULL;
+}
+
+static TextureCacheEntry* TextureCacheAdd(
+	sfTexture* _texture,
+	unsigned int _hash,
+	const char* _filename,
+	sfIntRect _area)
+{
+	if (entriesNb == entriesCapacity)
+	{
+		unsigned int capacity = entriesCapacity > 0 ? entriesCapacity * 2 : 16;
+		TextureCacheEntry* grown = (TextureCacheEntry*)realloc(
+			entries, sizeof(TextureCacheEntry) * capacity);
+		if (grown == NULL)
+		{
+			printf("Error during memory allocation !");
+			return NULL;
+		}
+		entries = grown;
+		entriesCapacity = capacity;
+	}
+
+	TextureCacheEntry* entry = &entries[entriesNb];
+	entry->filename = NULL;
+	if (_filename != NULL)
+	{
+		entry->filename = (char*)malloc(strlen(_filename) + 1);
+		if (entry->filename == NULL)
+		{
+			printf("Error during memory allocation !");
+			return NULL;
+		}
+		strcpy(entry->filename, _filename);
+	}
+	entry->hash = _hash;
+	entry->area = _area;
+	entry->texture = _texture;
+	entry->mask = NULL;
+	entry->visibleMask = NULL;
+	entry->refCount = 1;
+	entriesNb++;
+	return entry;
+}
+
+sfTexture* TextureCacheLookup(const char* _filename, const sfIntRect* _area)
+{
+	sfIntRect area = _area != NULL ? *_area : (sfIntRect){ 0, 0, 0, 0 };
+	unsigned int hash = TextureCacheHash(_filename, area);
+
+	for (unsigned int i = 0; i < entriesNb; i++)
+	{
+		TextureCacheEntry* entry = &entries[i];
+		if (entry->hash == hash
+			&& memcmp(&entry->area, &area, sizeof(area)) == 0
+			&& strcmp(entry->filename, _filename) == 0)
+		{
+			entry->refCount++;
+			return entry->texture;
+		}
+	}
+	return NULL;
+}
+
+sfTexture* TextureCacheAcquire(const char* _filename, const sfIntRect* _area)
+{
+	sfTexture* texture = TextureCacheLookup(_filename, _area);
+	if (texture != NULL)
+	{
+		return texture;
+	}
+
+	sfIntRect area = _area != NULL ? *_area : (sfIntRect){ 0, 0, 0, 0 };
+	ANIMATION_PROFILE_BEGIN(ANIMATION_PROFILER_LOAD);
+	texture = SpriteSheetCacheLoadTexture(_filename, &area);
+	ANIMATION_PROFILE_END(ANIMATION_PROFILER_LOAD);
+	if (texture == NULL)
+	{
+		return NULL;
+	}
+	ANIMATION_PROFILE_COUNT(ANIMATION_PROFILER_TEXTURE_LOADS, 1);
+	if (TextureCacheAdd(texture, TextureCacheHash(_filename, area), _filename, area) == NULL)
+	{
+		sfTexture_destroy(texture);
+		return NULL;
+	}
+	return texture;
+}
+
+sfTexture* TextureCacheInsert(
+	const char* _filename,
+	const sfIntRect* _area,
+	sfTexture* _texture)
+{
+	sfIntRect area = _area != NULL ? *_area : (sfIntRect){ 0, 0, 0, 0 };
+	if (TextureCacheAdd(_texture, TextureCacheHash(_filename, area), _filename, area) == NULL)
+	{
+		return NULL;
+	}
+	return _texture;
+}
+
+sfTexture* TextureCacheAdopt(sfTexture* _texture)
+{
+	if (TextureCacheAdd(_texture, 0, NULL, (sfIntRect) { 0, 0, 0, 0 }) == NULL)
+	{
+		return NULL;
+	}
+	return _texture;
+}
+
+sfTexture* TextureCacheRetain(sfTexture* _texture)
+{
+	TextureCacheEntry* entry = TextureCacheFind(_texture);
+	if (entry == NULL)
+	{
+		printf("Error : texture is not in the texture cache !");
+		return _texture;
+	}
+	entry->refCount++;
+	return _texture;
+}
+
+void TextureCacheRelease(sfTexture* _texture)
+{
+	if (_texture == NULL)
+	{
+		return;
+	}
+	TextureCacheEntry* entry = TextureCacheFind(_texture);
+	if (entry == NULL)
+	{
+		printf("Error : texture is not in the texture cache !");
+		return;
+	}
+	if (--entry->refCount > 0)
+	{
+		return;
+	}
+
+	// A new texture could take its address, its trimmed frames must not
+	FrameTableForgetTexture(entry->texture);
+	sfTexture_destroy(entry->texture);
+	CollisionMaskDestroy(entry->mask);
+	CollisionMaskDestroy(entry->visibleMask);
+	free(entry->filename);
+	*entry = entries[--entriesNb];
+	if (entriesNb == 0)
+	{
+		free(entries);
+		entries = NULL;
+		entriesCapacity = 0;
+	}
+}
+
+const CollisionMask* TextureCacheBuildCollisionMask(sfTexture* _texture)
+{
+	TextureCacheEntry* entry = TextureCacheFind(_texture);
+	if (entry == NULL)
+	{
+		printf("Error : texture is not in the texture cache !");
+		return NULL;
+	}
+	if (entry->mask == NULL)
+	{
+		entry->mask = CollisionMaskCreateFromTexture(
+			entry->texture, COLLISION_MASK_ALPHA_THRESHOLD);
+	}
+	return entry->mask;
+}
+
+const CollisionMask* TextureCacheBuildVisibleMask(sfTexture* _texture)
+{
+	TextureCacheEntry* entry = TextureCacheFind(_texture);
+	if (entry == NULL)
+	{
+		printf("Error : texture is not in the texture cache !");
+		return NULL;
+	}
+	if (entry->visibleMask == NULL)
+	{
+		entry->visibleMask = CollisionMaskCreateFromTexture(entry->texture, 1);
+	}
+	return entry->visibleMask;
+}
+
+const CollisionMask* TextureCacheGetCollisionMask(const sfTexture* _texture)
+{
+	TextureCacheEntry* entry = TextureCacheFind(_texture);
+	return entry != NULL ? entry->mask : NULL;
+}
+
+unsigned int TextureCacheGetRefCount(const sfTexture* _texture)
+{
+	TextureCacheEntry* entry = TextureCacheFind(_texture);
+	return entry != NULL ? entry->refCount : 0;
+}
+
+unsigned int TextureCacheGetCount(void)
+{
+	return entriesNb;
+}
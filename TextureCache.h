@@ -0,0 +1,131 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Graphics.h>
+#include "CollisionMask.h"
+
+//////////////////////////////////////////////////////////////
+/// @brief Get a shared texture loaded from a file
+///
+/// Textures are keyed by file name and area: the first call loads the
+/// texture, the next ones return the same texture with one more reference.
+/// Each call must be balanced with TextureCacheRelease.
+///
+/// @param _filename Path of the image file to load
+///
+/// @param _area Area of the image to load, NULL to load the entire image
+///
+/// @return Shared texture, or NULL if it cannot be load
+//////////////////////////////////////////////////////////////
+sfTexture* TextureCacheAcquire(const char* _filename, const sfIntRect* _area);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get a shared texture only if it is already loaded
+///
+/// @param _filename Path of the image file
+///
+/// @param _area Area of the image, NULL for the entire image
+///
+/// @return Shared texture with one more reference, or NULL if the file
+///		 and area are not in the cache
+//////////////////////////////////////////////////////////////
+sfTexture* TextureCacheLookup(const char* _filename, const sfIntRect* _area);
+
+//////////////////////////////////////////////////////////////
+/// @brief Give the ownership of a texture loaded elsewhere to the cache,
+/// under the key of a file and area
+///
+/// The key must not be in the cache yet.
+///
+/// @param _filename Path of the image file the texture comes from
+///
+/// @param _area Area of the image, NULL for the entire image
+///
+/// @param _texture Texture object
+///
+/// @return The texture with a single reference, NULL if it cannot be added
+//////////////////////////////////////////////////////////////
+sfTexture* TextureCacheInsert(
+	const char* _filename,
+	const sfIntRect* _area,
+	sfTexture* _texture);
+
+//////////////////////////////////////////////////////////////
+/// @brief Give the ownership of a texture to the cache
+///
+/// The texture has no key, it can only be shared with TextureCacheRetain.
+///
+/// @param _texture Texture object
+///
+/// @return The texture with a single reference, NULL if it cannot be added
+//////////////////////////////////////////////////////////////
+sfTexture* TextureCacheAdopt(sfTexture* _texture);
+
+//////////////////////////////////////////////////////////////
+/// @brief Add a reference to a texture of the cache
+///
+/// @param _texture Texture returned by the cache
+///
+/// @return The same texture
+//////////////////////////////////////////////////////////////
+sfTexture* TextureCacheRetain(sfTexture* _texture);
+
+//////////////////////////////////////////////////////////////
+/// @brief Remove a reference to a texture of the cache
+///
+/// The texture is destroyed with its last reference.
+///
+/// @param _texture Texture returned by the cache, NULL is ignored
+//////////////////////////////////////////////////////////////
+void TextureCacheRelease(sfTexture* _texture);
+
+//////////////////////////////////////////////////////////////
+/// @brief Build the collision mask of a texture of the cache
+///
+/// The mask is built once and shared by every user of the texture,
+/// it is destroyed with the texture.
+///
+/// @param _texture Texture returned by the cache
+///
+/// @return Collision mask of the texture, NULL if it cannot be built
+//////////////////////////////////////////////////////////////
+const CollisionMask* TextureCacheBuildCollisionMask(sfTexture* _texture);
+
+//////////////////////////////////////////////////////////////
+/// @brief Build the mask of the pixels of a texture of the cache that
+/// are not fully transparent, to trim its frames
+///
+/// The mask is built once and destroyed with the texture.
+///
+/// @param _texture Texture returned by the cache
+///
+/// @return Mask of the visible pixels, NULL if it cannot be built
+//////////////////////////////////////////////////////////////
+const CollisionMask* TextureCacheBuildVisibleMask(sfTexture* _texture);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the collision mask of a texture of the cache
+///
+/// @param _texture Texture object
+///
+/// @return Collision mask of the texture, NULL if it is not built
+//////////////////////////////////////////////////////////////
+const CollisionMask* TextureCacheGetCollisionMask(const sfTexture* _texture);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of references to a texture of the cache
+///
+/// @param _texture Texture object
+///
+/// @return Number of references, 0 if the texture is not in the cache
+//////////////////////////////////////////////////////////////
+unsigned int TextureCacheGetRefCount(const sfTexture* _texture);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the number of textures alive in the cache
+///
+/// @return Number of textures
+//////////////////////////////////////////////////////////////
+unsigned int TextureCacheGetCount(void);
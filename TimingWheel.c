@@ -0,0 +1,275 @@
+#include "TimingWheel.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/// Bits of a tick handled by each level
+#define TIMING_WHEEL_BITS 6
+#define TIMING_WHEEL_SLOTS (1u << TIMING_WHEEL_BITS)
+#define TIMING_WHEEL_MASK (TIMING_WHEEL_SLOTS - 1)
+#define TIMING_WHEEL_LEVELS 4
+/// Bucket of the ids further than the last level, checked again each
+/// time the last level wraps
+#define TIMING_WHEEL_OVERFLOW (TIMING_WHEEL_LEVELS * TIMING_WHEEL_SLOTS)
+#define TIMING_WHEEL_BUCKETS (TIMING_WHEEL_OVERFLOW + 1)
+/// Bucket of an id that is not in the wheel
+#define TIMING_WHEEL_NO_BUCKET 0xFFFFFFFFu
+
+/// @brief Place of an id in the wheel, together to be read at once
+typedef struct TimingWheelNode
+{
+	unsigned long long tick;
+	unsigned int next;
+	unsigned int prev;
+	unsigned int bucket;
+} TimingWheelNode;
+
+struct TimingWheel
+{
+	unsigned long long tick;
+	unsigned int capacity;
+	/// Number of ids in the wheel
+	unsigned int count;
+	/// First id of each bucket, ids of a bucket are a doubly linked list
+	unsigned int heads[TIMING_WHEEL_BUCKETS];
+
+	TimingWheelNode* nodes;
+
+	/// Ids expired by the last advance, as large as the capacity
+	unsigned int* expired;
+};
+
+TimingWheel* TimingWheelCreate(void)
+{
+	TimingWheel* wheel = (TimingWheel*)calloc(1, sizeof(TimingWheel));
+	if (wheel == NULL)
+	{
+		printf("Error during memory allocation !");
+		return NULL;
+	}
+	for (unsigned int i = 0; i < TIMING_WHEEL_BUCKETS; i++)
+	{
+		wheel->heads[i] = TIMING_WHEEL_NONE;
+	}
+	return wheel;
+}
+
+void TimingWheelDestroy(TimingWheel* _wheel)
+{
+	if (_wheel == NULL)
+	{
+		return;
+	}
+	free(_wheel->nodes);
+	free(_wheel->expired);
+	free(_wheel);
+}
+
+static sfBool TimingWheelGrowArray(void** _array, size_t _elementSize, unsigned int _capacity)
+{
+	void* array = realloc(*_array, _elementSize * _capacity);
+	if (array == NULL)
+	{
+		printf("Error during memory allocation !");
+		return sfFalse;
+	}
+	*_array = array;
+	return sfTrue;
+}
+
+sfBool TimingWheelReserve(TimingWheel* _wheel, unsigned int _capacity)
+{
+	if (_capacity <= _wheel->capacity)
+	{
+		return sfTrue;
+	}
+	if (!TimingWheelGrowArray((void**)&_wheel->nodes, sizeof(TimingWheelNode), _capacity)
+		|| !TimingWheelGrowArray((void**)&_wheel->expired, sizeof(unsigned int), _capacity))
+	{
+		return sfFalse;
+	}
+	for (unsigned int i = _wheel->capacity; i < _capacity; i++)
+	{
+		_wheel->nodes[i].bucket = TIMING_WHEEL_NO_BUCKET;
+	}
+	_wheel->capacity = _capacity;
+	return sfTrue;
+}
+
+unsigned long long TimingWheelGetTick(const TimingWheel* _wheel)
+{
+	return _wheel->tick;
+}
+
+// Slot of a tick in a level
+static unsigned int TimingWheelGetDigit(unsigned long long _tick, unsigned int _level)
+{
+	return (unsigned int)(_tick >> (TIMING_WHEEL_BITS * _level)) & TIMING_WHEEL_MASK;
+}
+
+// Bucket of a tick not before the current one: the lowest level whose
+// upper digits are the ones of the current tick
+static unsigned int TimingWheelGetBucket(const TimingWheel* _wheel, unsigned long long _tick)
+{
+	for (unsigned int level = 0; level < TIMING_WHEEL_LEVELS; level++)
+	{
+		unsigned int shift = TIMING_WHEEL_BITS * (level + 1);
+		if ((_tick >> shift) == (_wheel->tick >> shift))
+		{
+			return level * TIMING_WHEEL_SLOTS + TimingWheelGetDigit(_tick, level);
+		}
+	}
+	return TIMING_WHEEL_OVERFLOW;
+}
+
+static void TimingWheelLink(TimingWheel* _wheel, unsigned int _id)
+{
+	unsigned int bucket = TimingWheelGetBucket(_wheel, _wheel->nodes[_id].tick);
+	unsigned int head = _wheel->heads[bucket];
+	_wheel->nodes[_id].next = head;
+	_wheel->nodes[_id].prev = TIMING_WHEEL_NONE;
+	if (head != TIMING_WHEEL_NONE)
+	{
+		_wheel->nodes[head].prev = _id;
+	}
+	_wheel->heads[bucket] = _id;
+	_wheel->nodes[_id].bucket = bucket;
+	_wheel->count++;
+}
+
+static void TimingWheelUnlink(TimingWheel* _wheel, unsigned int _id)
+{
+	unsigned int next = _wheel->nodes[_id].next;
+	unsigned int prev = _wheel->nodes[_id].prev;
+	if (prev != TIMING_WHEEL_NONE)
+	{
+		_wheel->nodes[prev].next = next;
+	}
+	else
+	{
+		_wheel->heads[_wheel->nodes[_id].bucket] = next;
+	}
+	if (next != TIMING_WHEEL_NONE)
+	{
+		_wheel->nodes[next].prev = prev;
+	}
+	_wheel->nodes[_id].bucket = TIMING_WHEEL_NO_BUCKET;
+	_wheel->count--;
+}
+
+void TimingWheelInsert(TimingWheel* _wheel, unsigned int _id, unsigned long long _tick)
+{
+	if (_wheel->nodes[_id].bucket != TIMING_WHEEL_NO_BUCKET)
+	{
+		TimingWheelUnlink(_wheel, _id);
+	}
+	_wheel->nodes[_id].tick = _tick > _wheel->tick ? _tick : _wheel->tick + 1;
+	TimingWheelLink(_wheel, _id);
+}
+
+void TimingWheelRemove(TimingWheel* _wheel, unsigned int _id)
+{
+	if (_wheel->nodes[_id].bucket != TIMING_WHEEL_NO_BUCKET)
+	{
+		TimingWheelUnlink(_wheel, _id);
+	}
+}
+
+void TimingWheelMove(TimingWheel* _wheel, unsigned int _from, unsigned int _to)
+{
+	unsigned int bucket = _wheel->nodes[_from].bucket;
+	if (bucket == TIMING_WHEEL_NO_BUCKET)
+	{
+		return;
+	}
+	unsigned int next = _wheel->nodes[_from].next;
+	unsigned int prev = _wheel->nodes[_from].prev;
+	_wheel->nodes[_to].next = next;
+	_wheel->nodes[_to].prev = prev;
+	_wheel->nodes[_to].tick = _wheel->nodes[_from].tick;
+	_wheel->nodes[_to].bucket = bucket;
+	if (prev != TIMING_WHEEL_NONE)
+	{
+		_wheel->nodes[prev].next = _to;
+	}
+	else
+	{
+		_wheel->heads[bucket] = _to;
+	}
+	if (next != TIMING_WHEEL_NONE)
+	{
+		_wheel->nodes[next].prev = _to;
+	}
+	_wheel->nodes[_from].bucket = TIMING_WHEEL_NO_BUCKET;
+}
+
+sfBool TimingWheelContains(const TimingWheel* _wheel, unsigned int _id)
+{
+	return _wheel->nodes[_id].bucket != TIMING_WHEEL_NO_BUCKET;
+}
+
+// Spread the ids of a bucket of an upper level on the lower levels
+static void TimingWheelCascade(TimingWheel* _wheel, unsigned int _bucket)
+{
+	unsigned int id = _wheel->heads[_bucket];
+	_wheel->heads[_bucket] = TIMING_WHEEL_NONE;
+	while (id != TIMING_WHEEL_NONE)
+	{
+		unsigned int next = _wheel->nodes[id].next;
+		_wheel->count--;
+		TimingWheelLink(_wheel, id);
+		id = next;
+	}
+}
+
+unsigned int TimingWheelAdvance(
+	TimingWheel* _wheel,
+	unsigned long long _tick,
+	const unsigned int** _expired)
+{
+	unsigned int expiredNb = 0;
+	while (_wheel->tick < _tick)
+	{
+		// Nothing can expire in an empty wheel
+		if (_wheel->count == 0)
+		{
+			_wheel->tick = _tick;
+			break;
+		}
+		unsigned long long tick = ++_wheel->tick;
+
+		// Entering a new block of a level brings its ids one level down,
+		// the upper levels first
+		if ((tick & TIMING_WHEEL_MASK) == 0)
+		{
+			unsigned int level = 1;
+			while (level < TIMING_WHEEL_LEVELS - 1
+				&& TimingWheelGetDigit(tick, level) == 0)
+			{
+				level++;
+			}
+			if (level == TIMING_WHEEL_LEVELS - 1 && TimingWheelGetDigit(tick, level) == 0)
+			{
+				TimingWheelCascade(_wheel, TIMING_WHEEL_OVERFLOW);
+			}
+			for (; level > 0; level--)
+			{
+				TimingWheelCascade(_wheel,
+					level * TIMING_WHEEL_SLOTS + TimingWheelGetDigit(tick, level));
+			}
+		}
+
+		unsigned int bucket = (unsigned int)tick & TIMING_WHEEL_MASK;
+		unsigned int id = _wheel->heads[bucket];
+		_wheel->heads[bucket] = TIMING_WHEEL_NONE;
+		while (id != TIMING_WHEEL_NONE)
+		{
+			_wheel->nodes[id].bucket = TIMING_WHEEL_NO_BUCKET;
+			_wheel->count--;
+			_wheel->expired[expiredNb++] = id;
+			id = _wheel->nodes[id].next;
+		}
+	}
+	*_expired = _wheel->expired;
+	return expiredNb;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Config.h>
+
+/// @brief Hierarchical timing wheel of integer ids
+///
+/// Each id is scheduled at a tick, advancing the wheel returns the ids
+/// whose tick is reached. Inserting and removing an id is O(1), advancing
+/// by one tick only looks at the ids expiring at this tick, far ids are
+/// cascaded to the lower levels of the wheel as their tick gets closer.
+typedef struct TimingWheel TimingWheel;
+
+/// @brief Value of an id that is not in the wheel
+#define TIMING_WHEEL_NONE 0xFFFFFFFFu
+
+//////////////////////////////////////////////////////////////
+/// @brief Create a new timing wheel at tick 0
+///
+/// @return Timing wheel object, or NULL if it cannot be create
+//////////////////////////////////////////////////////////////
+TimingWheel* TimingWheelCreate(void);
+
+//////////////////////////////////////////////////////////////
+/// @brief Destroy an existing timing wheel
+///
+/// @param _wheel Timing wheel object
+//////////////////////////////////////////////////////////////
+void TimingWheelDestroy(TimingWheel* _wheel);
+
+//////////////////////////////////////////////////////////////
+/// @brief Make room for the ids below a capacity
+///
+/// @param _wheel Timing wheel object
+///
+/// @param _capacity Number of ids, new ids are not in the wheel
+///
+/// @return sfTrue if the ids fit, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool TimingWheelReserve(TimingWheel* _wheel, unsigned int _capacity);
+
+//////////////////////////////////////////////////////////////
+/// @brief Get the current tick of a timing wheel
+///
+/// @param _wheel Timing wheel object
+///
+/// @return Last tick the wheel advanced to
+//////////////////////////////////////////////////////////////
+unsigned long long TimingWheelGetTick(const TimingWheel* _wheel);
+
+//////////////////////////////////////////////////////////////
+/// @brief Schedule an id at a tick
+///
+/// An id already in the wheel is moved to the new tick.
+///
+/// @param _wheel Timing wheel object
+///
+/// @param _id Id below the capacity
+///
+/// @param _tick Tick of the id, ticks not after the current one
+///			    expire at the next tick
+//////////////////////////////////////////////////////////////
+void TimingWheelInsert(TimingWheel* _wheel, unsigned int _id, unsigned long long _tick);
+
+//////////////////////////////////////////////////////////////
+/// @brief Remove an id from a timing wheel
+///
+/// @param _wheel Timing wheel object
+///
+/// @param _id Id below the capacity, ignored if it is not in the wheel
+//////////////////////////////////////////////////////////////
+void TimingWheelRemove(TimingWheel* _wheel, unsigned int _id);
+
+//////////////////////////////////////////////////////////////
+/// @brief Give the tick of an id to another id
+///
+/// Used when the owner of an id is moved, the source id is removed.
+///
+/// @param _wheel Timing wheel object
+///
+/// @param _from Id to move, ignored if it is not in the wheel
+///
+/// @param _to Id taking its place, not in the wheel
+//////////////////////////////////////////////////////////////
+void TimingWheelMove(TimingWheel* _wheel, unsigned int _from, unsigned int _to);
+
+//////////////////////////////////////////////////////////////
+/// @brief Tell if an id is in a timing wheel
+///
+/// @param _wheel Timing wheel object
+///
+/// @param _id Id below the capacity
+///
+/// @return sfTrue if the id is scheduled, sfFalse otherwise
+//////////////////////////////////////////////////////////////
+sfBool TimingWheelContains(const TimingWheel* _wheel, unsigned int _id);
+
+//////////////////////////////////////////////////////////////
+/// @brief Advance a timing wheel up to a tick
+///
+/// The expired ids are removed from the wheel. The list stays valid
+/// until the next call and the ids can be inserted again meanwhile.
+///
+/// @param _wheel Timing wheel object
+///
+/// @param _tick Tick to advance to, nothing is done if it is not after
+///			    the current one
+///
+/// @param _expired Filled with the ids whose tick is reached
+///
+/// @return Number of expired ids
+//////////////////////////////////////////////////////////////
+unsigned int TimingWheelAdvance(
+	TimingWheel* _wheel,
+	unsigned long long _tick,
+	const unsigned int** _expired);
@@ -0,0 +1,716 @@
+#include "../Animation.h"
+#include "../AnimationClip.h"
+#include "../AnimationKernel.h"
+#include "../AnimationLod.h"
+#include "../AnimationSnapshot.h"
+#include "../AnimationSync.h"
+#include "../AnimationSystem.h"
+
+#include <SFML/Graphics.h>
+#include <SFML/System.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Sprite sheet generated for the benchmark
+#define BENCHMARK_SHEET_FILE "AnimationBenchmarkSheet.png"
+#define BENCHMARK_SHEET_SIZE 512
+#define BENCHMARK_FRAME_SIZE 32
+#define BENCHMARK_FRAMES_NB 16
+/// Animation updates per run when the number of ticks is not given
+#define BENCHMARK_UPDATES_PER_RUN 1000000
+/// Maximum number of instance counts on the command line
+#define BENCHMARK_SIZES_MAX 16
+/// Animations per row of the map the instances are spread on
+#define BENCHMARK_MAP_WIDTH 1000
+/// Area of the view culling the map
+#define BENCHMARK_VIEW_WIDTH 1280
+#define BENCHMARK_VIEW_HEIGHT 720
+
+// Measures the animation core on the CSFML stub or on CSFML, one JSON
+// object per run :
+// AnimationBenchmark [--sizes 1000,10000,...] [--ticks n] [--kernel scalar|sse2|avx2] [--output file]
+
+// Allocations are counted by wrapping the allocator at link time
+static unsigned long long allocationsNb = 0;
+
+#if defined(ANIMATION_BENCHMARK_WRAP_MALLOC)
+void* __real_malloc(size_t _size);
+void* __real_calloc(size_t _nb, size_t _size);
+void* __real_realloc(void* _pointer, size_t _size);
+void __real_free(void* _pointer);
+
+void* __wrap_malloc(size_t _size)
+{
+	allocationsNb++;
+	return __real_malloc(_size);
+}
+
+void* __wrap_calloc(size_t _nb, size_t _size)
+{
+	allocationsNb++;
+	return __real_calloc(_nb, _size);
+}
+
+void* __wrap_realloc(void* _pointer, size_t _size)
+{
+	allocationsNb++;
+	return __real_realloc(_pointer, _size);
+}
+
+void __wrap_free(void* _pointer)
+{
+	__real_free(_pointer);
+}
+#endif
+
+typedef struct BenchmarkLayout
+{
+	const char* structure;
+	sfVector2u offset;
+	sfVector2u blockLength;
+	sfBool isBlock;
+} BenchmarkLayout;
+
+typedef struct BenchmarkState
+{
+	const char* name;
+	unsigned char flags;
+} BenchmarkState;
+
+static const BenchmarkLayout layouts[] =
+{
+	{ "horizontal", { 0, 0 }, { 0, 0 }, sfFalse },
+	{ "vertical", { BENCHMARK_FRAME_SIZE, 0 }, { 0, 0 }, sfFalse },
+	{ "block", { 0, BENCHMARK_FRAME_SIZE }, { 4, 4 }, sfTrue },
+};
+
+static const BenchmarkState states[] =
+{
+	{ "default", DEFAULT },
+	{ "looped", LOOPED },
+	{ "reversed", LOOPED | REVERSED },
+	{ "flip_x", LOOPED | FLIP_X },
+	{ "flip_xy", LOOPED | REVERSED | FLIP_X | FLIP_Y },
+	{ "lazy", LOOPED | LAZY },
+};
+
+#define BENCHMARK_LAYOUTS_NB (sizeof(layouts) / sizeof(layouts[0]))
+#define BENCHMARK_STATES_NB (sizeof(states) / sizeof(states[0]))
+
+typedef struct Benchmark
+{
+	FILE* output;
+	unsigned int runsNb;
+	unsigned int ticks;
+	sfClock* clock;
+} Benchmark;
+
+static const char* BenchmarkGetKernelName(AnimationKernelLevel _level)
+{
+	switch (_level)
+	{
+	case ANIMATION_KERNEL_AVX2:
+		return "avx2";
+	case ANIMATION_KERNEL_SSE2:
+		return "sse2";
+	default:
+		return "scalar";
+	}
+}
+
+// Write a sprite sheet big enough for every layout
+static sfBool BenchmarkCreateSheet(void)
+{
+	sfImage* image = sfImage_createFromColor(
+		BENCHMARK_SHEET_SIZE, BENCHMARK_SHEET_SIZE, sfWhite);
+	if (image == NULL)
+	{
+		return sfFalse;
+	}
+	sfBool saved = sfImage_saveToFile(image, BENCHMARK_SHEET_FILE);
+	sfImage_destroy(image);
+	return saved;
+}
+
+static Animation* BenchmarkCreateAnimation(
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state,
+	unsigned int _index)
+{
+	Animation* anim = AnimationSystemCreateAnimation(_system,
+		(sfVector2u){ BENCHMARK_FRAME_SIZE, BENCHMARK_FRAME_SIZE },
+		BENCHMARK_FRAMES_NB);
+	if (anim == NULL)
+	{
+		return NULL;
+	}
+	sfVector2u offset = _layout->offset;
+	sfVector2u blockLength = _layout->blockLength;
+	AnimationSetSpriteSheet(anim, BENCHMARK_SHEET_FILE, _layout->structure,
+		&offset, _layout->isBlock ? &blockLength : NULL);
+	AnimationSetFramerate(anim, 12.f);
+	AnimationSetPosition(anim, (sfVector2f){
+		(float)(_index % BENCHMARK_MAP_WIDTH * BENCHMARK_FRAME_SIZE),
+		(float)(_index / BENCHMARK_MAP_WIDTH * BENCHMARK_FRAME_SIZE) });
+	AnimationPlay(anim, _state->flags);
+	// Spread the clocks so that frames do not all change on the same tick
+	AnimationSetClock(anim, AnimationGetDuration(anim) * (float)(_index % 97) / 97.f);
+	return anim;
+}
+
+static AnimationSystem* BenchmarkCreateSystem(
+	unsigned int _instancesNb,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	AnimationSystem* system = AnimationSystemCreate(_instancesNb);
+	if (system == NULL)
+	{
+		return NULL;
+	}
+	for (unsigned int i = 0; i < _instancesNb; i++)
+	{
+		if (BenchmarkCreateAnimation(system, _layout, _state, i) == NULL)
+		{
+			AnimationSystemDestroy(system);
+			return NULL;
+		}
+	}
+	return system;
+}
+
+// A frame is one tick, or one pass over every instance for copy and create
+static void BenchmarkReport(
+	Benchmark* _benchmark,
+	const char* _operation,
+	unsigned int _instancesNb,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state,
+	unsigned int _framesNb,
+	sfInt64 _microseconds,
+	unsigned long long _allocationsNb)
+{
+	double operationsNb = (double)_instancesNb * (double)_framesNb;
+	fprintf(_benchmark->output,
+		"%s\n    {\"operation\": \"%s\", \"instances\": %u, \"layout\": \"%s\", "
+		"\"state\": \"%s\", \"frames\": %u, \"ns_per_animation\": %.3f, ",
+		_benchmark->runsNb > 0 ? "," : "",
+		_operation, _instancesNb, _layout->structure, _state->name, _framesNb,
+		(double)_microseconds * 1000.0 / operationsNb);
+#if defined(ANIMATION_BENCHMARK_WRAP_MALLOC)
+	fprintf(_benchmark->output, "\"allocations_per_frame\": %.3f}",
+		(double)_allocationsNb / (double)_framesNb);
+#else
+	(void)_allocationsNb;
+	fprintf(_benchmark->output, "\"allocations_per_frame\": null}");
+#endif
+	_benchmark->runsNb++;
+}
+
+static void BenchmarkUpdate(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	unsigned int count = AnimationSystemGetCount(_system);
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			AnimationUpdate(AnimationSystemGetAnimation(_system, i), 1.f / 60.f);
+		}
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "update", count, _layout, _state,
+		_benchmark->ticks, elapsed, allocationsNb - allocations);
+}
+
+static void BenchmarkSystemUpdate(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		AnimationSystemUpdate(_system, 1.f / 60.f);
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "system_update", AnimationSystemGetCount(_system),
+		_layout, _state, _benchmark->ticks, elapsed, allocationsNb - allocations);
+}
+
+// Same updates with the clocks in ticks, 600 ticks per second
+static void BenchmarkTickUpdate(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	if (!AnimationSystemSetTickRate(_system, 600))
+	{
+		return;
+	}
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		AnimationSystemUpdateTicks(_system, 10);
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "tick_update", AnimationSystemGetCount(_system),
+		_layout, _state, _benchmark->ticks, elapsed, allocationsNb - allocations);
+	AnimationSystemSetTickRate(_system, 0);
+}
+
+// Same updates with the animations out of a window sized view at a
+// lower rate, the further the lower
+static void BenchmarkLodUpdate(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	sfVector2f focus = { BENCHMARK_VIEW_WIDTH / 2.f, BENCHMARK_VIEW_HEIGHT / 2.f };
+	AnimationSystemSetLodTiers(_system, focus, BENCHMARK_VIEW_WIDTH / 2.f, 0);
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		AnimationSystemUpdate(_system, 1.f / 60.f);
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "lod_update", AnimationSystemGetCount(_system),
+		_layout, _state, _benchmark->ticks, elapsed, allocationsNb - allocations);
+	AnimationSystemSetLodTiers(_system, focus, 0, 0);
+}
+
+// Save then restore every animation, as a rollback does each frame
+static void BenchmarkSnapshotRestore(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	size_t size = AnimationSystemGetSnapshotSize(_system);
+	void* snapshot = malloc(size);
+	if (snapshot == NULL)
+	{
+		return;
+	}
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		AnimationSystemSaveSnapshot(_system, snapshot, size);
+		AnimationSystemRestoreSnapshot(_system, snapshot, size);
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "snapshot_restore", AnimationSystemGetCount(_system),
+		_layout, _state, _benchmark->ticks, elapsed, allocationsNb - allocations);
+	free(snapshot);
+}
+
+// Spawn an instance of a clip per animation, then update them as the
+// system is
+static void BenchmarkInstanceUpdate(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	unsigned int count = AnimationSystemGetCount(_system);
+	AnimationClip* clip = AnimationClipCreateFromAnimation(AnimationSystemGetAnimation(_system, 0));
+	AnimationInstance* instances = (AnimationInstance*)malloc(sizeof(AnimationInstance) * count);
+	if (clip == NULL || instances == NULL)
+	{
+		AnimationClipDestroy(clip);
+		free(instances);
+		return;
+	}
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int i = 0; i < count; i++)
+	{
+		instances[i] = AnimationClipSpawn(clip,
+			AnimationGetPosition(AnimationSystemGetAnimation(_system, i)), _state->flags);
+	}
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		AnimationInstanceUpdateAll(instances, count, 1.f / 60.f);
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "instance_update", count, _layout, _state,
+		_benchmark->ticks, elapsed, allocationsNb - allocations);
+	free(instances);
+	AnimationClipDestroy(clip);
+}
+
+// Join every animation to a single sync group, then update the group
+// instead of the system
+static void BenchmarkSyncUpdate(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	unsigned int count = AnimationSystemGetCount(_system);
+	AnimationSyncGroup* group = AnimationSyncGroupCreate();
+	if (group == NULL)
+	{
+		return;
+	}
+	for (unsigned int i = 0; i < count; i++)
+	{
+		AnimationSyncGroupJoin(group, AnimationSystemGetAnimation(_system, i), 0);
+	}
+	AnimationSyncGroupPlay(group, _state->flags);
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		AnimationSyncGroupUpdate(group, 1.f / 60.f);
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "sync_update", count, _layout, _state,
+		_benchmark->ticks, elapsed, allocationsNb - allocations);
+	AnimationSyncGroupDestroy(group);
+	for (unsigned int i = 0; i < count; i++)
+	{
+		AnimationPlay(AnimationSystemGetAnimation(_system, i), _state->flags);
+	}
+}
+
+static void BenchmarkEventUpdate(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	if (!AnimationSystemSetEventDriven(_system, sfTrue))
+	{
+		return;
+	}
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		AnimationSystemUpdate(_system, 1.f / 60.f);
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "event_update", AnimationSystemGetCount(_system),
+		_layout, _state, _benchmark->ticks, elapsed, allocationsNb - allocations);
+	AnimationSystemSetEventDriven(_system, sfFalse);
+}
+
+// Update with the animations out of a window sized view culled
+static void BenchmarkCulledUpdate(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	if (!AnimationSystemSetCulling(_system, 2.f * BENCHMARK_FRAME_SIZE))
+	{
+		return;
+	}
+	sfFloatRect view = { 0, 0, BENCHMARK_VIEW_WIDTH, BENCHMARK_VIEW_HEIGHT };
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		AnimationSystemUpdate(_system, 1.f / 60.f);
+		AnimationSystemCull(_system, view);
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "culled_update", AnimationSystemGetCount(_system),
+		_layout, _state, _benchmark->ticks, elapsed, allocationsNb - allocations);
+	AnimationSystemSetCulling(_system, 0);
+}
+
+static volatile int benchmarkSink;
+
+// Update then read the frame of every animation, as drawing them does
+static void BenchmarkFrameQuery(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	unsigned int count = AnimationSystemGetCount(_system);
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		AnimationAdvanceGlobalClock(1.f / 60.f);
+		AnimationSystemUpdate(_system, 1.f / 60.f);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			// Kept in a volatile so that the reads are not optimized away
+			benchmarkSink = AnimationGetTextureRect(AnimationSystemGetAnimation(_system, i)).left;
+		}
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "frame_query", count, _layout, _state,
+		_benchmark->ticks, elapsed, allocationsNb - allocations);
+}
+
+static void BenchmarkSeek(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state)
+{
+	unsigned int count = AnimationSystemGetCount(_system);
+	unsigned long long allocations = allocationsNb;
+	sfClock_restart(_benchmark->clock);
+	for (unsigned int tick = 0; tick < _benchmark->ticks; tick++)
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			Animation* anim = AnimationSystemGetAnimation(_system, i);
+			unsigned char frame = (unsigned char)((i + tick) % BENCHMARK_FRAMES_NB);
+			AnimationSetClock(anim, (float)frame / 12.f);
+			AnimationSetFrame(anim, frame);
+			AnimationFrameUpdate(anim);
+		}
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "seek", count, _layout, _state,
+		_benchmark->ticks, elapsed, allocationsNb - allocations);
+}
+
+static void BenchmarkCopy(
+	Benchmark* _benchmark,
+	AnimationSystem* _system,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state,
+	Animation** _copies)
+{
+	unsigned int count = AnimationSystemGetCount(_system);
+	unsigned long long allocations = 0;
+	// The first pass fills the pools, the second one is measured
+	for (unsigned int pass = 0; pass < 2; pass++)
+	{
+		allocations = allocationsNb;
+		sfClock_restart(_benchmark->clock);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			_copies[i] = AnimationCopy(AnimationSystemGetAnimation(_system, i));
+		}
+		for (unsigned int i = count; i-- > 0;)
+		{
+			AnimationDestroy(_copies[i]);
+		}
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "copy_destroy", count, _layout, _state,
+		1, elapsed, allocationsNb - allocations);
+}
+
+static sfBool BenchmarkCreateDestroy(
+	Benchmark* _benchmark,
+	unsigned int _instancesNb,
+	const BenchmarkLayout* _layout,
+	const BenchmarkState* _state,
+	Animation** _anims)
+{
+	AnimationSystem* system = AnimationSystemCreate(_instancesNb);
+	if (system == NULL)
+	{
+		return sfFalse;
+	}
+	unsigned long long allocations = 0;
+	// The first pass fills the pools, the second one is measured
+	for (unsigned int pass = 0; pass < 2; pass++)
+	{
+		allocations = allocationsNb;
+		sfClock_restart(_benchmark->clock);
+		for (unsigned int i = 0; i < _instancesNb; i++)
+		{
+			_anims[i] = BenchmarkCreateAnimation(system, _layout, _state, i);
+			if (_anims[i] == NULL)
+			{
+				AnimationSystemDestroy(system);
+				return sfFalse;
+			}
+		}
+		for (unsigned int i = _instancesNb; i-- > 0;)
+		{
+			AnimationDestroy(_anims[i]);
+		}
+	}
+	sfInt64 elapsed = sfTime_asMicroseconds(sfClock_getElapsedTime(_benchmark->clock));
+	BenchmarkReport(_benchmark, "create_destroy", _instancesNb, _layout, _state,
+		1, elapsed, allocationsNb - allocations);
+	AnimationSystemDestroy(system);
+	return sfTrue;
+}
+
+static sfBool BenchmarkRun(
+	Benchmark* _benchmark,
+	unsigned int _instancesNb,
+	unsigned int _ticks)
+{
+	Animation** anims = (Animation**)malloc(sizeof(Animation*) * _instancesNb);
+	if (anims == NULL)
+	{
+		printf("Error during memory allocation !");
+		return sfFalse;
+	}
+	if (_ticks == 0)
+	{
+		_ticks = BENCHMARK_UPDATES_PER_RUN / _instancesNb;
+		_ticks = _ticks > 2 ? _ticks : 2;
+	}
+	_benchmark->ticks = _ticks;
+
+	for (unsigned int l = 0; l < BENCHMARK_LAYOUTS_NB; l++)
+	{
+		for (unsigned int s = 0; s < BENCHMARK_STATES_NB; s++)
+		{
+			AnimationSystem* system = BenchmarkCreateSystem(
+				_instancesNb, &layouts[l], &states[s]);
+			if (system == NULL)
+			{
+				free(anims);
+				return sfFalse;
+			}
+			BenchmarkUpdate(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkSystemUpdate(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkTickUpdate(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkLodUpdate(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkSnapshotRestore(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkInstanceUpdate(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkSyncUpdate(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkEventUpdate(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkCulledUpdate(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkFrameQuery(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkSeek(_benchmark, system, &layouts[l], &states[s]);
+			BenchmarkCopy(_benchmark, system, &layouts[l], &states[s], anims);
+			AnimationSystemDestroy(system);
+
+			if (!BenchmarkCreateDestroy(_benchmark, _instancesNb,
+				&layouts[l], &states[s], anims))
+			{
+				free(anims);
+				return sfFalse;
+			}
+		}
+	}
+	free(anims);
+	return sfTrue;
+}
+
+static unsigned int BenchmarkParseSizes(const char* _list, unsigned int* _sizes)
+{
+	unsigned int sizesNb = 0;
+	const char* cursor = _list;
+	while (*cursor != '\0' && sizesNb < BENCHMARK_SIZES_MAX)
+	{
+		char* end = NULL;
+		unsigned long size = strtoul(cursor, &end, 10);
+		if (end == cursor || size == 0)
+		{
+			return 0;
+		}
+		_sizes[sizesNb++] = (unsigned int)size;
+		cursor = *end == ',' ? end + 1 : end;
+	}
+	return sizesNb;
+}
+
+int main(int _argc, char** _argv)
+{
+	unsigned int sizes[BENCHMARK_SIZES_MAX] = { 1000, 10000, 100000, 1000000 };
+	unsigned int sizesNb = 4;
+	unsigned int ticks = 0;
+	const char* outputFile = NULL;
+
+	for (int i = 1; i < _argc; i++)
+	{
+		if (strcmp(_argv[i], "--sizes") == 0 && i + 1 < _argc)
+		{
+			sizesNb = BenchmarkParseSizes(_argv[++i], sizes);
+		}
+		else if (strcmp(_argv[i], "--ticks") == 0 && i + 1 < _argc)
+		{
+			ticks = (unsigned int)strtoul(_argv[++i], NULL, 10);
+		}
+		else if (strcmp(_argv[i], "--kernel") == 0 && i + 1 < _argc)
+		{
+			i++;
+			AnimationKernelSetLevel(strcmp(_argv[i], "avx2") == 0 ? ANIMATION_KERNEL_AVX2
+				: strcmp(_argv[i], "sse2") == 0 ? ANIMATION_KERNEL_SSE2
+				: ANIMATION_KERNEL_SCALAR);
+		}
+		else if (strcmp(_argv[i], "--output") == 0 && i + 1 < _argc)
+		{
+			outputFile = _argv[++i];
+		}
+		else
+		{
+			sizesNb = 0;
+			break;
+		}
+	}
+	if (sizesNb == 0)
+	{
+		printf("Usage : AnimationBenchmark [--sizes 1000,10000,...] [--ticks n] "
+			"[--kernel scalar|sse2|avx2] [--output file]\n");
+		return EXIT_FAILURE;
+	}
+
+	if (!BenchmarkCreateSheet())
+	{
+		printf("Error during cration of the benchmark sprite sheet !\n");
+		return EXIT_FAILURE;
+	}
+	Benchmark benchmark = { stdout, 0, 0, sfClock_create() };
+	if (outputFile != NULL)
+	{
+		benchmark.output = fopen(outputFile, "w");
+		if (benchmark.output == NULL)
+		{
+			printf("Error during opening of the output file !\n");
+			sfClock_destroy(benchmark.clock);
+			remove(BENCHMARK_SHEET_FILE);
+			return EXIT_FAILURE;
+		}
+	}
+
+	fprintf(benchmark.output, "{\n  \"kernel\": \"%s\",\n",
+		BenchmarkGetKernelName(AnimationKernelGetLevel()));
+#if defined(ANIMATION_USE_CSFML_STUB)
+	fprintf(benchmark.output, "  \"backend\": \"stub\",\n");
+#else
+	fprintf(benchmark.output, "  \"backend\": \"csfml\",\n");
+#endif
+	fprintf(benchmark.output, "  \"frames_nb\": %u,\n  \"runs\": [",
+		BENCHMARK_FRAMES_NB);
+
+	int result = EXIT_SUCCESS;
+	for (unsigned int i = 0; i < sizesNb && result == EXIT_SUCCESS; i++)
+	{
+		if (!BenchmarkRun(&benchmark, sizes[i], ticks))
+		{
+			result = EXIT_FAILURE;
+		}
+	}
+	fprintf(benchmark.output, "\n  ]\n}\n");
+
+	if (benchmark.output != stdout)
+	{
+		fclose(benchmark.output);
+	}
+	sfClock_destroy(benchmark.clock);
+	remove(BENCHMARK_SHEET_FILE);
+	return result;
+}
@@ -0,0 +1,81 @@
+#include "../AnimationAtlas.h"
+
+#include <SFML/Graphics.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Length of a line of a manifest file
+#define ATLAS_PACKER_LINE_LENGTH 1024
+
+// Packs the sprite sheets listed in a manifest into an atlas, one per line :
+// <structure> <frame width> <frame height> <frames nb> <offset x> <offset y> <block x> <block y> <file>
+int main(int _argc, char** _argv)
+{
+	if (_argc < 3)
+	{
+		printf("Usage : AtlasPacker <manifest> <output.atlas> [page size] [padding]\n");
+		return EXIT_FAILURE;
+	}
+	unsigned int pageSize = _argc > 3 ? (unsigned int)strtoul(_argv[3], NULL, 10) : 2048;
+	unsigned int padding = _argc > 4 ? (unsigned int)strtoul(_argv[4], NULL, 10) : 1;
+
+	FILE* manifest = fopen(_argv[1], "r");
+	if (manifest == NULL)
+	{
+		printf("Error during opening of the manifest !\n");
+		return EXIT_FAILURE;
+	}
+	AnimationAtlas* atlas = AnimationAtlasCreate(pageSize, padding);
+	if (atlas == NULL)
+	{
+		fclose(manifest);
+		return EXIT_FAILURE;
+	}
+
+	char line[ATLAS_PACKER_LINE_LENGTH];
+	unsigned int lineNb = 0;
+	int result = EXIT_SUCCESS;
+	while (fgets(line, sizeof(line), manifest) != NULL)
+	{
+		lineNb++;
+		line[strcspn(line, "\r\n")] = '\0';
+		if (line[0] == '\0' || line[0] == '#')
+		{
+			continue;
+		}
+
+		char structure[32];
+		sfVector2u frameSize;
+		unsigned int framesNb;
+		sfVector2u offset;
+		sfVector2u blockLength;
+		int nameStart = 0;
+		if (sscanf(line, "%31s %u %u %u %u %u %u %u %n",
+			structure, &frameSize.x, &frameSize.y, &framesNb,
+			&offset.x, &offset.y, &blockLength.x, &blockLength.y,
+			&nameStart) != 8
+			|| nameStart == 0
+			|| framesNb > 255
+			|| AnimationAtlasAddSpriteSheet(atlas, line + nameStart, structure,
+				frameSize, (unsigned char)framesNb, &offset, &blockLength) < 0)
+		{
+			printf("Error : invalid sprite sheet at line %u !\n", lineNb);
+			result = EXIT_FAILURE;
+		}
+	}
+	fclose(manifest);
+
+	if (result == EXIT_SUCCESS
+		&& (!AnimationAtlasBuild(atlas) || !AnimationAtlasSave(atlas, _argv[2])))
+	{
+		result = EXIT_FAILURE;
+	}
+	if (result == EXIT_SUCCESS)
+	{
+		printf("%u sprite sheets packed into %u pages\n",
+			AnimationAtlasGetRegionsNb(atlas), AnimationAtlasGetPagesNb(atlas));
+	}
+	AnimationAtlasDestroy(atlas);
+	return result;
+}
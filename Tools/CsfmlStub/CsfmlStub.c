@@ -0,0 +1,588 @@
+///
+// Headless stand-in for the CSFML functions used by the animation core.
+// Objects are plain heap structures, textures and images keep their pixels
+// in memory and drawing only counts the submitted primitives.
+///
+#define _POSIX_C_SOURCE 200809L
+
+#include <SFML/Graphics.h>
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+const sfColor sfBlack = { 0, 0, 0, 255 };
+const sfColor sfWhite = { 255, 255, 255, 255 };
+const sfColor sfTransparent = { 0, 0, 0, 0 };
+const sfTransform sfTransform_Identity = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 } };
+const sfBlendMode sfBlendAlpha = {
+	sfBlendFactorSrcAlpha, sfBlendFactorOneMinusSrcAlpha, sfBlendEquationAdd,
+	sfBlendFactorOne, sfBlendFactorOneMinusSrcAlpha, sfBlendEquationAdd };
+
+struct sfClock { sfInt64 start; };
+struct sfMutex { pthread_mutex_t mutex; };
+struct sfThread { pthread_t thread; void (*function)(void*); void* userData; sfBool running; };
+struct sfImage { sfVector2u size; sfUint8* pixels; };
+struct sfTexture { sfVector2u size; sfUint8* pixels; };
+struct sfSprite
+{
+	sfVector2f position;
+	float rotation;
+	sfVector2f scale;
+	sfVector2f origin;
+	const sfTexture* texture;
+	sfIntRect textureRect;
+	sfColor color;
+};
+struct sfVertexArray { sfVertex* vertices; size_t count; size_t capacity; sfPrimitiveType type; };
+struct sfView { sfVector2f center; sfVector2f size; float rotation; };
+struct sfRenderWindow { sfView view; };
+struct sfRenderTexture { sfView view; };
+
+// Number of primitives submitted to the stub render targets
+unsigned long long sfStub_drawCalls = 0;
+unsigned long long sfStub_drawnVertices = 0;
+
+static sfInt64 sfStubNow(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (sfInt64)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+// System
+float sfTime_asSeconds(sfTime _time) { return (float)_time.microseconds / 1000000.f; }
+sfInt32 sfTime_asMilliseconds(sfTime _time) { return (sfInt32)(_time.microseconds / 1000); }
+sfInt64 sfTime_asMicroseconds(sfTime _time) { return _time.microseconds; }
+sfTime sfSeconds(float _amount) { return (sfTime){ (sfInt64)(_amount * 1000000) }; }
+sfTime sfMilliseconds(sfInt32 _amount) { return (sfTime){ (sfInt64)_amount * 1000 }; }
+sfTime sfMicroseconds(sfInt64 _amount) { return (sfTime){ _amount }; }
+
+sfClock* sfClock_create(void)
+{
+	sfClock* clock = malloc(sizeof(sfClock));
+	clock->start = sfStubNow();
+	return clock;
+}
+sfClock* sfClock_copy(const sfClock* _clock)
+{
+	sfClock* clock = malloc(sizeof(sfClock));
+	*clock = *_clock;
+	return clock;
+}
+void sfClock_destroy(sfClock* _clock) { free(_clock); }
+sfTime sfClock_getElapsedTime(const sfClock* _clock) { return (sfTime){ sfStubNow() - _clock->start }; }
+sfTime sfClock_restart(sfClock* _clock)
+{
+	sfInt64 now = sfStubNow();
+	sfTime elapsed = { now - _clock->start };
+	_clock->start = now;
+	return elapsed;
+}
+
+void sfSleep(sfTime _duration)
+{
+	struct timespec duration = {
+		(time_t)(_duration.microseconds / 1000000),
+		(long)(_duration.microseconds % 1000000) * 1000 };
+	nanosleep(&duration, NULL);
+}
+
+sfMutex* sfMutex_create(void)
+{
+	sfMutex* mutex = malloc(sizeof(sfMutex));
+	pthread_mutex_init(&mutex->mutex, NULL);
+	return mutex;
+}
+void sfMutex_destroy(sfMutex* _mutex) { pthread_mutex_destroy(&_mutex->mutex); free(_mutex); }
+void sfMutex_lock(sfMutex* _mutex) { pthread_mutex_lock(&_mutex->mutex); }
+void sfMutex_unlock(sfMutex* _mutex) { pthread_mutex_unlock(&_mutex->mutex); }
+
+static void* sfStubThreadEntry(void* _thread)
+{
+	sfThread* thread = _thread;
+	thread->function(thread->userData);
+	return NULL;
+}
+sfThread* sfThread_create(void (*_function)(void*), void* _userData)
+{
+	sfThread* thread = calloc(1, sizeof(sfThread));
+	thread->function = _function;
+	thread->userData = _userData;
+	return thread;
+}
+void sfThread_wait(sfThread* _thread)
+{
+	if (_thread->running)
+	{
+		pthread_join(_thread->thread, NULL);
+		_thread->running = sfFalse;
+	}
+}
+void sfThread_destroy(sfThread* _thread) { sfThread_wait(_thread); free(_thread); }
+void sfThread_launch(sfThread* _thread)
+{
+	sfThread_wait(_thread);
+	_thread->running = pthread_create(&_thread->thread, NULL, sfStubThreadEntry, _thread) == 0;
+}
+void sfThread_terminate(sfThread* _thread) { sfThread_wait(_thread); }
+
+// Colors and rects
+sfColor sfColor_fromRGBA(sfUint8 _red, sfUint8 _green, sfUint8 _blue, sfUint8 _alpha)
+{
+	return (sfColor){ _red, _green, _blue, _alpha };
+}
+
+sfBool sfFloatRect_intersects(const sfFloatRect* _rect1, const sfFloatRect* _rect2, sfFloatRect* _intersection)
+{
+	float left = fmaxf(_rect1->left, _rect2->left);
+	float top = fmaxf(_rect1->top, _rect2->top);
+	float right = fminf(_rect1->left + _rect1->width, _rect2->left + _rect2->width);
+	float bottom = fminf(_rect1->top + _rect1->height, _rect2->top + _rect2->height);
+	if (left < right && top < bottom)
+	{
+		if (_intersection) *_intersection = (sfFloatRect){ left, top, right - left, bottom - top };
+		return sfTrue;
+	}
+	if (_intersection) *_intersection = (sfFloatRect){ 0, 0, 0, 0 };
+	return sfFalse;
+}
+
+sfBool sfFloatRect_contains(const sfFloatRect* _rect, float _x, float _y)
+{
+	return _x >= _rect->left && _x < _rect->left + _rect->width
+		&& _y >= _rect->top && _y < _rect->top + _rect->height;
+}
+
+// Transforms
+sfTransform sfTransform_fromMatrix(
+	float _a00, float _a01, float _a02,
+	float _a10, float _a11, float _a12,
+	float _a20, float _a21, float _a22)
+{
+	return (sfTransform){ { _a00, _a01, _a02, _a10, _a11, _a12, _a20, _a21, _a22 } };
+}
+
+sfTransform sfTransform_getInverse(const sfTransform* _transform)
+{
+	const float* m = _transform->matrix;
+	float det = m[0] * (m[8] * m[4] - m[5] * m[7])
+		- m[3] * (m[8] * m[1] - m[2] * m[7])
+		+ m[6] * (m[5] * m[1] - m[2] * m[4]);
+	if (det == 0.f)
+		return sfTransform_Identity;
+	return sfTransform_fromMatrix(
+		(m[8] * m[4] - m[5] * m[7]) / det,
+		-(m[8] * m[1] - m[2] * m[7]) / det,
+		(m[5] * m[1] - m[2] * m[4]) / det,
+		-(m[8] * m[3] - m[5] * m[6]) / det,
+		(m[8] * m[0] - m[2] * m[6]) / det,
+		-(m[5] * m[0] - m[2] * m[3]) / det,
+		(m[7] * m[3] - m[4] * m[6]) / det,
+		-(m[7] * m[0] - m[1] * m[6]) / det,
+		(m[4] * m[0] - m[1] * m[3]) / det);
+}
+
+sfVector2f sfTransform_transformPoint(const sfTransform* _transform, sfVector2f _point)
+{
+	const float* m = _transform->matrix;
+	return (sfVector2f){
+		m[0] * _point.x + m[1] * _point.y + m[2],
+		m[3] * _point.x + m[4] * _point.y + m[5] };
+}
+
+sfFloatRect sfTransform_transformRect(const sfTransform* _transform, sfFloatRect _rectangle)
+{
+	sfVector2f points[4] = {
+		sfTransform_transformPoint(_transform, (sfVector2f){ _rectangle.left, _rectangle.top }),
+		sfTransform_transformPoint(_transform, (sfVector2f){ _rectangle.left, _rectangle.top + _rectangle.height }),
+		sfTransform_transformPoint(_transform, (sfVector2f){ _rectangle.left + _rectangle.width, _rectangle.top }),
+		sfTransform_transformPoint(_transform, (sfVector2f){ _rectangle.left + _rectangle.width, _rectangle.top + _rectangle.height }) };
+	float left = points[0].x, top = points[0].y, right = points[0].x, bottom = points[0].y;
+	for (int i = 1; i < 4; i++)
+	{
+		left = fminf(left, points[i].x);
+		top = fminf(top, points[i].y);
+		right = fmaxf(right, points[i].x);
+		bottom = fmaxf(bottom, points[i].y);
+	}
+	return (sfFloatRect){ left, top, right - left, bottom - top };
+}
+
+void sfTransform_combine(sfTransform* _transform, const sfTransform* _other)
+{
+	const float* a = _transform->matrix;
+	const float* b = _other->matrix;
+	*_transform = sfTransform_fromMatrix(
+		a[0] * b[0] + a[1] * b[3] + a[2] * b[6],
+		a[0] * b[1] + a[1] * b[4] + a[2] * b[7],
+		a[0] * b[2] + a[1] * b[5] + a[2] * b[8],
+		a[3] * b[0] + a[4] * b[3] + a[5] * b[6],
+		a[3] * b[1] + a[4] * b[4] + a[5] * b[7],
+		a[3] * b[2] + a[4] * b[5] + a[5] * b[8],
+		a[6] * b[0] + a[7] * b[3] + a[8] * b[6],
+		a[6] * b[1] + a[7] * b[4] + a[8] * b[7],
+		a[6] * b[2] + a[7] * b[5] + a[8] * b[8]);
+}
+
+// Images
+sfImage* sfImage_createFromColor(unsigned int _width, unsigned int _height, sfColor _color)
+{
+	sfImage* image = malloc(sizeof(sfImage));
+	image->size = (sfVector2u){ _width, _height };
+	image->pixels = malloc((size_t)_width * _height * 4 + 1);
+	for (size_t i = 0; i < (size_t)_width * _height; i++)
+		memcpy(image->pixels + i * 4, &_color, 4);
+	return image;
+}
+sfImage* sfImage_create(unsigned int _width, unsigned int _height)
+{
+	return sfImage_createFromColor(_width, _height, sfBlack);
+}
+sfImage* sfImage_createFromPixels(unsigned int _width, unsigned int _height, const sfUint8* _pixels)
+{
+	sfImage* image = sfImage_create(_width, _height);
+	if (_pixels) memcpy(image->pixels, _pixels, (size_t)_width * _height * 4);
+	return image;
+}
+
+// Read the size of a PNG file from its header
+static sfBool sfStubPngSize(const char* _filename, sfVector2u* _size)
+{
+	FILE* file = fopen(_filename, "rb");
+	unsigned char header[24];
+	if (file == NULL)
+		return sfFalse;
+	size_t read = fread(header, 1, sizeof(header), file);
+	fclose(file);
+	if (read != sizeof(header) || memcmp(header + 1, "PNG", 3) != 0)
+		return sfFalse;
+	_size->x = (unsigned)header[16] << 24 | (unsigned)header[17] << 16 | (unsigned)header[18] << 8 | header[19];
+	_size->y = (unsigned)header[20] << 24 | (unsigned)header[21] << 16 | (unsigned)header[22] << 8 | header[23];
+	return sfTrue;
+}
+
+sfImage* sfImage_createFromFile(const char* _filename)
+{
+	sfVector2u size;
+	if (!sfStubPngSize(_filename, &size))
+		return NULL;
+	// No decoder: fill with an opaque ellipse on a transparent background
+	sfImage* image = sfImage_createFromColor(size.x, size.y, sfTransparent);
+	// Files written by the stub carry their raw pixels after the header
+	FILE* file = fopen(_filename, "rb");
+	unsigned char marker[4] = { 0 };
+	if (file != NULL && fseek(file, 24, SEEK_SET) == 0 && fread(marker, 1, 4, file) == 4 && memcmp(marker, "RAWP", 4) == 0)
+	{
+		size_t n = fread(image->pixels, 4, (size_t)size.x * size.y, file);
+		(void)n;
+		fclose(file);
+		return image;
+	}
+	if (file != NULL) fclose(file);
+	for (unsigned int y = 0; y < size.y; y++)
+		for (unsigned int x = 0; x < size.x; x++)
+		{
+			float u = ((float)(x % 96) - 48.f) / 40.f;
+			float v = ((float)(y % 125) - 62.f) / 50.f;
+			if (u * u + v * v <= 1.f)
+				sfImage_setPixel(image, x, y, (sfColor){ (sfUint8)x, (sfUint8)y, 128, 255 });
+		}
+	return image;
+}
+sfImage* sfImage_copy(const sfImage* _image)
+{
+	return sfImage_createFromPixels(_image->size.x, _image->size.y, _image->pixels);
+}
+void sfImage_destroy(sfImage* _image)
+{
+	if (_image == NULL) return;
+	free(_image->pixels);
+	free(_image);
+}
+sfBool sfImage_saveToFile(const sfImage* _image, const char* _filename)
+{
+	// PNG signature and size, then the raw pixels: the stub has no encoder
+	FILE* file = fopen(_filename, "wb");
+	if (file == NULL)
+		return sfFalse;
+	unsigned char header[28] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n', 0, 0, 0, 13, 'I', 'H', 'D', 'R' };
+	for (int i = 0; i < 4; i++)
+	{
+		header[16 + i] = (unsigned char)(_image->size.x >> (24 - 8 * i));
+		header[20 + i] = (unsigned char)(_image->size.y >> (24 - 8 * i));
+	}
+	memcpy(header + 24, "RAWP", 4);
+	fwrite(header, 1, sizeof(header), file);
+	fwrite(_image->pixels, 4, (size_t)_image->size.x * _image->size.y, file);
+	fclose(file);
+	return sfTrue;
+}
+sfVector2u sfImage_getSize(const sfImage* _image) { return _image->size; }
+void sfImage_copyImage(sfImage* _image, const sfImage* _source, unsigned int _destX, unsigned int _destY, sfIntRect _sourceRect, sfBool _applyAlpha)
+{
+	(void)_applyAlpha;
+	if (_sourceRect.width == 0 || _sourceRect.height == 0)
+		_sourceRect = (sfIntRect){ 0, 0, (int)_source->size.x, (int)_source->size.y };
+	for (int y = 0; y < _sourceRect.height; y++)
+	{
+		unsigned int sy = (unsigned)(_sourceRect.top + y), dy = _destY + (unsigned)y;
+		if (sy >= _source->size.y || dy >= _image->size.y) break;
+		for (int x = 0; x < _sourceRect.width; x++)
+		{
+			unsigned int sx = (unsigned)(_sourceRect.left + x), dx = _destX + (unsigned)x;
+			if (sx >= _source->size.x || dx >= _image->size.x) break;
+			memcpy(_image->pixels + ((size_t)dy * _image->size.x + dx) * 4,
+				_source->pixels + ((size_t)sy * _source->size.x + sx) * 4, 4);
+		}
+	}
+}
+void sfImage_setPixel(sfImage* _image, unsigned int _x, unsigned int _y, sfColor _color)
+{
+	memcpy(_image->pixels + ((size_t)_y * _image->size.x + _x) * 4, &_color, 4);
+}
+sfColor sfImage_getPixel(const sfImage* _image, unsigned int _x, unsigned int _y)
+{
+	sfColor color;
+	memcpy(&color, _image->pixels + ((size_t)_y * _image->size.x + _x) * 4, 4);
+	return color;
+}
+const sfUint8* sfImage_getPixelsPtr(const sfImage* _image) { return _image->pixels; }
+
+// Textures
+sfTexture* sfTexture_create(unsigned int _width, unsigned int _height)
+{
+	sfTexture* texture = malloc(sizeof(sfTexture));
+	texture->size = (sfVector2u){ _width, _height };
+	texture->pixels = calloc((size_t)_width * _height * 4 + 1, 1);
+	return texture;
+}
+sfTexture* sfTexture_createFromImage(const sfImage* _image, const sfIntRect* _area)
+{
+	sfIntRect area = { 0, 0, (int)_image->size.x, (int)_image->size.y };
+	if (_area != NULL && _area->width > 0 && _area->height > 0)
+	{
+		// Same clamping as sf::Texture::loadFromImage
+		area = *_area;
+		if (area.left < 0) area.left = 0;
+		if (area.top < 0) area.top = 0;
+		if (area.left + area.width > (int)_image->size.x) area.width = (int)_image->size.x - area.left;
+		if (area.top + area.height > (int)_image->size.y) area.height = (int)_image->size.y - area.top;
+		if (area.width <= 0 || area.height <= 0) return NULL;
+	}
+	sfTexture* texture = sfTexture_create((unsigned)area.width, (unsigned)area.height);
+	sfImage view = { texture->size, texture->pixels };
+	sfImage_copyImage(&view, _image, 0, 0, area, sfFalse);
+	return texture;
+}
+sfTexture* sfTexture_createFromFile(const char* _filename, const sfIntRect* _area)
+{
+	sfImage* image = sfImage_createFromFile(_filename);
+	if (image == NULL)
+		return NULL;
+	sfTexture* texture = sfTexture_createFromImage(image, _area);
+	sfImage_destroy(image);
+	return texture;
+}
+sfTexture* sfTexture_copy(const sfTexture* _texture)
+{
+	sfTexture* texture = sfTexture_create(_texture->size.x, _texture->size.y);
+	memcpy(texture->pixels, _texture->pixels, (size_t)_texture->size.x * _texture->size.y * 4);
+	return texture;
+}
+void sfTexture_destroy(sfTexture* _texture)
+{
+	if (_texture == NULL) return;
+	free(_texture->pixels);
+	free(_texture);
+}
+sfVector2u sfTexture_getSize(const sfTexture* _texture) { return _texture->size; }
+sfImage* sfTexture_copyToImage(const sfTexture* _texture)
+{
+	return sfImage_createFromPixels(_texture->size.x, _texture->size.y, _texture->pixels);
+}
+void sfTexture_updateFromPixels(sfTexture* _texture, const sfUint8* _pixels, unsigned int _width, unsigned int _height, unsigned int _x, unsigned int _y)
+{
+	sfImage source = { { _width, _height }, (sfUint8*)_pixels };
+	sfImage view = { _texture->size, _texture->pixels };
+	sfImage_copyImage(&view, &source, _x, _y, (sfIntRect){ 0, 0, (int)_width, (int)_height }, sfFalse);
+}
+void sfTexture_updateFromImage(sfTexture* _texture, const sfImage* _image, unsigned int _x, unsigned int _y)
+{
+	sfTexture_updateFromPixels(_texture, _image->pixels, _image->size.x, _image->size.y, _x, _y);
+}
+unsigned int sfTexture_getMaximumSize(void) { return 8192; }
+
+// Sprites
+sfSprite* sfSprite_create(void)
+{
+	sfSprite* sprite = calloc(1, sizeof(sfSprite));
+	sprite->scale = (sfVector2f){ 1, 1 };
+	sprite->color = sfWhite;
+	return sprite;
+}
+sfSprite* sfSprite_copy(const sfSprite* _sprite)
+{
+	sfSprite* sprite = malloc(sizeof(sfSprite));
+	*sprite = *_sprite;
+	return sprite;
+}
+void sfSprite_destroy(sfSprite* _sprite) { free(_sprite); }
+void sfSprite_setPosition(sfSprite* _sprite, sfVector2f _position) { _sprite->position = _position; }
+void sfSprite_setRotation(sfSprite* _sprite, float _angle)
+{
+	_sprite->rotation = fmodf(_angle, 360.f);
+	if (_sprite->rotation < 0)
+		_sprite->rotation += 360.f;
+}
+void sfSprite_setScale(sfSprite* _sprite, sfVector2f _scale) { _sprite->scale = _scale; }
+void sfSprite_setOrigin(sfSprite* _sprite, sfVector2f _origin) { _sprite->origin = _origin; }
+sfVector2f sfSprite_getPosition(const sfSprite* _sprite) { return _sprite->position; }
+float sfSprite_getRotation(const sfSprite* _sprite) { return _sprite->rotation; }
+sfVector2f sfSprite_getScale(const sfSprite* _sprite) { return _sprite->scale; }
+sfVector2f sfSprite_getOrigin(const sfSprite* _sprite) { return _sprite->origin; }
+void sfSprite_move(sfSprite* _sprite, sfVector2f _offset)
+{
+	_sprite->position.x += _offset.x;
+	_sprite->position.y += _offset.y;
+}
+void sfSprite_rotate(sfSprite* _sprite, float _angle) { sfSprite_setRotation(_sprite, _sprite->rotation + _angle); }
+void sfSprite_scale(sfSprite* _sprite, sfVector2f _factors)
+{
+	_sprite->scale.x *= _factors.x;
+	_sprite->scale.y *= _factors.y;
+}
+sfTransform sfSprite_getTransform(const sfSprite* _sprite)
+{
+	float angle = -_sprite->rotation * 3.141592654f / 180.f;
+	float cosine = cosf(angle);
+	float sine = sinf(angle);
+	float sxc = _sprite->scale.x * cosine;
+	float syc = _sprite->scale.y * cosine;
+	float sxs = _sprite->scale.x * sine;
+	float sys = _sprite->scale.y * sine;
+	float tx = -_sprite->origin.x * sxc - _sprite->origin.y * sys + _sprite->position.x;
+	float ty = _sprite->origin.x * sxs - _sprite->origin.y * syc + _sprite->position.y;
+	return sfTransform_fromMatrix(sxc, sys, tx, -sxs, syc, ty, 0.f, 0.f, 1.f);
+}
+sfTransform sfSprite_getInverseTransform(const sfSprite* _sprite)
+{
+	sfTransform transform = sfSprite_getTransform(_sprite);
+	return sfTransform_getInverse(&transform);
+}
+void sfSprite_setTexture(sfSprite* _sprite, const sfTexture* _texture, sfBool _resetRect)
+{
+	if (_texture != NULL && (_resetRect || _sprite->texture == NULL))
+		_sprite->textureRect = (sfIntRect){ 0, 0, (int)_texture->size.x, (int)_texture->size.y };
+	_sprite->texture = _texture;
+}
+void sfSprite_setTextureRect(sfSprite* _sprite, sfIntRect _rectangle) { _sprite->textureRect = _rectangle; }
+void sfSprite_setColor(sfSprite* _sprite, sfColor _color) { _sprite->color = _color; }
+const sfTexture* sfSprite_getTexture(const sfSprite* _sprite) { return _sprite->texture; }
+sfIntRect sfSprite_getTextureRect(const sfSprite* _sprite) { return _sprite->textureRect; }
+sfColor sfSprite_getColor(const sfSprite* _sprite) { return _sprite->color; }
+sfFloatRect sfSprite_getLocalBounds(const sfSprite* _sprite)
+{
+	return (sfFloatRect){ 0, 0, fabsf((float)_sprite->textureRect.width), fabsf((float)_sprite->textureRect.height) };
+}
+sfFloatRect sfSprite_getGlobalBounds(const sfSprite* _sprite)
+{
+	sfTransform transform = sfSprite_getTransform(_sprite);
+	return sfTransform_transformRect(&transform, sfSprite_getLocalBounds(_sprite));
+}
+
+// Vertex arrays
+sfVertexArray* sfVertexArray_create(void) { return calloc(1, sizeof(sfVertexArray)); }
+sfVertexArray* sfVertexArray_copy(const sfVertexArray* _vertexArray)
+{
+	sfVertexArray* copy = sfVertexArray_create();
+	sfVertexArray_resize(copy, _vertexArray->count);
+	memcpy(copy->vertices, _vertexArray->vertices, _vertexArray->count * sizeof(sfVertex));
+	copy->type = _vertexArray->type;
+	return copy;
+}
+void sfVertexArray_destroy(sfVertexArray* _vertexArray)
+{
+	if (_vertexArray == NULL) return;
+	free(_vertexArray->vertices);
+	free(_vertexArray);
+}
+size_t sfVertexArray_getVertexCount(const sfVertexArray* _vertexArray) { return _vertexArray->count; }
+sfVertex* sfVertexArray_getVertex(sfVertexArray* _vertexArray, size_t _index) { return &_vertexArray->vertices[_index]; }
+void sfVertexArray_clear(sfVertexArray* _vertexArray) { _vertexArray->count = 0; }
+void sfVertexArray_resize(sfVertexArray* _vertexArray, size_t _vertexCount)
+{
+	if (_vertexCount > _vertexArray->capacity)
+	{
+		_vertexArray->vertices = realloc(_vertexArray->vertices, _vertexCount * sizeof(sfVertex));
+		memset(_vertexArray->vertices + _vertexArray->capacity, 0, (_vertexCount - _vertexArray->capacity) * sizeof(sfVertex));
+		_vertexArray->capacity = _vertexCount;
+	}
+	_vertexArray->count = _vertexCount;
+}
+void sfVertexArray_append(sfVertexArray* _vertexArray, sfVertex _vertex)
+{
+	sfVertexArray_resize(_vertexArray, _vertexArray->count + 1);
+	_vertexArray->vertices[_vertexArray->count - 1] = _vertex;
+}
+void sfVertexArray_setPrimitiveType(sfVertexArray* _vertexArray, sfPrimitiveType _type) { _vertexArray->type = _type; }
+sfPrimitiveType sfVertexArray_getPrimitiveType(sfVertexArray* _vertexArray) { return _vertexArray->type; }
+sfFloatRect sfVertexArray_getBounds(sfVertexArray* _vertexArray)
+{
+	if (_vertexArray->count == 0)
+		return (sfFloatRect){ 0, 0, 0, 0 };
+	sfVector2f min = _vertexArray->vertices[0].position, max = min;
+	for (size_t i = 1; i < _vertexArray->count; i++)
+	{
+		sfVector2f p = _vertexArray->vertices[i].position;
+		min.x = fminf(min.x, p.x); min.y = fminf(min.y, p.y);
+		max.x = fmaxf(max.x, p.x); max.y = fmaxf(max.y, p.y);
+	}
+	return (sfFloatRect){ min.x, min.y, max.x - min.x, max.y - min.y };
+}
+
+// Views and render targets
+sfView* sfView_create(void) { return sfView_createFromRect((sfFloatRect){ 0, 0, 1000, 1000 }); }
+sfView* sfView_createFromRect(sfFloatRect _rectangle)
+{
+	sfView* view = malloc(sizeof(sfView));
+	view->center = (sfVector2f){ _rectangle.left + _rectangle.width / 2, _rectangle.top + _rectangle.height / 2 };
+	view->size = (sfVector2f){ _rectangle.width, _rectangle.height };
+	view->rotation = 0;
+	return view;
+}
+void sfView_destroy(sfView* _view) { free(_view); }
+sfVector2f sfView_getCenter(const sfView* _view) { return _view->center; }
+sfVector2f sfView_getSize(const sfView* _view) { return _view->size; }
+float sfView_getRotation(const sfView* _view) { return _view->rotation; }
+
+const sfView* sfRenderWindow_getView(const sfRenderWindow* _renderWindow) { return &_renderWindow->view; }
+void sfRenderWindow_drawSprite(sfRenderWindow* _renderWindow, const sfSprite* _object, const sfRenderStates* _states)
+{
+	(void)_renderWindow; (void)_object; (void)_states;
+	sfStub_drawCalls++;
+	sfStub_drawnVertices += 4;
+}
+void sfRenderWindow_drawVertexArray(sfRenderWindow* _renderWindow, const sfVertexArray* _object, const sfRenderStates* _states)
+{
+	(void)_renderWindow; (void)_states;
+	sfStub_drawCalls++;
+	sfStub_drawnVertices += _object->count;
+}
+
+const sfView* sfRenderTexture_getView(const sfRenderTexture* _renderTexture) { return &_renderTexture->view; }
+void sfRenderTexture_drawSprite(sfRenderTexture* _renderTexture, const sfSprite* _object, const sfRenderStates* _states)
+{
+	(void)_renderTexture; (void)_object; (void)_states;
+	sfStub_drawCalls++;
+	sfStub_drawnVertices += 4;
+}
+void sfRenderTexture_drawVertexArray(sfRenderTexture* _renderTexture, const sfVertexArray* _object, const sfRenderStates* _states)
+{
+	(void)_renderTexture; (void)_states;
+	sfStub_drawCalls++;
+	sfStub_drawnVertices += _object->count;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+///
+// Minimal CSFML configuration types used by the stub backend
+///
+typedef int sfBool;
+#define sfFalse 0
+#define sfTrue 1
+
+typedef signed char sfInt8;
+typedef unsigned char sfUint8;
+typedef short sfInt16;
+typedef unsigned short sfUint16;
+typedef int sfInt32;
+typedef unsigned int sfUint32;
+typedef long long sfInt64;
+typedef unsigned long long sfUint64;
@@ -0,0 +1,179 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/System.h>
+#include <SFML/Window.h>
+#include <stddef.h>
+
+typedef struct { sfUint8 r; sfUint8 g; sfUint8 b; sfUint8 a; } sfColor;
+
+extern const sfColor sfBlack;
+extern const sfColor sfWhite;
+extern const sfColor sfTransparent;
+
+sfColor sfColor_fromRGBA(sfUint8 _red, sfUint8 _green, sfUint8 _blue, sfUint8 _alpha);
+
+typedef struct { float left; float top; float width; float height; } sfFloatRect;
+typedef struct { int left; int top; int width; int height; } sfIntRect;
+
+sfBool sfFloatRect_intersects(const sfFloatRect* _rect1, const sfFloatRect* _rect2, sfFloatRect* _intersection);
+sfBool sfFloatRect_contains(const sfFloatRect* _rect, float _x, float _y);
+
+typedef struct { float matrix[9]; } sfTransform;
+
+extern const sfTransform sfTransform_Identity;
+
+sfTransform sfTransform_fromMatrix(
+	float _a00, float _a01, float _a02,
+	float _a10, float _a11, float _a12,
+	float _a20, float _a21, float _a22);
+sfTransform sfTransform_getInverse(const sfTransform* _transform);
+sfVector2f sfTransform_transformPoint(const sfTransform* _transform, sfVector2f _point);
+sfFloatRect sfTransform_transformRect(const sfTransform* _transform, sfFloatRect _rectangle);
+void sfTransform_combine(sfTransform* _transform, const sfTransform* _other);
+
+typedef enum
+{
+	sfBlendFactorZero,
+	sfBlendFactorOne,
+	sfBlendFactorSrcColor,
+	sfBlendFactorOneMinusSrcColor,
+	sfBlendFactorDstColor,
+	sfBlendFactorOneMinusDstColor,
+	sfBlendFactorSrcAlpha,
+	sfBlendFactorOneMinusSrcAlpha,
+	sfBlendFactorDstAlpha,
+	sfBlendFactorOneMinusDstAlpha
+} sfBlendFactor;
+
+typedef enum
+{
+	sfBlendEquationAdd,
+	sfBlendEquationSubtract,
+	sfBlendEquationReverseSubtract
+} sfBlendEquation;
+
+typedef struct
+{
+	sfBlendFactor colorSrcFactor;
+	sfBlendFactor colorDstFactor;
+	sfBlendEquation colorEquation;
+	sfBlendFactor alphaSrcFactor;
+	sfBlendFactor alphaDstFactor;
+	sfBlendEquation alphaEquation;
+} sfBlendMode;
+
+extern const sfBlendMode sfBlendAlpha;
+
+typedef enum
+{
+	sfPoints,
+	sfLines,
+	sfLineStrip,
+	sfTriangles,
+	sfTriangleStrip,
+	sfTriangleFan,
+	sfQuads
+} sfPrimitiveType;
+
+typedef struct
+{
+	sfVector2f position;
+	sfColor color;
+	sfVector2f texCoords;
+} sfVertex;
+
+typedef struct sfImage sfImage;
+typedef struct sfTexture sfTexture;
+typedef struct sfShader sfShader;
+typedef struct sfSprite sfSprite;
+typedef struct sfVertexArray sfVertexArray;
+typedef struct sfView sfView;
+typedef struct sfRenderWindow sfRenderWindow;
+typedef struct sfRenderTexture sfRenderTexture;
+
+typedef struct
+{
+	sfBlendMode blendMode;
+	sfTransform transform;
+	const sfTexture* texture;
+	const sfShader* shader;
+} sfRenderStates;
+
+sfImage* sfImage_create(unsigned int _width, unsigned int _height);
+sfImage* sfImage_createFromColor(unsigned int _width, unsigned int _height, sfColor _color);
+sfImage* sfImage_createFromPixels(unsigned int _width, unsigned int _height, const sfUint8* _pixels);
+sfImage* sfImage_createFromFile(const char* _filename);
+sfImage* sfImage_copy(const sfImage* _image);
+void sfImage_destroy(sfImage* _image);
+sfBool sfImage_saveToFile(const sfImage* _image, const char* _filename);
+sfVector2u sfImage_getSize(const sfImage* _image);
+void sfImage_copyImage(sfImage* _image, const sfImage* _source, unsigned int _destX, unsigned int _destY, sfIntRect _sourceRect, sfBool _applyAlpha);
+void sfImage_setPixel(sfImage* _image, unsigned int _x, unsigned int _y, sfColor _color);
+sfColor sfImage_getPixel(const sfImage* _image, unsigned int _x, unsigned int _y);
+const sfUint8* sfImage_getPixelsPtr(const sfImage* _image);
+
+sfTexture* sfTexture_create(unsigned int _width, unsigned int _height);
+sfTexture* sfTexture_createFromFile(const char* _filename, const sfIntRect* _area);
+sfTexture* sfTexture_createFromImage(const sfImage* _image, const sfIntRect* _area);
+sfTexture* sfTexture_copy(const sfTexture* _texture);
+void sfTexture_destroy(sfTexture* _texture);
+sfVector2u sfTexture_getSize(const sfTexture* _texture);
+sfImage* sfTexture_copyToImage(const sfTexture* _texture);
+void sfTexture_updateFromPixels(sfTexture* _texture, const sfUint8* _pixels, unsigned int _width, unsigned int _height, unsigned int _x, unsigned int _y);
+void sfTexture_updateFromImage(sfTexture* _texture, const sfImage* _image, unsigned int _x, unsigned int _y);
+unsigned int sfTexture_getMaximumSize(void);
+
+sfSprite* sfSprite_create(void);
+sfSprite* sfSprite_copy(const sfSprite* _sprite);
+void sfSprite_destroy(sfSprite* _sprite);
+void sfSprite_setPosition(sfSprite* _sprite, sfVector2f _position);
+void sfSprite_setRotation(sfSprite* _sprite, float _angle);
+void sfSprite_setScale(sfSprite* _sprite, sfVector2f _scale);
+void sfSprite_setOrigin(sfSprite* _sprite, sfVector2f _origin);
+sfVector2f sfSprite_getPosition(const sfSprite* _sprite);
+float sfSprite_getRotation(const sfSprite* _sprite);
+sfVector2f sfSprite_getScale(const sfSprite* _sprite);
+sfVector2f sfSprite_getOrigin(const sfSprite* _sprite);
+void sfSprite_move(sfSprite* _sprite, sfVector2f _offset);
+void sfSprite_rotate(sfSprite* _sprite, float _angle);
+void sfSprite_scale(sfSprite* _sprite, sfVector2f _factors);
+sfTransform sfSprite_getTransform(const sfSprite* _sprite);
+sfTransform sfSprite_getInverseTransform(const sfSprite* _sprite);
+void sfSprite_setTexture(sfSprite* _sprite, const sfTexture* _texture, sfBool _resetRect);
+void sfSprite_setTextureRect(sfSprite* _sprite, sfIntRect _rectangle);
+void sfSprite_setColor(sfSprite* _sprite, sfColor _color);
+const sfTexture* sfSprite_getTexture(const sfSprite* _sprite);
+sfIntRect sfSprite_getTextureRect(const sfSprite* _sprite);
+sfColor sfSprite_getColor(const sfSprite* _sprite);
+sfFloatRect sfSprite_getLocalBounds(const sfSprite* _sprite);
+sfFloatRect sfSprite_getGlobalBounds(const sfSprite* _sprite);
+
+sfVertexArray* sfVertexArray_create(void);
+sfVertexArray* sfVertexArray_copy(const sfVertexArray* _vertexArray);
+void sfVertexArray_destroy(sfVertexArray* _vertexArray);
+size_t sfVertexArray_getVertexCount(const sfVertexArray* _vertexArray);
+sfVertex* sfVertexArray_getVertex(sfVertexArray* _vertexArray, size_t _index);
+void sfVertexArray_clear(sfVertexArray* _vertexArray);
+void sfVertexArray_resize(sfVertexArray* _vertexArray, size_t _vertexCount);
+void sfVertexArray_append(sfVertexArray* _vertexArray, sfVertex _vertex);
+void sfVertexArray_setPrimitiveType(sfVertexArray* _vertexArray, sfPrimitiveType _type);
+sfPrimitiveType sfVertexArray_getPrimitiveType(sfVertexArray* _vertexArray);
+sfFloatRect sfVertexArray_getBounds(sfVertexArray* _vertexArray);
+
+sfView* sfView_create(void);
+sfView* sfView_createFromRect(sfFloatRect _rectangle);
+void sfView_destroy(sfView* _view);
+sfVector2f sfView_getCenter(const sfView* _view);
+sfVector2f sfView_getSize(const sfView* _view);
+float sfView_getRotation(const sfView* _view);
+
+const sfView* sfRenderWindow_getView(const sfRenderWindow* _renderWindow);
+void sfRenderWindow_drawSprite(sfRenderWindow* _renderWindow, const sfSprite* _object, const sfRenderStates* _states);
+void sfRenderWindow_drawVertexArray(sfRenderWindow* _renderWindow, const sfVertexArray* _object, const sfRenderStates* _states);
+
+const sfView* sfRenderTexture_getView(const sfRenderTexture* _renderTexture);
+void sfRenderTexture_drawSprite(sfRenderTexture* _renderTexture, const sfSprite* _object, const sfRenderStates* _states);
+void sfRenderTexture_drawVertexArray(sfRenderTexture* _renderTexture, const sfVertexArray* _object, const sfRenderStates* _states);
@@ -0,0 +1,42 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/Config.h>
+
+typedef struct { float x; float y; } sfVector2f;
+typedef struct { int x; int y; } sfVector2i;
+typedef struct { unsigned int x; unsigned int y; } sfVector2u;
+
+typedef struct { sfInt64 microseconds; } sfTime;
+
+typedef struct sfClock sfClock;
+typedef struct sfMutex sfMutex;
+typedef struct sfThread sfThread;
+
+float sfTime_asSeconds(sfTime _time);
+sfInt32 sfTime_asMilliseconds(sfTime _time);
+sfInt64 sfTime_asMicroseconds(sfTime _time);
+sfTime sfSeconds(float _amount);
+sfTime sfMilliseconds(sfInt32 _amount);
+sfTime sfMicroseconds(sfInt64 _amount);
+
+sfClock* sfClock_create(void);
+sfClock* sfClock_copy(const sfClock* _clock);
+void sfClock_destroy(sfClock* _clock);
+sfTime sfClock_getElapsedTime(const sfClock* _clock);
+sfTime sfClock_restart(sfClock* _clock);
+
+void sfSleep(sfTime _duration);
+
+sfMutex* sfMutex_create(void);
+void sfMutex_destroy(sfMutex* _mutex);
+void sfMutex_lock(sfMutex* _mutex);
+void sfMutex_unlock(sfMutex* _mutex);
+
+sfThread* sfThread_create(void (*_function)(void*), void* _userData);
+void sfThread_destroy(sfThread* _thread);
+void sfThread_launch(sfThread* _thread);
+void sfThread_wait(sfThread* _thread);
+void sfThread_terminate(sfThread* _thread);
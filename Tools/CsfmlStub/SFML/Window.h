@@ -0,0 +1,13 @@
+#pragma once
+
+///
+// Headers
+///
+#include <SFML/System.h>
+
+typedef struct
+{
+	unsigned int width;
+	unsigned int height;
+	unsigned int bitsPerPixel;
+} sfVideoMode;